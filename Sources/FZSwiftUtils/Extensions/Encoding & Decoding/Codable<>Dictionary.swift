@@ -14,30 +14,41 @@ public extension Encodable {
      - Returns: A `CFDictionary` representation of the encodable object.
      */
     func toCFDictionary() -> CFDictionary {
-        return (toDictionary(encoder: .init()) as [CFString: Any]) as CFDictionary
+        return (toDictionary(encoder: DictionaryEncoder()) as [CFString: Any]) as CFDictionary
     }
 
     /**
      Converts the encodable object to a dictionary.
      
+     Like the dictionaries of `JSONSerialization`, numbers are stored as `NSNumber`, so an integer or `Float` value can be read as `Double`.
+     
      - Returns: A `[String: Any]` representation of the encodable object.
      */
     func toDictionary() -> [String: Any] {
-        return toDictionary(encoder: .init())
+        return toDictionary(encoder: DictionaryEncoder())
     }
 
     /**
-      Converts the encodable object to a dictionary using the specified JSON encoder.
+      Converts the encodable object to a dictionary using the strategies of the specified JSON encoder.
+
+      The object is encoded directly to the dictionary using a ``DictionaryEncoder``.
       
       - Parameter encoder: The JSON encoder to use for encoding the object. Default is a new instance of `JSONEncoder`.
       - Returns: A `[String: Any]` representation of the encodable object.
       */
     func toDictionary(encoder: JSONEncoder) -> [String: Any] {
+        toDictionary(encoder: DictionaryEncoder(encoder))
+    }
+
+    /**
+      Converts the encodable object to a dictionary using the specified dictionary encoder.
+
+      - Parameter encoder: The dictionary encoder to use for encoding the object.
+      - Returns: A `[String: Any]` representation of the encodable object.
+      */
+    func toDictionary(encoder: DictionaryEncoder) -> [String: Any] {
         do {
-            let data = try encoder.encode(self)
-            if let dict = try JSONSerialization.jsonObject(with: data, options: []) as? [String: Any] {
-                return dict
-            }
+            return try encoder.encode(self)
         } catch {
             print("ERROR Converting model to dict")
         }
@@ -54,21 +65,32 @@ public extension CFDictionary {
      - Returns: A model object of the specified type, or `nil` if the decoding fails.
      */
     func toModel<T: Codable>() -> T? {
-        return toModel(T.self, decoder: .init())
+        return toModel(T.self, decoder: DictionaryDecoder())
     }
 
     /**
-     Converts the dictionary to a model object of the specified type using the specified JSON decoder.
+     Converts the dictionary to a model object of the specified type using the strategies of the specified JSON decoder.
+
+     The object is decoded directly from the dictionary using a ``DictionaryDecoder``.
      
      - Parameter type: The type of the model object to decode. Default is inferred from the context.
      - Parameter decoder: The JSON decoder to use for decoding the data.
      - Returns: A model object of the specified type, or `nil` if the decoding fails.
      */
     func toModel<T: Codable>(_ type: T.Type = T.self, decoder: JSONDecoder) -> T? {
+        toModel(type, decoder: DictionaryDecoder(decoder))
+    }
+
+    /**
+     Converts the dictionary to a model object of the specified type using the specified dictionary decoder.
+
+     - Parameter type: The type of the model object to decode. Default is inferred from the context.
+     - Parameter decoder: The dictionary decoder to use for decoding the dictionary.
+     - Returns: A model object of the specified type, or `nil` if the decoding fails.
+     */
+    func toModel<T: Codable>(_ type: T.Type = T.self, decoder: DictionaryDecoder) -> T? {
         do {
-            let data = try JSONSerialization.data(withJSONObject: self, options: .prettyPrinted)
-            let obj = try decoder.decode(type, from: data)
-            return obj
+            return try decoder.decode(type, from: self)
         } catch {
             Swift.print(error)
             return nil
@@ -85,21 +107,32 @@ public extension Dictionary {
      - Returns: A model object of the specified type, or `nil` if the decoding fails.
      */
     func toModel<T: Codable>() -> T? {
-        return toModel(T.self, decoder: .init())
+        return toModel(T.self, decoder: DictionaryDecoder())
     }
     
     /**
-     Converts the dictionary to a model object of the specified type using the specified JSON decoder.
+     Converts the dictionary to a model object of the specified type using the strategies of the specified JSON decoder.
+
+     The object is decoded directly from the dictionary using a ``DictionaryDecoder``.
      
      - Parameter type: The type of the model object to decode. Default is inferred from the context.
      - Parameter decoder: The JSON decoder to use for decoding the data. Default is a new instance of `JSONDecoder`.
      - Returns: A model object of the specified type, or `nil` if the decoding fails.
      */
     func toModel<T: Codable>(_ type: T.Type = T.self, decoder: JSONDecoder = .init()) -> T? {
+        toModel(type, decoder: DictionaryDecoder(decoder))
+    }
+
+    /**
+     Converts the dictionary to a model object of the specified type using the specified dictionary decoder.
+
+     - Parameter type: The type of the model object to decode. Default is inferred from the context.
+     - Parameter decoder: The dictionary decoder to use for decoding the dictionary.
+     - Returns: A model object of the specified type, or `nil` if the decoding fails.
+     */
+    func toModel<T: Codable>(_ type: T.Type = T.self, decoder: DictionaryDecoder) -> T? {
         do {
-            let data = try JSONSerialization.data(withJSONObject: self, options: .prettyPrinted)
-            let obj = try decoder.decode(type, from: data)
-            return obj
+            return try decoder.decode(type, fromObject: self)
         } catch {
             Swift.print(error)
             return nil
@@ -0,0 +1,67 @@
+//
+//  ContiguousBytes+Hex.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+public extension ContiguousBytes {
+    /**
+     The bytes as a lowercase hexadecimal string.
+
+     ```swift
+     Data([0x0F, 0xA0]).hexString // "0fa0"
+     SHA256.hash(data: data).hexString
+     ```
+     */
+    var hexString: String {
+        withUnsafeBytes { HexEncoding.string(from: $0) }
+    }
+}
+
+/// Encodes bytes as hexadecimal strings using a lookup table of the two digits of each byte.
+enum HexEncoding {
+    /// The two lowercase hexadecimal digits of every byte value.
+    static let digits: [UInt8] = {
+        let hexDigits = Array("0123456789abcdef".utf8)
+        var digits: [UInt8] = []
+        digits.reserveCapacity(512)
+        for byte in 0 ..< 256 {
+            digits.append(hexDigits[byte >> 4])
+            digits.append(hexDigits[byte & 0x0F])
+        }
+        return digits
+    }()
+
+    /// Returns the bytes as a lowercase hexadecimal string.
+    static func string(from bytes: UnsafeRawBufferPointer) -> String {
+        guard !bytes.isEmpty else { return "" }
+        let length = bytes.count * 2
+        if #available(macOS 11.0, iOS 14.0, tvOS 14.0, watchOS 7.0, *) {
+            return String(unsafeUninitializedCapacity: length) {
+                encode(bytes, into: $0.baseAddress!)
+                return length
+            }
+        }
+        let encoded = [UInt8](unsafeUninitializedCapacity: length) { buffer, initializedCount in
+            encode(bytes, into: buffer.baseAddress!)
+            initializedCount = length
+        }
+        return String(decoding: encoded, as: UTF8.self)
+    }
+
+    /// Writes the two hexadecimal digits of every byte to the destination.
+    static func encode(_ bytes: UnsafeRawBufferPointer, into destination: UnsafeMutablePointer<UInt8>) {
+        digits.withUnsafeBufferPointer { digits in
+            var destination = destination
+            for byte in bytes {
+                let index = Int(byte) &* 2
+                destination[0] = digits[index]
+                destination[1] = digits[index &+ 1]
+                destination += 2
+            }
+        }
+    }
+}
@@ -44,15 +44,49 @@ public extension URL {
         private var url: URL
         private var options: Options
         private var predicate: Predicate
+        private var resourceKeys: Set<URLResourceKey>
 
-        public init(url: URL, options: Options, predicate: @escaping Predicate) {
+        public init(url: URL, options: Options, resourceKeys: Set<URLResourceKey> = [], predicate: @escaping Predicate) {
             self.url = url
             self.options = options
+            self.resourceKeys = resourceKeys
             self.predicate = predicate
         }
 
         public func makeIterator() -> DirectoryIterator {
-            return DirectoryIterator(url: url, options: options, predicate: predicate)
+            return DirectoryIterator(url: url, options: options, resourceKeys: resourceKeys, predicate: predicate)
+        }
+
+        /**
+         Returns the sequence that additionally prefetches the specified resource keys.
+
+         - Parameter keys: The resource keys to prefetch for each url.
+         - Returns: The sequence prefetching the keys.
+         */
+        public func prefetching(_ keys: Set<URLResourceKey>) -> URLSequence {
+            var sequence = self
+            sequence.resourceKeys.formUnion(keys)
+            return sequence
+        }
+
+        /// A sequence of the urls and their prefetched resource values.
+        public var withResourceValues: ResourceValuesSequence {
+            ResourceValuesSequence(sequence: self)
+        }
+    }
+
+    /// A sequence of the urls of a directory and their prefetched resource values.
+    struct ResourceValuesSequence: Sequence, IteratorProtocol {
+        public typealias Element = (url: URL, resourceValues: URLResourceValues)
+
+        private let iterator: DirectoryIterator
+
+        init(sequence: URLSequence) {
+            iterator = sequence.makeIterator()
+        }
+
+        public func next() -> Element? {
+            iterator.nextWithResourceValues()
         }
     }
 
@@ -65,16 +99,20 @@ public extension URL {
         let predicate: Predicate
         let directoryEnumerator: FileManager.DirectoryEnumerator?
         let maxLevel: Int?
+        /// The resource keys that are prefetched for each url.
+        public let resourceKeys: Set<URLResourceKey>
 
-        init(url: URL, options: Options = [], predicate: Predicate? = nil) {
+        init(url: URL, options: Options = [], resourceKeys: Set<URLResourceKey> = [], predicate: Predicate? = nil) {
             self.url = url
             self.predicate = predicate ?? { _ in true }
+            self.resourceKeys = resourceKeys
             maxLevel = options.compactMap { $0.depth }.first
             var options = FileManager.DirectoryEnumerationOptions(options)
             if maxLevel != nil {
                 options.remove(.skipsSubdirectoryDescendants)
             }
-            directoryEnumerator = FileManager.default.enumerator(at: url, includingPropertiesForKeys: nil, options: options)
+            // The enumerator fetches the values of the keys in one batch while reading the directory and caches them on the returned urls, so the predicate and `resources` read them without additional lookups.
+            directoryEnumerator = FileManager.default.enumerator(at: url, includingPropertiesForKeys: resourceKeys.isEmpty ? nil : Array(resourceKeys), options: options)
         }
 
         public func next() -> URL? {
@@ -90,6 +128,18 @@ public extension URL {
             return nil
         }
 
+        /// Returns the next url and its prefetched resource values.
+        public func nextWithResourceValues() -> (url: URL, resourceValues: URLResourceValues)? {
+            guard let url = next() else { return nil }
+            return (url, resourceValues(for: url))
+        }
+
+        /// Returns the prefetched resource values of the specified url returned by the iterator.
+        public func resourceValues(for url: URL) -> URLResourceValues {
+            guard !resourceKeys.isEmpty else { return URLResourceValues() }
+            return (try? url.resourceValues(forKeys: resourceKeys)) ?? URLResourceValues()
+        }
+
         /// Skip recursion into the most recently obtained subdirectory.
         public func skipDescendants() {
             directoryEnumerator?.skipDescendants()
@@ -100,10 +150,17 @@ public extension URL {
         }
     }
 
-    // iterate
-    func iterate(predicate: ((URL) -> Bool)? = nil, options: Set<DirectoryEnumerationOption> = []) -> URLSequence {
+    /**
+     Returns a sequence of the urls of the directory.
+
+     - Parameters:
+        - predicate: The predicate for the urls to include.
+        - options: The options for enumerating the directory.
+        - resourceKeys: The resource keys to prefetch for each url while enumerating the directory. Prefetching the keys the predicate reads avoids a separate lookup for every url.
+     */
+    func iterate(predicate: ((URL) -> Bool)? = nil, options: Set<DirectoryEnumerationOption> = [], resourceKeys: Set<URLResourceKey> = []) -> URLSequence {
         let predicate = predicate ?? { _ in true }
-        return URLSequence(url: self, options: options, predicate: predicate)
+        return URLSequence(url: self, options: options, resourceKeys: resourceKeys, predicate: predicate)
     }
 
     func iterate(predicate: ((URL) -> Bool)? = nil, _ options: DirectoryEnumerationOption...) -> URLSequence {
@@ -114,7 +171,7 @@ public extension URL {
     func iterateFiles(options: Set<DirectoryEnumerationOption> = []) -> URLSequence {
         return iterate(predicate: {
             $0.isFile
-        }, options: options)
+        }, options: options, resourceKeys: [.isRegularFileKey])
     }
 
     func iterateFiles(options: DirectoryEnumerationOption...) -> URLSequence {
@@ -126,7 +183,7 @@ public extension URL {
         return iterate(predicate: {
             if types.isEmpty { return $0.isFile }
             if let fileType = $0.fileType, types.contains(fileType) { return true } else { return false }
-        }, options: options)
+        }, options: options, resourceKeys: FileType.resourceKeys)
     }
 
     func iterateFiles(types: [FileType], _ options: DirectoryEnumerationOption...) -> URLSequence {
@@ -140,7 +197,7 @@ public extension URL {
             if let type = $0.contentType, (contentTypes.contains(type) || type.conforms(toAny: contentTypes))  {
                 return true
             } else { return false }
-        }, options: options)
+        }, options: options, resourceKeys: UTType.resourceKeys)
     }
 
     @available(macOS 11.0, iOS 14.0, tvOS 14.0, watchOS 7.0, *)
@@ -150,20 +207,36 @@ public extension URL {
 
     // iterateFiles Extensions
     func iterateFiles(extensions: [String], options: Set<DirectoryEnumerationOption> = []) -> URLSequence {
-        let extensions = extensions.compactMap { $0.lowercased() }
+        let extensions = PathExtensionSet(extensions)
         return iterate(predicate: {
             if extensions.isEmpty { return $0.isFile }
-            return extensions.contains($0.pathExtension.lowercased())
-        }, options: options)
+            return extensions.contains($0)
+        }, options: options, resourceKeys: extensions.isEmpty ? [.isRegularFileKey] : [])
     }
 
     func iterateFiles(extensions: [String], options: DirectoryEnumerationOption...) -> URLSequence {
         return iterateFiles(extensions: extensions, options: Set(options))
     }
 
+    // iterateFiles Glob
+    /**
+     Returns a sequence of the urls of the directory that match the specified glob patterns.
+
+     - Parameters:
+        - patterns: The glob patterns. An url matches if its path matches any of the patterns that aren't negated, or if all patterns are negated, and it matches none of the negated patterns.
+        - options: The options for enumerating the directory.
+     */
+    func iterate(matching patterns: [GlobPattern], options: Set<DirectoryEnumerationOption> = []) -> URLSequence {
+        return iterate(predicate: { patterns.matches($0) }, options: options)
+    }
+
+    func iterate(matching patterns: [GlobPattern], _ options: DirectoryEnumerationOption...) -> URLSequence {
+        iterate(matching: patterns, options: Set(options))
+    }
+
     // iterateDirectories
     func iterateDirectories(options: Set<DirectoryEnumerationOption> = []) -> URLSequence {
-        return iterate(predicate: { $0.pathExtension == "" }, options: options)
+        return iterate(predicate: { $0.isDirectory }, options: options, resourceKeys: [.isDirectoryKey])
     }
 
     func iterateDirectories(_ options: DirectoryEnumerationOption...) -> URLSequence {
@@ -200,7 +273,7 @@ internal extension Dictionary where Key == FileAttributeKey {
 
 public extension URL {
     func iterateFiles(by enumerationOptions: [FileEnumerationOption], options: Set<DirectoryEnumerationOption> = []) -> URLSequence {
-        return iterate(predicate: enumerationOptions.predicate(), options: options)
+        return iterate(predicate: enumerationOptions.predicate(), options: options, resourceKeys: enumerationOptions.resourceKeys)
     }
 
     func iterateFiles(by enumerationOptions: FileEnumerationOption..., options: Set<DirectoryEnumerationOption> = []) -> URLSequence {
@@ -209,15 +282,18 @@ public extension URL {
 
     struct FileEnumerationOption {
         internal let predicate: (URL) -> Bool
-        internal init(_ predicate: @escaping (URL) -> Bool) {
+        /// The resource keys read by the predicate.
+        internal let resourceKeys: Set<URLResourceKey>
+        internal init(resourceKeys: Set<URLResourceKey> = [], _ predicate: @escaping (URL) -> Bool) {
+            self.resourceKeys = resourceKeys
             self.predicate = predicate
         }
 
         public static func extensions(_ extensions: [String]) -> Self {
-            let extensions = extensions.compactMap { $0.lowercased() }
+            let extensions = PathExtensionSet(extensions)
             return Self {
                 if extensions.isEmpty { return $0.isFile }
-                return extensions.contains($0.pathExtension.lowercased())
+                return extensions.contains($0)
             }
         }
 
@@ -225,8 +301,18 @@ public extension URL {
             return self.extensions(extensions)
         }
 
+        /// Files whose path matches the glob patterns.
+        public static func glob(_ patterns: [GlobPattern]) -> Self {
+            return Self { patterns.matches($0) }
+        }
+
+        /// Files whose path matches the glob patterns.
+        public static func glob(_ patterns: GlobPattern...) -> Self {
+            return glob(patterns)
+        }
+
         public static func types(_ types: [FileType]) -> Self {
-            return Self {
+            return Self(resourceKeys: FileType.resourceKeys) {
                 if types.isEmpty { return $0.isFile }
                 if let fileType = $0.fileType, types.contains(fileType) { return true } else { return false }
             }
@@ -238,7 +324,7 @@ public extension URL {
 
         @available(macOS 11.0, iOS 14.0, *)
         public static func uttypes(_ types: [UTType]) -> Self {
-            return Self {
+            return Self(resourceKeys: UTType.resourceKeys) {
                 if types.isEmpty { return $0.isFile }
                 if let type = $0.contentType, types.contains(type) { return true } else { return false }
             }
@@ -251,7 +337,7 @@ public extension URL {
 
         @available(macOS 11.0, iOS 14.0, *)
         public static func conforming(to types: [UTType]) -> Self {
-            return Self {
+            return Self(resourceKeys: UTType.resourceKeys) {
                 if types.isEmpty { return $0.isFile }
                 return $0.contentType?.conforms(toAny: types) ?? false
             }
@@ -265,6 +351,10 @@ public extension URL {
 }
 
 internal extension Sequence where Element == URL.FileEnumerationOption {
+    var resourceKeys: Set<URLResourceKey> {
+        reduce(into: [.isRegularFileKey]) { $0.formUnion($1.resourceKeys) }
+    }
+
     func predicate() -> ((URL) -> Bool) {
         return { url in
             guard url.isFile == true else { return false }
@@ -272,3 +362,16 @@ internal extension Sequence where Element == URL.FileEnumerationOption {
         }
     }
 }
+
+internal extension URL.FileType {
+    /// The resource keys read by `init(url:)`.
+    static let resourceKeys: Set<URLResourceKey> = [.isRegularFileKey, .typeIdentifierKey]
+}
+
+#if canImport(UniformTypeIdentifiers)
+@available(macOS 11.0, iOS 14.0, tvOS 14.0, watchOS 7.0, *)
+internal extension UTType {
+    /// The resource keys read by `init(url:)`.
+    static let resourceKeys: Set<URLResourceKey> = [.isRegularFileKey, .isAliasFileKey, .isSymbolicLinkKey, .isDirectoryKey, .contentTypeKey]
+}
+#endif
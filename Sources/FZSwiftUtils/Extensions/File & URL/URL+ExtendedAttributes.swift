@@ -7,7 +7,11 @@
 //
 
 import Foundation
-
+#if canImport(Darwin)
+import Darwin
+#elseif canImport(Glibc)
+import Glibc
+#endif
 
 public extension URL {
     /**
@@ -25,7 +29,18 @@ public extension URL {
 
         /// The url of the file system resource.
         public private(set) var url: URL
-        
+
+        /// The encoding of `Codable` values that are written.
+        public var codableEncoding: CodableEncoding = .json
+
+        /// The encoding of `Codable` values.
+        public enum CodableEncoding: Hashable {
+            /// JSON.
+            case json
+            /// Binary property list. The encoding is more compact than JSON and faster to decode.
+            case binaryPropertyList
+        }
+
         /**
          Creates an extended attributes object from the specified url.
          - Parameters url: The url of the file.
@@ -78,8 +93,7 @@ public extension URL {
          */
         public func setExtendedAttribute<T>(_ value: T?, for key: Key) throws where T: Codable {
             if let value = value {
-                let data = try JSONEncoder().encode(value)
-                try setExtendedAttributeData(data, for: key)
+                try setExtendedAttributeData(Self.encode(value, encoding: codableEncoding), for: key)
             } else {
                 try removeExtendedAttribute(key)
             }
@@ -110,7 +124,7 @@ public extension URL {
          */
         public func extendedAttribute<T>(for key: Key) -> T? where T: Codable {
             guard let data = extendedAttributeData(for: key) else { return nil }
-            return try? JSONDecoder().decode(T.self, from: data)
+            return Self.decode(data)
         }
 
         /**
@@ -135,7 +149,7 @@ public extension URL {
          */
         public func removeExtendedAttribute(_ key: Key) throws {
             try url.withUnsafeFileSystemRepresentation { fileSystemPath in
-                let result = removexattr(fileSystemPath, key, 0)
+                let result = Self.removeAttribute(fileSystemPath, key)
                 guard result >= 0 else { throw NSError.posix(errno) }
             }
         }
@@ -150,7 +164,7 @@ public extension URL {
         public func hasExtendedAttribute(_ key: Key) -> Bool {
             let result = url.withUnsafeFileSystemRepresentation {
                 fileSystemPath -> Bool in
-                let length = getxattr(fileSystemPath, key, nil, 0, 0, 0)
+                let length = Self.getAttribute(fileSystemPath, key, nil, 0)
                 return length >= 0
             }
 
@@ -159,10 +173,10 @@ public extension URL {
 
         /// A dictionary of all attributes.
         public func allExtendedAttributes() throws -> [Key: Any] {
-            let keys = try listExtendedAttributes()
+            let attributes = try readAll()
             var values: [String: Any] = [:]
-            for key in keys {
-                if let data = extendedAttributeData(for: key),
+            for key in attributes.keys {
+                if let data = attributes[key],
                    let value = try? PropertyListSerialization.propertyList(from: data, format: nil)
                 {
                     values[key] = value
@@ -171,71 +185,263 @@ public extension URL {
             return values
         }
 
-        /// An array of all attribute names.
-        public func listExtendedAttributes() throws -> [Key] {
-            let list = try url.withUnsafeFileSystemRepresentation {
-                fileSystemPath -> [String] in
-
-                let length = listxattr(fileSystemPath, nil, 0, 0)
-                guard length >= 0 else { throw NSError.posix(errno) }
+        /**
+         Reads all attributes.
 
-                // Create buffer with required size
+         The names and values are read with the reused buffer of the current thread. The values are decoded when they are accessed.
 
-                var data = Data(count: length)
-                let count = data.count
+         - Throws: Throws if the file doesn't exist or the attributes couldn't be read.
+         */
+        public func readAll() throws -> Values {
+            try url.withUnsafeFileSystemRepresentation { fileSystemPath in
+                guard let fileSystemPath = fileSystemPath else { throw NSError.posix(ENOENT) }
+                let buffer = ScratchBuffer.current
+                var values: [Key: Data] = [:]
+                for key in try buffer.readNames(fileSystemPath) {
+                    // The attribute might have been removed after listing the names.
+                    if let data = try? buffer.read(fileSystemPath, key) {
+                        values[key] = data
+                    }
+                }
+                return Values(url: url, data: values)
+            }
+        }
 
-                // Retrieve attribute list
+        /**
+         Writes the data of several attributes.
 
-                try data.withUnsafeMutableBytes {
-                    let bytes = $0.baseAddress?.bindMemory(to: CChar.self, capacity: count)
-                    let result = listxattr(fileSystemPath, bytes, count, 0)
-                    if result < 0 { throw NSError.posix(errno) }
+         - Parameter values: The data for the names of the attributes.
+         - Throws: Throws if the file doesn't exist or an attribute couldn't be written. The attributes before the failing one are written.
+         */
+        public func writeAll(_ values: [Key: Data]) throws {
+            try url.withUnsafeFileSystemRepresentation { fileSystemPath in
+                for (key, data) in values {
+                    let result = data.withUnsafeBytes {
+                        Self.setAttribute(fileSystemPath, key, $0.baseAddress, $0.count)
+                    }
+                    guard result >= 0 else { throw NSError.posix(errno) }
                 }
+            }
+        }
 
-                let list = data.split(separator: 0).compactMap {
-                    String(data: Data($0), encoding: .utf8)
-                }
+        /**
+         Writes the values of several attributes, encoded with ``codableEncoding``.
 
-                return list
+         - Parameter values: The values for the names of the attributes.
+         - Throws: Throws if a value couldn't be encoded, the file doesn't exist or an attribute couldn't be written.
+         */
+        public func writeAll<T>(_ values: [Key: T]) throws where T: Codable {
+            try writeAll(values.mapValues { try Self.encode($0, encoding: codableEncoding) })
+        }
+
+        /// The attributes of a file, read by ``readAll()``.
+        public struct Values {
+            /// The url of the file.
+            public let url: URL
+
+            /// The data of the attributes.
+            public let data: [Key: Data]
+
+            /// The names of the attributes.
+            public var keys: Dictionary<Key, Data>.Keys {
+                data.keys
+            }
+
+            /// The data of the attribute with the specified name.
+            public subscript(key: Key) -> Data? {
+                data[key]
             }
 
-            return list
+            /// The `Codable` value of the attribute with the specified name.
+            public func value<T>(for key: Key) -> T? where T: Codable {
+                guard let data = data[key] else { return nil }
+                return ExtendedAttributes.decode(data)
+            }
+
+            /// The property list value of the attribute with the specified name.
+            public func value<T>(for key: Key) -> T? {
+                guard let data = data[key] else { return nil }
+                return (try? PropertyListSerialization.propertyList(from: data, format: nil)) as? T
+            }
+        }
+
+        /// An array of all attribute names.
+        public func listExtendedAttributes() throws -> [Key] {
+            try url.withUnsafeFileSystemRepresentation { fileSystemPath in
+                guard let fileSystemPath = fileSystemPath else { throw NSError.posix(ENOENT) }
+                return try ScratchBuffer.current.readNames(fileSystemPath)
+            }
         }
         
         private func extendedAttributeData(for key: Key) -> Data? {
-            let data = try? url.withUnsafeFileSystemRepresentation {
-                fileSystemPath -> Data in
+            try? url.withUnsafeFileSystemRepresentation { fileSystemPath in
+                guard let fileSystemPath = fileSystemPath else { throw NSError.posix(ENOENT) }
+                return try ScratchBuffer.current.read(fileSystemPath, key)
+            }
+        }
 
-                // Determine attribute size
+        private func setExtendedAttributeData(_ data: Data, for key: Key) throws {
+            try url.withUnsafeFileSystemRepresentation { fileSystemPath in
+                let result = data.withUnsafeBytes {
+                    Self.setAttribute(fileSystemPath, key, $0.baseAddress, $0.count)
+                }
+                guard result >= 0 else { throw NSError.posix(errno) }
+            }
+        }
+    }
+}
 
-                let length = getxattr(fileSystemPath, key, nil, 0, 0, 0)
-                guard length >= 0 else { throw NSError.posix(errno) }
+extension URL.ExtendedAttributes {
+    /**
+     A buffer that is reused for reading attributes and that grows when an attribute doesn't fit.
 
-                // Create buffer with required size
+     Each thread has its own buffer, so reading the attributes of many files reuses it even though `url.extendedAttributes` creates a new object for each file.
+     */
+    final class ScratchBuffer {
+        static let initialCount = 1024
+        /// The size up to which a grown buffer is kept for the next read.
+        static let maximumRetainedCount = 1024 * 1024
+        static let threadDictionaryKey = "FZSwiftUtils.ExtendedAttributes.ScratchBuffer"
 
-                var data = Data(count: length)
+        var bytes = [UInt8](repeating: 0, count: initialCount)
 
-                // Retrieve attribute
+        /// The buffer of the current thread.
+        static var current: ScratchBuffer {
+            let threadDictionary = Thread.current.threadDictionary
+            if let buffer = threadDictionary[threadDictionaryKey] as? ScratchBuffer {
+                return buffer
+            }
+            let buffer = ScratchBuffer()
+            threadDictionary[threadDictionaryKey] = buffer
+            return buffer
+        }
 
-                let count = data.count
-                let result = data.withUnsafeMutableBytes {
-                    getxattr(fileSystemPath, key, $0.baseAddress, count, 0, 0)
+        /// Reads the attribute into the buffer, grows the buffer on `ERANGE` and returns the data.
+        func read(_ path: UnsafePointer<CChar>, _ key: String) throws -> Data {
+            while true {
+                let count = bytes.count
+                let length = bytes.withUnsafeMutableBytes {
+                    URL.ExtendedAttributes.getAttribute(path, key, $0.baseAddress, count)
+                }
+                if length >= 0 {
+                    defer { shrinkIfNeeded() }
+                    return Data(bytes[0..<length])
                 }
+                guard errno == ERANGE else { throw NSError.posix(errno) }
+                try grow(to: URL.ExtendedAttributes.getAttribute(path, key, nil, 0))
+            }
+        }
 
-                guard result >= 0 else { throw NSError.posix(errno) }
-                return data
+        /// Reads the names of the attributes.
+        func readNames(_ path: UnsafePointer<CChar>) throws -> [String] {
+            while true {
+                let count = bytes.count
+                let length = bytes.withUnsafeMutableBytes {
+                    URL.ExtendedAttributes.listAttributes(path, $0.baseAddress?.assumingMemoryBound(to: CChar.self), count)
+                }
+                if length >= 0 {
+                    defer { shrinkIfNeeded() }
+                    return bytes[0..<length].split(separator: 0).map { URL.ExtendedAttributes.key(fromName: String(decoding: $0, as: UTF8.self)) }
+                }
+                guard errno == ERANGE else { throw NSError.posix(errno) }
+                try grow(to: URL.ExtendedAttributes.listAttributes(path, nil, 0))
             }
+        }
 
-            return data
+        /// Doubles the size of the buffer, or grows it to the required length if it's larger.
+        func grow(to requiredLength: Int) throws {
+            guard requiredLength >= 0 else { throw NSError.posix(errno) }
+            bytes = [UInt8](repeating: 0, count: Swift.max(bytes.count * 2, requiredLength))
         }
 
-        private func setExtendedAttributeData(_ data: Data, for key: Key) throws {
-            try url.withUnsafeFileSystemRepresentation { fileSystemPath in
-                let result = data.withUnsafeBytes {
-                    setxattr(fileSystemPath, key, $0.baseAddress, $0.count, 0, 0)
+        /// Releases the buffer after reading an unusually large attribute, so that each thread doesn't keep it.
+        func shrinkIfNeeded() {
+            if bytes.count > Self.maximumRetainedCount {
+                bytes = [UInt8](repeating: 0, count: Self.initialCount)
+            }
+        }
+    }
+
+    static func encode<T: Encodable>(_ value: T, encoding: CodableEncoding) throws -> Data {
+        switch encoding {
+        case .json:
+            return try JSONEncoder().encode(value)
+        case .binaryPropertyList:
+            let encoder = PropertyListEncoder()
+            encoder.outputFormat = .binary
+            guard let data = try? encoder.encode(value) else {
+                // `PropertyListEncoder` can't encode numbers and strings at the top level on older systems, unlike binary property lists themselves. They are encoded in an array and written bare, like the attributes of macOS.
+                let array = try encoder.encode([value])
+                guard let object = (try PropertyListSerialization.propertyList(from: array, format: nil) as? [Any])?.first else {
+                    throw EncodingError.invalidValue(value, .init(codingPath: [], debugDescription: "Unable to encode \(T.self) as property list."))
                 }
-                guard result >= 0 else { throw NSError.posix(errno) }
+                return try PropertyListSerialization.data(fromPropertyList: object, format: .binary, options: 0)
             }
+            return data
         }
     }
+
+    /// Decodes JSON or binary property list data, detected by the header of binary property lists.
+    static func decode<T: Decodable>(_ data: Data) -> T? {
+        guard data.starts(with: binaryPropertyListHeader) else {
+            return try? JSONDecoder().decode(T.self, from: data)
+        }
+        let decoder = PropertyListDecoder()
+        if let value = try? decoder.decode(T.self, from: data) {
+            return value
+        }
+        // Numbers and strings at the top level are decoded in an array on systems where `PropertyListDecoder` requires a container.
+        guard let object = try? PropertyListSerialization.propertyList(from: data, format: nil), let array = try? PropertyListSerialization.data(fromPropertyList: [object], format: .binary, options: 0) else { return nil }
+        return (try? decoder.decode([T].self, from: array))?.first
+    }
+
+    static let binaryPropertyListHeader = Array("bplist00".utf8)
+
+    #if os(Linux)
+    /// The name of the attribute for the key. Linux requires a namespace, keys without one are stored in the `user` namespace.
+    static func name(for key: String) -> String {
+        let namespaces = ["user.", "trusted.", "security.", "system."]
+        return namespaces.contains(where: { key.hasPrefix($0) }) ? key : "user." + key
+    }
+
+    static func key(fromName name: String) -> String {
+        name.hasPrefix("user.") ? String(name.dropFirst(5)) : name
+    }
+
+    static func getAttribute(_ path: UnsafePointer<CChar>?, _ key: String, _ value: UnsafeMutableRawPointer?, _ size: Int) -> Int {
+        getxattr(path, name(for: key), value, size)
+    }
+
+    static func setAttribute(_ path: UnsafePointer<CChar>?, _ key: String, _ value: UnsafeRawPointer?, _ size: Int) -> Int32 {
+        setxattr(path, name(for: key), value, size, 0)
+    }
+
+    static func removeAttribute(_ path: UnsafePointer<CChar>?, _ key: String) -> Int32 {
+        removexattr(path, name(for: key))
+    }
+
+    static func listAttributes(_ path: UnsafePointer<CChar>?, _ names: UnsafeMutablePointer<CChar>?, _ size: Int) -> Int {
+        listxattr(path, names, size)
+    }
+    #else
+    static func key(fromName name: String) -> String {
+        name
+    }
+
+    static func getAttribute(_ path: UnsafePointer<CChar>?, _ key: String, _ value: UnsafeMutableRawPointer?, _ size: Int) -> Int {
+        getxattr(path, key, value, size, 0, 0)
+    }
+
+    static func setAttribute(_ path: UnsafePointer<CChar>?, _ key: String, _ value: UnsafeRawPointer?, _ size: Int) -> Int32 {
+        setxattr(path, key, value, size, 0, 0)
+    }
+
+    static func removeAttribute(_ path: UnsafePointer<CChar>?, _ key: String) -> Int32 {
+        removexattr(path, key, 0)
+    }
+
+    static func listAttributes(_ path: UnsafePointer<CChar>?, _ names: UnsafeMutablePointer<CChar>?, _ size: Int) -> Int {
+        listxattr(path, names, size, 0)
+    }
+    #endif
 }
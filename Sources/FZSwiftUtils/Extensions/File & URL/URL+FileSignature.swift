@@ -0,0 +1,316 @@
+//
+//  URL+FileSignature.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+#if canImport(Darwin)
+import Darwin
+#elseif canImport(Glibc)
+import Glibc
+#endif
+
+public extension URL.FileType {
+    /// The number of bytes at the start of a file that are read to detect its type.
+    static let signatureByteCount = 512
+
+    /**
+     Returns the type for the file at the specified url by its contents.
+
+     The type is detected from the magic numbers at the start of the file, so it doesn't depend on the file extension or the type database of the platform. Files without a known signature are detected as `text` if their contents are valid UTF-8 text.
+
+     - Parameter url: The url of the file.
+     */
+    init?(contentsOf url: URL) {
+        var buffer = [UInt8](repeating: 0, count: Self.signatureByteCount)
+        let count = buffer.withUnsafeMutableBytes { Self.readSignature(of: url, into: $0) }
+        guard count > 0 else { return nil }
+        let fileType = buffer.withUnsafeBytes { URL.FileType(signature: UnsafeRawBufferPointer(rebasing: $0[0..<count])) }
+        guard let fileType = fileType else { return nil }
+        self = fileType
+    }
+
+    /**
+     Returns the type for the data by its contents.
+
+     - Parameter data: The data, or its first bytes.
+     */
+    init?(data: Data) {
+        guard let fileType = data.prefix(Self.signatureByteCount).withUnsafeBytes({ URL.FileType(signature: $0) }) else { return nil }
+        self = fileType
+    }
+
+    /**
+     Returns the type for the bytes at the start of a file.
+
+     - Parameter bytes: The first bytes of the file. Detection uses up to ``signatureByteCount`` bytes.
+     */
+    init?(signature bytes: UnsafeRawBufferPointer) {
+        guard !bytes.isEmpty else { return nil }
+        let bytes = UnsafeRawBufferPointer(rebasing: bytes.prefix(Self.signatureByteCount))
+        if let rule = FileSignature.table[Int(bytes[0])].first(where: { $0.matches(bytes) }) ?? FileSignature.offsetRules.first(where: { $0.matches(bytes) }) {
+            self = rule.fileType
+        } else if FileSignature.isText(bytes) {
+            self = .text
+        } else {
+            return nil
+        }
+    }
+
+    /**
+     Returns the types of the files at the specified urls by their contents.
+
+     The files are read concurrently. Each worker has at most one file open at a time, so the number of open file descriptors is limited to `maxOpenFiles`.
+
+     - Parameters:
+        - urls: The urls of the files.
+        - maxOpenFiles: The maximum number of files that are open at the same time.
+     - Returns: The types of the files, in the order of the urls.
+     */
+    static func detect(_ urls: [URL], maxOpenFiles: Int = 32) -> [URL.FileType?] {
+        guard !urls.isEmpty else { return [] }
+        var fileTypes = [URL.FileType?](repeating: nil, count: urls.count)
+        let lock = NSLock()
+        var nextIndex = 0
+        fileTypes.withUnsafeMutableBufferPointer { fileTypes in
+            DispatchQueue.concurrentPerform(iterations: max(1, min(maxOpenFiles, urls.count))) { _ in
+                var buffer = [UInt8](repeating: 0, count: signatureByteCount)
+                while true {
+                    lock.lock()
+                    let index = nextIndex
+                    nextIndex += 1
+                    lock.unlock()
+                    guard index < urls.count else { return }
+                    let count = buffer.withUnsafeMutableBytes { readSignature(of: urls[index], into: $0) }
+                    guard count > 0 else { continue }
+                    fileTypes[index] = buffer.withUnsafeBytes { URL.FileType(signature: UnsafeRawBufferPointer(rebasing: $0[0..<count])) }
+                }
+            }
+        }
+        return fileTypes
+    }
+
+    /// Reads the first bytes of the regular file into the buffer and returns the number of read bytes.
+    internal static func readSignature(of url: URL, into buffer: UnsafeMutableRawBufferPointer) -> Int {
+        // Opening without blocking returns immediately for FIFOs and devices, which are then skipped.
+        let fileDescriptor = url.withUnsafeFileSystemRepresentation { path -> Int32 in
+            guard let path = path else { return -1 }
+            return open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC)
+        }
+        guard fileDescriptor >= 0 else { return 0 }
+        defer { close(fileDescriptor) }
+        var info = stat()
+        guard fstat(fileDescriptor, &info) == 0, info.st_mode & S_IFMT == S_IFREG else { return 0 }
+        var count = 0
+        while count < buffer.count {
+            let result = read(fileDescriptor, buffer.baseAddress! + count, buffer.count - count)
+            guard result > 0 else { break }
+            count += result
+        }
+        return count
+    }
+}
+
+/// The magic numbers of file types.
+enum FileSignature {
+    /// A sequence of bytes at an offset. If there is a mask, each byte is combined with its mask byte with a bitwise AND before comparing, so only the set bits of the mask are compared.
+    struct Pattern {
+        let offset: Int
+        let bytes: [UInt8]
+        let mask: [UInt8]?
+
+        init(_ offset: Int, _ bytes: [UInt8], mask: [UInt8]? = nil) {
+            self.offset = offset
+            self.bytes = bytes
+            self.mask = mask
+        }
+
+        init(_ offset: Int, _ string: String) {
+            self.init(offset, Array(string.utf8))
+        }
+
+        func matches(_ buffer: UnsafeRawBufferPointer) -> Bool {
+            guard offset + bytes.count <= buffer.count else { return false }
+            for index in 0..<bytes.count {
+                var byte = buffer[offset + index]
+                if let mask = mask {
+                    byte &= mask[index]
+                }
+                if byte != bytes[index] { return false }
+            }
+            return true
+        }
+    }
+
+    /// A file type and the patterns a file of the type matches.
+    struct Rule {
+        let fileType: URL.FileType
+        let patterns: [Pattern]
+        /// An additional check for headers that can't be described by patterns at fixed offsets.
+        let validate: ((UnsafeRawBufferPointer) -> Bool)?
+
+        init(_ fileType: URL.FileType, _ patterns: Pattern..., validate: ((UnsafeRawBufferPointer) -> Bool)? = nil) {
+            self.fileType = fileType
+            self.patterns = patterns
+            self.validate = validate
+        }
+
+        func matches(_ buffer: UnsafeRawBufferPointer) -> Bool {
+            patterns.allSatisfy { $0.matches(buffer) } && validate?(buffer) != false
+        }
+    }
+
+    /// Returns a Boolean value indicating whether the DOS header points to a PE header.
+    static func hasPortableExecutableHeader(_ buffer: UnsafeRawBufferPointer) -> Bool {
+        guard buffer.count >= 0x40 else { return false }
+        let offset = Int(UInt32(littleEndian: buffer.loadUnaligned(fromByteOffset: 0x3C, as: UInt32.self)))
+        return Pattern(offset, [0x50, 0x45, 0x00, 0x00]).matches(buffer)
+    }
+
+    /// The rules, in the order they are checked. More specific rules precede the rules they overlap with.
+    static let rules: [Rule] = [
+        // Text with byte order mark
+        Rule(.text, Pattern(0, [0xEF, 0xBB, 0xBF])),
+        Rule(.text, Pattern(0, [0xFE, 0xFF])),
+        Rule(.text, Pattern(0, [0xFF, 0xFE])),
+        Rule(.text, Pattern(0, "{\\rtf")),
+
+        // Images
+        Rule(.image, Pattern(0, [0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A])),
+        Rule(.image, Pattern(0, [0xFF, 0xD8, 0xFF])),
+        Rule(.gif, Pattern(0, "GIF87a")),
+        Rule(.gif, Pattern(0, "GIF89a")),
+        Rule(.image, Pattern(0, [0x49, 0x49, 0x2A, 0x00])),
+        Rule(.image, Pattern(0, [0x4D, 0x4D, 0x00, 0x2A])),
+        Rule(.image, Pattern(0, "RIFF"), Pattern(8, "WEBP")),
+        Rule(.image, Pattern(0, "8BPS"), Pattern(4, [0x00, 0x01])),
+        Rule(.image, Pattern(0, [0x00, 0x00, 0x01, 0x00])),
+        Rule(.image, Pattern(0, [0x00, 0x00, 0x00, 0x0C, 0x6A, 0x50, 0x20, 0x20])),
+        // BMP with reserved bytes of zero and a known DIB header size.
+        Rule(.image, Pattern(0, "BM"), Pattern(6, [0x00, 0x00, 0x00, 0x00]), Pattern(14, [0x0C, 0x00, 0x00, 0x00])),
+        Rule(.image, Pattern(0, "BM"), Pattern(6, [0x00, 0x00, 0x00, 0x00]), Pattern(14, [0x28, 0x00, 0x00, 0x00])),
+        Rule(.image, Pattern(0, "BM"), Pattern(6, [0x00, 0x00, 0x00, 0x00]), Pattern(14, [0x38, 0x00, 0x00, 0x00])),
+        Rule(.image, Pattern(0, "BM"), Pattern(6, [0x00, 0x00, 0x00, 0x00]), Pattern(14, [0x6C, 0x00, 0x00, 0x00])),
+        Rule(.image, Pattern(0, "BM"), Pattern(6, [0x00, 0x00, 0x00, 0x00]), Pattern(14, [0x7C, 0x00, 0x00, 0x00])),
+
+        // Video
+        Rule(.video, Pattern(0, [0x1A, 0x45, 0xDF, 0xA3])),
+        Rule(.video, Pattern(0, "RIFF"), Pattern(8, "AVI ")),
+        Rule(.video, Pattern(0, [0x46, 0x4C, 0x56, 0x01])),
+        Rule(.video, Pattern(0, [0x00, 0x00, 0x01, 0xBA])),
+        Rule(.video, Pattern(0, [0x00, 0x00, 0x01, 0xB3])),
+        Rule(.video, Pattern(0, [0x30, 0x26, 0xB2, 0x75, 0x8E, 0x66, 0xCF, 0x11])),
+        Rule(.video, Pattern(0, [0x47]), Pattern(188, [0x47]), Pattern(376, [0x47])),
+
+        // Audio
+        // ID3v2.2 to ID3v2.4 tags
+        Rule(.audio, Pattern(0, [0x49, 0x44, 0x33, 0x02])),
+        Rule(.audio, Pattern(0, [0x49, 0x44, 0x33, 0x03])),
+        Rule(.audio, Pattern(0, [0x49, 0x44, 0x33, 0x04])),
+        Rule(.audio, Pattern(0, "fLaC")),
+        Rule(.audio, Pattern(0, "OggS")),
+        Rule(.audio, Pattern(0, "RIFF"), Pattern(8, "WAVE")),
+        Rule(.audio, Pattern(0, "FORM"), Pattern(8, "AIFF")),
+        Rule(.audio, Pattern(0, "FORM"), Pattern(8, "AIFC")),
+        Rule(.audio, Pattern(0, "MThd"), Pattern(4, [0x00, 0x00, 0x00, 0x06])),
+        Rule(.audio, Pattern(0, "caff"), Pattern(4, [0x00, 0x01, 0x00, 0x00])),
+        Rule(.audio, Pattern(0, "#!AMR")),
+        // MPEG audio and AAC frame sync
+        Rule(.audio, Pattern(0, [0xFF, 0xE0], mask: [0xFF, 0xE0])),
+
+        // Archives
+        Rule(.archive, Pattern(0, [0x50, 0x4B, 0x03, 0x04])),
+        Rule(.archive, Pattern(0, [0x50, 0x4B, 0x05, 0x06])),
+        Rule(.archive, Pattern(0, [0x50, 0x4B, 0x07, 0x08])),
+        Rule(.archive, Pattern(0, [0x52, 0x61, 0x72, 0x21, 0x1A, 0x07])),
+        Rule(.archive, Pattern(0, [0x37, 0x7A, 0xBC, 0xAF, 0x27, 0x1C])),
+        Rule(.archive, Pattern(0, [0x1F, 0x8B])),
+        // bzip2 with a block size digit, followed by the magic of a block or of the end of the stream.
+        Rule(.archive, Pattern(0, "BZh"), Pattern(3, [0x30], mask: [0xF0]), Pattern(4, [0x31, 0x41, 0x59, 0x26, 0x53, 0x59])),
+        Rule(.archive, Pattern(0, "BZh"), Pattern(3, [0x30], mask: [0xF0]), Pattern(4, [0x17, 0x72, 0x45, 0x38, 0x50, 0x90])),
+        Rule(.archive, Pattern(0, [0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00])),
+        Rule(.archive, Pattern(0, [0x28, 0xB5, 0x2F, 0xFD])),
+        Rule(.archive, Pattern(0, [0x04, 0x22, 0x4D, 0x18])),
+        Rule(.archive, Pattern(0, "MSCF")),
+        Rule(.archive, Pattern(0, "xar!")),
+        Rule(.archive, Pattern(257, "ustar")),
+
+        // PDF
+        Rule(.pdf, Pattern(0, "%PDF-")),
+
+        // Executables
+        Rule(.executable, Pattern(0, [0x7F, 0x45, 0x4C, 0x46])),
+        Rule(.executable, Pattern(0, [0xFE, 0xED, 0xFA, 0xCE])),
+        Rule(.executable, Pattern(0, [0xFE, 0xED, 0xFA, 0xCF])),
+        Rule(.executable, Pattern(0, [0xCE, 0xFA, 0xED, 0xFE])),
+        Rule(.executable, Pattern(0, [0xCF, 0xFA, 0xED, 0xFE])),
+        Rule(.executable, Pattern(0, [0xCA, 0xFE, 0xBA, 0xBE])),
+        Rule(.executable, Pattern(0, "MZ"), validate: FileSignature.hasPortableExecutableHeader),
+        Rule(.executable, Pattern(0, "#!")),
+
+        // ISO base media and QuickTime files, by their major brand or first box. The big-endian box size starts with a zero byte.
+        Rule(.image, Pattern(0, [0x00]), Pattern(4, "ftypheic")),
+        Rule(.image, Pattern(0, [0x00]), Pattern(4, "ftypheix")),
+        Rule(.image, Pattern(0, [0x00]), Pattern(4, "ftyphevc")),
+        Rule(.image, Pattern(0, [0x00]), Pattern(4, "ftypheim")),
+        Rule(.image, Pattern(0, [0x00]), Pattern(4, "ftypheis")),
+        Rule(.image, Pattern(0, [0x00]), Pattern(4, "ftypmif1")),
+        Rule(.image, Pattern(0, [0x00]), Pattern(4, "ftypmsf1")),
+        Rule(.image, Pattern(0, [0x00]), Pattern(4, "ftypavif")),
+        Rule(.audio, Pattern(0, [0x00]), Pattern(4, "ftypM4A ")),
+        Rule(.audio, Pattern(0, [0x00]), Pattern(4, "ftypM4B ")),
+        Rule(.audio, Pattern(0, [0x00]), Pattern(4, "ftypM4P ")),
+        Rule(.video, Pattern(0, [0x00]), Pattern(4, "ftyp")),
+        Rule(.video, Pattern(0, [0x00]), Pattern(4, "moov")),
+        Rule(.video, Pattern(0, [0x00]), Pattern(4, "mdat")),
+        Rule(.video, Pattern(0, [0x00]), Pattern(4, "wide")),
+    ]
+
+    /// The rules that start with a pattern at offset 0, by the first byte of the pattern.
+    static let table: [[Rule]] = {
+        var table = [[Rule]](repeating: [], count: 256)
+        for rule in rules {
+            if let pattern = rule.patterns.first, pattern.offset == 0, pattern.mask == nil {
+                table[Int(pattern.bytes[0])].append(rule)
+            } else if let pattern = rule.patterns.first, pattern.offset == 0, let mask = pattern.mask {
+                for byte in 0...255 where UInt8(byte) & mask[0] == pattern.bytes[0] {
+                    table[byte].append(rule)
+                }
+            }
+        }
+        return table
+    }()
+
+    /// The rules that don't start with a pattern at offset 0.
+    static let offsetRules: [Rule] = rules.filter { $0.patterns.first?.offset != 0 }
+
+    /// Returns a Boolean value indicating whether the bytes are UTF-8 text without control characters other than whitespace.
+    static func isText(_ bytes: UnsafeRawBufferPointer) -> Bool {
+        var index = 0
+        while index < bytes.count {
+            let byte = bytes[index]
+            if byte < 0x80 {
+                // Tab, line feed, form feed, carriage return and escape.
+                guard byte >= 0x20 || byte == 0x09 || byte == 0x0A || byte == 0x0C || byte == 0x0D || byte == 0x1B, byte != 0x7F else { return false }
+                index += 1
+                continue
+            }
+            let length: Int
+            switch byte {
+            case 0xC2...0xDF: length = 2
+            case 0xE0...0xEF: length = 3
+            case 0xF0...0xF4: length = 4
+            default: return false
+            }
+            for offset in 1..<length {
+                // The last character may be cut off by the end of the read bytes.
+                guard index + offset < bytes.count else { return true }
+                guard bytes[index + offset] & 0xC0 == 0x80 else { return false }
+            }
+            index += length
+        }
+        return true
+    }
+}
@@ -7,143 +7,143 @@
 
 import Foundation
 
-internal extension PartialKeyPath where Root == URLResourceValues {
-    var resourceKey: URLResourceKey? {
-        switch self {
-        case \Root.documentIdentifier: return .documentIdentifierKey
-        case \Root.fileResourceIdentifier: return .fileResourceIdentifierKey
-        case \Root.fileAllocatedSize: return .fileAllocatedSizeKey
-        case \Root.fileResourceType: return .fileResourceTypeKey
-        case \Root.fileSecurity: return .fileSecurityKey
-        case \Root.fileSize: return .fileSizeKey
-        case \Root.isExecutable: return .isExecutableKey
-        case \Root.isRegularFile: return .isRegularFileKey
-        case \Root.isDirectory: return .isDirectoryKey
-        case \Root.totalFileAllocatedSize: return .totalFileAllocatedSizeKey
-        case \Root.totalFileSize: return .totalFileSizeKey
-        case \Root.volumeAvailableCapacity: return .volumeAvailableCapacityKey
-        case \Root.volumeAvailableCapacityForImportantUsage: return .volumeAvailableCapacityForImportantUsageKey
-        case \Root.volumeAvailableCapacityForOpportunisticUsage: return .volumeAvailableCapacityForOpportunisticUsageKey
-        case \Root.volumeTotalCapacity: return .volumeTotalCapacityKey
-        case \Root.volumeIsAutomounted: return .volumeIsAutomountedKey
-        case \Root.volumeIsBrowsable: return .volumeIsBrowsableKey
-        case \Root.volumeIsEjectable: return .volumeIsEjectableKey
-        case \Root.volumeIsEncrypted: return .volumeIsEncryptedKey
-        case \Root.volumeIsInternal: return .volumeIsInternalKey
-        case \Root.volumeIsJournaling: return .volumeIsJournalingKey
-        case \Root.volumeIsLocal: return .volumeIsLocalKey
-        case \Root.volumeIsReadOnly: return .volumeIsReadOnlyKey
-        case \Root.volumeIsRemovable: return .volumeIsRemovableKey
-        case \Root.volumeIsRootFileSystem: return .volumeIsRootFileSystemKey
-        case \Root.isMountTrigger: return .isMountTriggerKey
-        case \Root.isVolume: return .isVolumeKey
-        case \Root.volume: return .volumeURLKey
-        case \Root.volumeCreationDate: return .volumeCreationDateKey
-        case \Root.volumeIdentifier: return .volumeIdentifierKey
-        case \Root.volumeLocalizedFormatDescription: return .volumeLocalizedFormatDescriptionKey
-        case \Root.volumeLocalizedName: return .volumeLocalizedNameKey
-        case \Root.volumeMaximumFileSize: return .volumeMaximumFileSizeKey
-        case \Root.volumeName: return .volumeNameKey
-        case \Root.volumeResourceCount: return .volumeResourceCountKey
-        case \Root.volumeSupportsAccessPermissions: return .volumeSupportsAccessPermissionsKey
-        case \Root.volumeSupportsAdvisoryFileLocking: return .volumeSupportsAdvisoryFileLockingKey
-        case \Root.volumeSupportsCasePreservedNames: return .volumeSupportsCasePreservedNamesKey
-        case \Root.volumeSupportsCaseSensitiveNames: return .volumeSupportsCaseSensitiveNamesKey
-        case \Root.volumeSupportsCompression: return .volumeSupportsCompressionKey
-        case \Root.volumeSupportsExclusiveRenaming: return .volumeSupportsExclusiveRenamingKey
-        case \Root.volumeSupportsExtendedSecurity: return .volumeSupportsExtendedSecurityKey
-        case \Root.volumeSupportsFileCloning: return .volumeSupportsFileCloningKey
-        case \Root.volumeSupportsHardLinks: return .volumeSupportsHardLinksKey
-        case \Root.volumeSupportsImmutableFiles: return .volumeSupportsImmutableFilesKey
-        case \Root.volumeSupportsJournaling: return .volumeSupportsJournalingKey
-        case \Root.volumeSupportsPersistentIDs: return .volumeSupportsPersistentIDsKey
-        case \Root.volumeSupportsRenaming: return .volumeSupportsRenamingKey
-        case \Root.volumeSupportsRootDirectoryDates: return .volumeSupportsRootDirectoryDatesKey
-        case \Root.volumeSupportsSparseFiles: return .volumeSupportsSparseFilesKey
-        case \Root.volumeSupportsSwapRenaming: return .volumeSupportsSwapRenamingKey
-        case \Root.volumeSupportsSymbolicLinks: return .volumeSupportsSymbolicLinksKey
-        case \Root.volumeSupportsVolumeSizes: return .volumeSupportsVolumeSizesKey
-        case \Root.volumeSupportsZeroRuns: return .volumeSupportsZeroRunsKey
-        case \Root.volumeURLForRemounting: return .volumeURLForRemountingKey
-        case \Root.volumeUUIDString: return .volumeUUIDStringKey
-        case \Root.isUbiquitousItem: return .isUbiquitousItemKey
-        case \Root.ubiquitousItemIsShared: return .ubiquitousItemIsSharedKey
-        case \Root.ubiquitousSharedItemCurrentUserPermissions: return .ubiquitousSharedItemCurrentUserPermissionsKey
-        case \Root.ubiquitousSharedItemCurrentUserRole: return .ubiquitousSharedItemCurrentUserRoleKey
-        case \Root.ubiquitousSharedItemMostRecentEditorNameComponents: return .ubiquitousSharedItemMostRecentEditorNameComponentsKey
-        case \Root.ubiquitousSharedItemOwnerNameComponents: return .ubiquitousSharedItemOwnerNameComponentsKey
-        case \Root.ubiquitousItemContainerDisplayName: return .ubiquitousItemContainerDisplayNameKey
-        case \Root.ubiquitousItemDownloadRequested: return .ubiquitousItemDownloadRequestedKey
-        case \Root.ubiquitousItemDownloadingError: return .ubiquitousItemDownloadingErrorKey
-        case \Root.ubiquitousItemDownloadingStatus: return .ubiquitousItemDownloadingStatusKey
-        case \Root.ubiquitousItemHasUnresolvedConflicts: return .ubiquitousItemHasUnresolvedConflictsKey
-        case \Root.ubiquitousItemIsDownloading: return .ubiquitousItemIsDownloadingKey
-        case \Root.ubiquitousItemIsUploaded: return .ubiquitousItemIsUploadedKey
-        case \Root.ubiquitousItemIsUploading: return .ubiquitousItemIsUploadingKey
-        case \Root.ubiquitousItemUploadingError: return .ubiquitousItemUploadingErrorKey
-        case \Root.thumbnailDictionary: return .thumbnailDictionaryKey
-        case \Root.thumbnailDictionary: return .thumbnailDictionaryKey
-        case \Root.addedToDirectoryDate: return .addedToDirectoryDateKey
-        case \Root.attributeModificationDate: return .attributeModificationDateKey
-        case \Root.canonicalPath: return .canonicalPathKey
-        case \Root.contentAccessDate: return .contentAccessDateKey
-        case \Root.contentModificationDate: return .contentModificationDateKey
-        case \Root.creationDate: return .creationDateKey
-        case \Root.generationIdentifier: return .generationIdentifierKey
-        case \Root.hasHiddenExtension: return .hasHiddenExtensionKey
-        case \Root.isAliasFile: return .isAliasFileKey
-        case \Root.isExcludedFromBackup: return .isExcludedFromBackupKey
-        case \Root.isHidden: return .isHiddenKey
-        case \Root.isPackage: return .isPackageKey
-        case \Root.isReadable: return .isReadableKey
-        case \Root.isSymbolicLink: return .isSymbolicLinkKey
-        case \Root.isSystemImmutable: return .isSystemImmutableKey
-        case \Root.isUserImmutable: return .isUserImmutableKey
-        case \Root.isWritable: return .isWritableKey
-        case \Root.labelNumber: return .labelNumberKey
-        case \Root.linkCount: return .linkCountKey
-        case \Root.localizedLabel: return .localizedLabelKey
-        case \Root.localizedName: return .localizedNameKey
-        case \Root.localizedTypeDescription: return .localizedTypeDescriptionKey
-        case \Root.name: return .nameKey
-        case \Root.parentDirectory: return .parentDirectoryURLKey
-        case \Root.path: return .pathKey
-        case \Root.preferredIOBlockSize: return .preferredIOBlockSizeKey
-        case \Root.typeIdentifier: return .typeIdentifierKey
-        default: break
-        }
+internal extension URLResourceValues {
+    /// The resource keys of the properties.
+    static let resourceKeys: [PartialKeyPath<URLResourceValues>: URLResourceKey] = {
+        var resourceKeys: [PartialKeyPath<URLResourceValues>: URLResourceKey] = [
+            \URLResourceValues.documentIdentifier: .documentIdentifierKey,
+            \URLResourceValues.fileResourceIdentifier: .fileResourceIdentifierKey,
+            \URLResourceValues.fileAllocatedSize: .fileAllocatedSizeKey,
+            \URLResourceValues.fileResourceType: .fileResourceTypeKey,
+            \URLResourceValues.fileSecurity: .fileSecurityKey,
+            \URLResourceValues.fileSize: .fileSizeKey,
+            \URLResourceValues.isExecutable: .isExecutableKey,
+            \URLResourceValues.isRegularFile: .isRegularFileKey,
+            \URLResourceValues.isDirectory: .isDirectoryKey,
+            \URLResourceValues.totalFileAllocatedSize: .totalFileAllocatedSizeKey,
+            \URLResourceValues.totalFileSize: .totalFileSizeKey,
+            \URLResourceValues.volumeAvailableCapacity: .volumeAvailableCapacityKey,
+            \URLResourceValues.volumeAvailableCapacityForImportantUsage: .volumeAvailableCapacityForImportantUsageKey,
+            \URLResourceValues.volumeAvailableCapacityForOpportunisticUsage: .volumeAvailableCapacityForOpportunisticUsageKey,
+            \URLResourceValues.volumeTotalCapacity: .volumeTotalCapacityKey,
+            \URLResourceValues.volumeIsAutomounted: .volumeIsAutomountedKey,
+            \URLResourceValues.volumeIsBrowsable: .volumeIsBrowsableKey,
+            \URLResourceValues.volumeIsEjectable: .volumeIsEjectableKey,
+            \URLResourceValues.volumeIsEncrypted: .volumeIsEncryptedKey,
+            \URLResourceValues.volumeIsInternal: .volumeIsInternalKey,
+            \URLResourceValues.volumeIsJournaling: .volumeIsJournalingKey,
+            \URLResourceValues.volumeIsLocal: .volumeIsLocalKey,
+            \URLResourceValues.volumeIsReadOnly: .volumeIsReadOnlyKey,
+            \URLResourceValues.volumeIsRemovable: .volumeIsRemovableKey,
+            \URLResourceValues.volumeIsRootFileSystem: .volumeIsRootFileSystemKey,
+            \URLResourceValues.isMountTrigger: .isMountTriggerKey,
+            \URLResourceValues.isVolume: .isVolumeKey,
+            \URLResourceValues.volume: .volumeURLKey,
+            \URLResourceValues.volumeCreationDate: .volumeCreationDateKey,
+            \URLResourceValues.volumeIdentifier: .volumeIdentifierKey,
+            \URLResourceValues.volumeLocalizedFormatDescription: .volumeLocalizedFormatDescriptionKey,
+            \URLResourceValues.volumeLocalizedName: .volumeLocalizedNameKey,
+            \URLResourceValues.volumeMaximumFileSize: .volumeMaximumFileSizeKey,
+            \URLResourceValues.volumeName: .volumeNameKey,
+            \URLResourceValues.volumeResourceCount: .volumeResourceCountKey,
+            \URLResourceValues.volumeSupportsAccessPermissions: .volumeSupportsAccessPermissionsKey,
+            \URLResourceValues.volumeSupportsAdvisoryFileLocking: .volumeSupportsAdvisoryFileLockingKey,
+            \URLResourceValues.volumeSupportsCasePreservedNames: .volumeSupportsCasePreservedNamesKey,
+            \URLResourceValues.volumeSupportsCaseSensitiveNames: .volumeSupportsCaseSensitiveNamesKey,
+            \URLResourceValues.volumeSupportsCompression: .volumeSupportsCompressionKey,
+            \URLResourceValues.volumeSupportsExclusiveRenaming: .volumeSupportsExclusiveRenamingKey,
+            \URLResourceValues.volumeSupportsExtendedSecurity: .volumeSupportsExtendedSecurityKey,
+            \URLResourceValues.volumeSupportsFileCloning: .volumeSupportsFileCloningKey,
+            \URLResourceValues.volumeSupportsHardLinks: .volumeSupportsHardLinksKey,
+            \URLResourceValues.volumeSupportsImmutableFiles: .volumeSupportsImmutableFilesKey,
+            \URLResourceValues.volumeSupportsJournaling: .volumeSupportsJournalingKey,
+            \URLResourceValues.volumeSupportsPersistentIDs: .volumeSupportsPersistentIDsKey,
+            \URLResourceValues.volumeSupportsRenaming: .volumeSupportsRenamingKey,
+            \URLResourceValues.volumeSupportsRootDirectoryDates: .volumeSupportsRootDirectoryDatesKey,
+            \URLResourceValues.volumeSupportsSparseFiles: .volumeSupportsSparseFilesKey,
+            \URLResourceValues.volumeSupportsSwapRenaming: .volumeSupportsSwapRenamingKey,
+            \URLResourceValues.volumeSupportsSymbolicLinks: .volumeSupportsSymbolicLinksKey,
+            \URLResourceValues.volumeSupportsVolumeSizes: .volumeSupportsVolumeSizesKey,
+            \URLResourceValues.volumeSupportsZeroRuns: .volumeSupportsZeroRunsKey,
+            \URLResourceValues.volumeURLForRemounting: .volumeURLForRemountingKey,
+            \URLResourceValues.volumeUUIDString: .volumeUUIDStringKey,
+            \URLResourceValues.isUbiquitousItem: .isUbiquitousItemKey,
+            \URLResourceValues.ubiquitousItemIsShared: .ubiquitousItemIsSharedKey,
+            \URLResourceValues.ubiquitousSharedItemCurrentUserPermissions: .ubiquitousSharedItemCurrentUserPermissionsKey,
+            \URLResourceValues.ubiquitousSharedItemCurrentUserRole: .ubiquitousSharedItemCurrentUserRoleKey,
+            \URLResourceValues.ubiquitousSharedItemMostRecentEditorNameComponents: .ubiquitousSharedItemMostRecentEditorNameComponentsKey,
+            \URLResourceValues.ubiquitousSharedItemOwnerNameComponents: .ubiquitousSharedItemOwnerNameComponentsKey,
+            \URLResourceValues.ubiquitousItemContainerDisplayName: .ubiquitousItemContainerDisplayNameKey,
+            \URLResourceValues.ubiquitousItemDownloadRequested: .ubiquitousItemDownloadRequestedKey,
+            \URLResourceValues.ubiquitousItemDownloadingError: .ubiquitousItemDownloadingErrorKey,
+            \URLResourceValues.ubiquitousItemDownloadingStatus: .ubiquitousItemDownloadingStatusKey,
+            \URLResourceValues.ubiquitousItemHasUnresolvedConflicts: .ubiquitousItemHasUnresolvedConflictsKey,
+            \URLResourceValues.ubiquitousItemIsDownloading: .ubiquitousItemIsDownloadingKey,
+            \URLResourceValues.ubiquitousItemIsUploaded: .ubiquitousItemIsUploadedKey,
+            \URLResourceValues.ubiquitousItemIsUploading: .ubiquitousItemIsUploadingKey,
+            \URLResourceValues.ubiquitousItemUploadingError: .ubiquitousItemUploadingErrorKey,
+            \URLResourceValues.thumbnailDictionary: .thumbnailDictionaryKey,
+            \URLResourceValues.addedToDirectoryDate: .addedToDirectoryDateKey,
+            \URLResourceValues.attributeModificationDate: .attributeModificationDateKey,
+            \URLResourceValues.canonicalPath: .canonicalPathKey,
+            \URLResourceValues.contentAccessDate: .contentAccessDateKey,
+            \URLResourceValues.contentModificationDate: .contentModificationDateKey,
+            \URLResourceValues.creationDate: .creationDateKey,
+            \URLResourceValues.generationIdentifier: .generationIdentifierKey,
+            \URLResourceValues.hasHiddenExtension: .hasHiddenExtensionKey,
+            \URLResourceValues.isAliasFile: .isAliasFileKey,
+            \URLResourceValues.isExcludedFromBackup: .isExcludedFromBackupKey,
+            \URLResourceValues.isHidden: .isHiddenKey,
+            \URLResourceValues.isPackage: .isPackageKey,
+            \URLResourceValues.isReadable: .isReadableKey,
+            \URLResourceValues.isSymbolicLink: .isSymbolicLinkKey,
+            \URLResourceValues.isSystemImmutable: .isSystemImmutableKey,
+            \URLResourceValues.isUserImmutable: .isUserImmutableKey,
+            \URLResourceValues.isWritable: .isWritableKey,
+            \URLResourceValues.labelNumber: .labelNumberKey,
+            \URLResourceValues.linkCount: .linkCountKey,
+            \URLResourceValues.localizedLabel: .localizedLabelKey,
+            \URLResourceValues.localizedName: .localizedNameKey,
+            \URLResourceValues.localizedTypeDescription: .localizedTypeDescriptionKey,
+            \URLResourceValues.name: .nameKey,
+            \URLResourceValues.parentDirectory: .parentDirectoryURLKey,
+            \URLResourceValues.path: .pathKey,
+            \URLResourceValues.preferredIOBlockSize: .preferredIOBlockSizeKey,
+            \URLResourceValues.typeIdentifier: .typeIdentifierKey,
+            \URLResourceValues.isApplication: .isApplicationKey
+        ]
 
         #if os(macOS)
-        switch self {
-        case \Root.thumbnail: return .thumbnailKey
-        case \Root.customIcon: return .customIconKey
-        case \Root.effectiveIcon: return .effectiveIconKey
-        case \Root.labelColor: return .labelColorKey
-        case \Root.quarantineProperties: return .quarantinePropertiesKey
-        case \Root.tagNames: return .tagNamesKey
-        default: break
-        }
+        resourceKeys.merge([
+            \URLResourceValues.thumbnail: .thumbnailKey,
+            \URLResourceValues.customIcon: .customIconKey,
+            \URLResourceValues.effectiveIcon: .effectiveIconKey,
+            \URLResourceValues.labelColor: .labelColorKey,
+            \URLResourceValues.quarantineProperties: .quarantinePropertiesKey,
+            \URLResourceValues.tagNames: .tagNamesKey,
+            \URLResourceValues.applicationIsScriptable: .applicationIsScriptableKey
+        ]) { $1 }
         #endif
 
         if #available(macOS 11.3, iOS 14.5, *) {
-            switch self {
-            case \Root.ubiquitousItemIsExcludedFromSync: return .ubiquitousItemIsExcludedFromSyncKey
-            default: break
-            }
+            resourceKeys[\URLResourceValues.ubiquitousItemIsExcludedFromSync] = .ubiquitousItemIsExcludedFromSyncKey
         }
 
         if #available(macOS 11.0, iOS 14.0, *) {
-            switch self {
-            case \Root.mayShareFileContent: return .mayShareFileContentKey
-            case \Root.mayHaveExtendedAttributes: return .mayHaveExtendedAttributesKey
-            case \Root.isPurgeable: return .isPurgeableKey
-            case \Root.isSparse: return .isSparseKey
-            case \Root.fileContentIdentifier: return .fileContentIdentifierKey
-            case \Root.fileProtection: return .fileProtectionKey
-            case \Root.contentType: return .contentTypeKey
-            default: break
-            }
+            resourceKeys[\URLResourceValues.mayShareFileContent] = .mayShareFileContentKey
+            resourceKeys[\URLResourceValues.mayHaveExtendedAttributes] = .mayHaveExtendedAttributesKey
+            resourceKeys[\URLResourceValues.isPurgeable] = .isPurgeableKey
+            resourceKeys[\URLResourceValues.isSparse] = .isSparseKey
+            resourceKeys[\URLResourceValues.fileContentIdentifier] = .fileContentIdentifierKey
+            resourceKeys[\URLResourceValues.fileProtection] = .fileProtectionKey
+            resourceKeys[\URLResourceValues.contentType] = .contentTypeKey
         }
-        return nil
+        return resourceKeys
+    }()
+}
+
+internal extension PartialKeyPath where Root == URLResourceValues {
+    var resourceKey: URLResourceKey? {
+        URLResourceValues.resourceKeys[self]
     }
 }
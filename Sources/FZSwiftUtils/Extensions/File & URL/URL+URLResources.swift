@@ -28,29 +28,118 @@ public extension URL {
  The properties of a file system resource.
  
  Some of the properties can be modified. Not all properties exist for all files. For example, if a file is located on a volume that doesn’t support creation dates, the creationDate property will return nil.
+
+ Each property is looked up separately. To read several properties, fetch them in one batch with ``prefetch(_:)``:
+
+ ```swift
+ let resources = url.resources
+ try resources.prefetch([\.fileSize, \.creationDate, \.contentModificationDate, \.isHidden])
+ let fileSize = resources.fileSize
+ ```
  */
 public class URLResources {
     /// The url to the resource
     public private(set) var url: URL
-    
+
+    /**
+     A Boolean value indicating whether the values of the properties are cached.
+
+     If `true`, each looked up value is kept until the cache is invalidated with ``invalidateCache()``, or until the property is modified. If `false`, only the values fetched with ``prefetch(_:)`` are kept.
+     */
+    public var cachesValues: Bool = false
+
+    /// The fetched resource values for their keys.
+    private var snapshot: [URLResourceKey: URLResourceValues] = [:]
+    private let lock = NSLock()
+
     /**
      Creates an object for accessing and modifying properties of the resource at the specified url.
-     - Parameters url: The url to the resource.
+     - Parameters:
+        - url: The url to the resource.
+        - cachesValues: A Boolean value indicating whether the values of the properties are cached.
      - Returns: `URLResources` for the specified resource.
      */
-    public init(url: URL) {
+    public init(url: URL, cachesValues: Bool = false) {
         self.url = url
+        self.cachesValues = cachesValues
+    }
+
+    /**
+     Fetches the values of the specified properties in one batch.
+
+     The values are kept until the cache is invalidated with ``invalidateCache()``, and the properties return them without an additional lookup.
+
+     - Parameter keyPaths: The key paths to the properties of `URLResourceValues` to fetch.
+     - Throws: If the values couldn't be fetched.
+     */
+    public func prefetch(_ keyPaths: [PartialKeyPath<URLResourceValues>]) throws {
+        let resourceKeys = Set(keyPaths.compactMap { $0.resourceKey })
+        guard !resourceKeys.isEmpty else { return }
+        let values = try url.resourceValues(forKeys: resourceKeys)
+        store(values, for: resourceKeys)
+    }
+
+    /**
+     Fetches the values of the specified properties in one batch.
+
+     The values are kept until the cache is invalidated with ``invalidateCache()``, and the properties return them without an additional lookup.
+
+     - Parameter keyPaths: The key paths to the properties of `URLResourceValues` to fetch.
+     - Throws: If the values couldn't be fetched.
+     */
+    public func prefetch(_ keyPaths: PartialKeyPath<URLResourceValues>...) throws {
+        try prefetch(keyPaths)
+    }
+
+    /// Removes all cached values, so that the properties are looked up again.
+    public func invalidateCache() {
+        lock.lock()
+        snapshot.removeAll()
+        url.removeAllCachedResourceValues()
+        lock.unlock()
+    }
+
+    /// Removes the cached values of the specified properties, so that they are looked up again.
+    public func invalidateCache(for keyPaths: [PartialKeyPath<URLResourceValues>]) {
+        lock.lock()
+        for resourceKey in keyPaths.compactMap({ $0.resourceKey }) {
+            snapshot[resourceKey] = nil
+            url.removeCachedResourceValue(forKey: resourceKey)
+        }
+        lock.unlock()
+    }
+
+    private func store(_ values: URLResourceValues, for resourceKeys: Set<URLResourceKey>) {
+        lock.lock()
+        for resourceKey in resourceKeys {
+            snapshot[resourceKey] = values
+        }
+        lock.unlock()
+    }
+
+    private func cachedValues(for resourceKey: URLResourceKey) -> URLResourceValues? {
+        lock.lock()
+        defer { lock.unlock() }
+        return snapshot[resourceKey]
     }
 
     internal func value<V>(for keyPath: KeyPath<URLResourceValues, V?>) throws -> V? {
         guard let resourceKey = keyPath.resourceKey else { return nil }
-        return try url.resourceValues(for: resourceKey)[keyPath: keyPath]
+        if let values = cachedValues(for: resourceKey) {
+            return values[keyPath: keyPath]
+        }
+        let values = try url.resourceValues(for: resourceKey)
+        if cachesValues {
+            store(values, for: [resourceKey])
+        }
+        return values[keyPath: keyPath]
     }
 
     internal func setValue<V>(_ newValue: V?, for keyPath: WritableKeyPath<URLResourceValues, V?>) throws {
         var urlResouceValues = URLResourceValues()
         urlResouceValues[keyPath: keyPath] = newValue
         try url.setResourceValues(urlResouceValues)
+        invalidateCache(for: [keyPath])
     }
 
     /// Name of the resource in the file system.
@@ -9,10 +9,62 @@ import CryptoKit
 import Foundation
 
 public extension HashFunction {
+    /**
+     Computes the digest of the UTF-8 representation of the specified string.
+
+     The digest is the same as the one of ``Swift/String/hash(_:)`` and of hashing `Data(string.utf8)`.
+
+     The digest is never `nil`. The return type stays optional so that existing code that unwraps it keeps compiling; use ``hash(utf8:)`` for a non-optional digest.
+
+     - Parameter string: The string to hash.
+     */
     static func hash(string: String) -> Digest? {
-        if let data = string.data(using: .utf16) {
-            return hash(data: data)
+        hash(utf8: string)
+    }
+
+    /**
+     Computes the digest of the UTF-8 representation of the specified string.
+
+     The UTF-8 bytes of native strings are hashed directly without copying them.
+
+     - Parameter string: The string to hash.
+     */
+    static func hash<S: StringProtocol>(utf8 string: S) -> Digest {
+        var hashFunction = Self()
+        if string.utf8.withContiguousStorageIfAvailable({ hashFunction.update(bufferPointer: UnsafeRawBufferPointer($0)) }) == nil {
+            hashFunction.update(data: Data(string.utf8))
+        }
+        return hashFunction.finalize()
+    }
+
+    /**
+     Computes the digest of the contents of the specified file.
+
+     The file is read in chunks, so that only one chunk is kept in memory at a time.
+
+     - Parameters:
+        - url: The URL of the file.
+        - chunkSize: The size of the chunks that are read.
+     - Throws: Throws if the file couldn't be read.
+     */
+    static func hash(contentsOf url: URL, chunkSize: DataSize = .megabytes(1)) throws -> Digest {
+        guard let stream = InputStream(url: url) else {
+            throw CocoaError(.fileReadNoSuchFile, userInfo: [NSURLErrorKey: url])
+        }
+        stream.open()
+        defer { stream.close() }
+        var hashFunction = Self()
+        let bufferSize = Swift.max(1, chunkSize.bytes)
+        let buffer = UnsafeMutablePointer<UInt8>.allocate(capacity: bufferSize)
+        defer { buffer.deallocate() }
+        while true {
+            let count = stream.read(buffer, maxLength: bufferSize)
+            if count < 0 {
+                throw stream.streamError ?? CocoaError(.fileReadUnknown, userInfo: [NSURLErrorKey: url])
+            }
+            guard count > 0 else { break }
+            hashFunction.update(bufferPointer: UnsafeRawBufferPointer(start: buffer, count: count))
         }
-        return nil
+        return hashFunction.finalize()
     }
 }
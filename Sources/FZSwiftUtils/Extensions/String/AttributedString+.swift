@@ -111,8 +111,11 @@ public extension Collection where Element == AttributedString {
      */
     func joined(separator: AttributedString) -> AttributedString {
         guard let firstElement = first else { return AttributedString("") }
+        let hasSeparator = !separator.characters.isEmpty
         return dropFirst().reduce(into: firstElement) { result, element in
-            result.append(separator)
+            if hasSeparator {
+                result.append(separator)
+            }
             result.append(element)
         }
     }
@@ -123,10 +126,6 @@ public extension Collection where Element == AttributedString {
      - Returns: A single, concatenated attributed string.
      */
     func joined(separator: String = "") -> AttributedString {
-        guard let firstElement = first else { return AttributedString("") }
-        return dropFirst().reduce(into: firstElement) { result, element in
-            result.append(AttributedString(separator))
-            result.append(element)
-        }
+        joined(separator: AttributedString(separator))
     }
 }
@@ -126,11 +126,9 @@ public extension Array where Element: NSAttributedString {
      - Returns: A single, concatenated attributed string.
      */
     func joined(separator: NSAttributedString) -> NSAttributedString {
-        guard let firstElement = first else { return NSMutableAttributedString(string: "") }
-        return dropFirst().reduce(into: NSMutableAttributedString(attributedString: firstElement)) { result, element in
-            result.append(separator)
-            result.append(element)
-        }
+        var builder = AttributedStringBuilder()
+        builder.append(contentsOf: self, separator: separator.length > 0 ? separator : nil)
+        return builder.build()
     }
 
     /**
@@ -139,11 +137,6 @@ public extension Array where Element: NSAttributedString {
      - Returns: A single, concatenated attributed string.
      */
     func joined(separator: String = "") -> NSAttributedString {
-        guard let firstElement = first else { return NSMutableAttributedString(string: "") }
-        let attributedStringSeparator = NSAttributedString(string: separator)
-        return dropFirst().reduce(into: NSMutableAttributedString(attributedString: firstElement)) { result, element in
-            result.append(attributedStringSeparator)
-            result.append(element)
-        }
+        joined(separator: NSAttributedString(string: separator))
     }
 }
@@ -0,0 +1,40 @@
+//
+//  NSRegularExpression+.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+public extension NSRegularExpression {
+    /**
+     Returns a compiled regular expression for the specified pattern and options.
+
+     Compiled regular expressions are kept in a thread-safe cache of the least recently used expressions, so that using the same pattern repeatedly only compiles it once. Regular expressions are immutable and can be used from multiple threads.
+
+     - Parameters:
+        - pattern: The regular expression pattern.
+        - options: The matching options.
+     - Throws: Throws if the pattern isn't a valid regular expression.
+     */
+    static func cached(pattern: String, options: Options = []) throws -> NSRegularExpression {
+        let key = CacheKey(pattern: pattern, options: options.rawValue)
+        if let regularExpression = cache.value(forKey: key) {
+            return regularExpression
+        }
+        let regularExpression = try NSRegularExpression(pattern: pattern, options: options)
+        cache.setValue(regularExpression, forKey: key)
+        return regularExpression
+    }
+
+    /// The maximum number of compiled regular expressions that are cached by ``cached(pattern:options:)``.
+    static let cacheCountLimit = 256
+
+    internal struct CacheKey: Hashable {
+        let pattern: String
+        let options: UInt
+    }
+
+    internal static let cache = MemoryCache<CacheKey, NSRegularExpression>(countLimit: cacheCountLimit)
+}
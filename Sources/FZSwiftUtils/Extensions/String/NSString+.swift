@@ -65,8 +65,18 @@ extension NSString {
     ///   - options: A mask specifying search options.
     ///   - searchRange: The range with in the receiver for which to search for aString.
     /// - Returns: An array of NSRange in the receiver of `searchString` within `searchRange`.
+    ///
+    /// Literal searches use ``StringSearcher`` and scan the string once.
     func ranges(of searchString: String, options: NSString.CompareOptions = .literal, range searchRange: NSRange? = nil) -> [NSRange] {
         let searchRange = searchRange ?? range
+        if options == .literal {
+            let string = self as String
+            if let range = Range(searchRange, in: string) {
+                return StringSearcher(searchString).matches(in: string[range]).nsRanges.map {
+                    NSRange(location: $0.location + searchRange.location, length: $0.length)
+                }
+            }
+        }
         var ranges: [NSRange] = []
 
         var location = searchRange.location
@@ -165,6 +175,8 @@ extension NSString {
     /// Counting in this way is significantly faster than other ways such as `enumerateSubstrings(in:options:.byLines)`,
     /// `components(separatedBy: .newlines)`, or even just counting `\n` in `.utf16`. (2020-02, Swift 5.1)
     ///
+    /// For repeated queries on the same string use ``LineIndex``, which answers them in `O(log n)`.
+    ///
     /// - Parameter location: NSRange-based character index.
     /// - Returns: The number of lines (1-based).
     func lineNumber(at location: Int) -> Int {
@@ -17,13 +17,11 @@ public extension String {
         - replacement: The replacement string.
 
      - Returns: A new string with occurrences of target strings replaced by the replacement string.
+     
+     The string is scanned once. Where target strings overlap, the occurrence that starts first and, of those, the longest is replaced. To replace the same targets in many strings, create a ``StringReplacer`` once and reuse it.
      */
     func replacingOccurrences<Target, Replacement>(of strings: [Target], with replacement: Replacement) -> String where Target: StringProtocol, Replacement: StringProtocol {
-        var newString = self
-        for string in strings {
-            newString = newString.replacingOccurrences(of: string, with: replacement)
-        }
-        return newString
+        StringReplacer(replacing: strings, with: replacement).replacingOccurrences(in: self)
     }
     
     /**
@@ -33,13 +31,11 @@ public extension String {
         - values: A dictionary mapping target strings to their replacement strings.
 
      - Returns: A new string with occurrences of target strings replaced by the corresponding replacement strings.
+     
+     The string is scanned once and replaced text isn't matched again, so the result doesn't depend on the order of the dictionary. Where target strings overlap, the occurrence that starts first and, of those, the longest is replaced. To replace the same targets in many strings, create a ``StringReplacer`` once and reuse it.
      */
     func replacingOccurrences<Target, Replacement>(_ values: [Target : Replacement]) -> String where Target: StringProtocol, Replacement: StringProtocol {
-        var string = self
-        for value in values {
-            string = string.replacingOccurrences(of: value.key, with: value.value)
-        }
-        return string
+        StringReplacer(values).replacingOccurrences(in: self)
     }
         
     /**
@@ -48,8 +44,10 @@ public extension String {
      - Returns: A new string with emoji numbers replaced by their corresponding decimal representations.
      */
     func replaceEmojiNumbers() -> String {
-        return self.replacingOccurrences(["0️⃣": "0", "1️⃣": "1", "2️⃣":"2", "3️⃣":"3", "4️⃣":"4", "5️⃣":"5", "6️⃣":"6", "7️⃣":"7", "8️⃣": "8", "9️⃣":"9", "🔟": "10"])
+        Self.emojiNumberReplacer.replacingOccurrences(in: self)
     }
+    
+    private static let emojiNumberReplacer = StringReplacer(["0️⃣": "0", "1️⃣": "1", "2️⃣":"2", "3️⃣":"3", "4️⃣":"4", "5️⃣":"5", "6️⃣":"6", "7️⃣":"7", "8️⃣": "8", "9️⃣":"9", "🔟": "10"])
 
 }
 
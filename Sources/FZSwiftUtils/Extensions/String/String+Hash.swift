@@ -20,17 +20,33 @@ public extension String {
     /**
      Computes the hash value of the string using the specified hash algorithm.
      
+     The UTF-8 representation of the string is hashed.
+     
      - Parameter option: The hash algorithm option to use.
-     - Returns: The computed hash value as a string.
+     - Returns: The computed hash value as a lowercase hexadecimal string.
      */
     func hash(_ option: HashOption) -> String {
         switch option {
         case .MD5:
-            let computed = Insecure.MD5.hash(data: data(using: .utf8)!)
-             return computed.map { String(format: "%02hhx", $0) }.joined()
+            return Insecure.MD5.hash(utf8: self).hexString
         case .SHA1:
-            let computed = Insecure.SHA1.hash(data: data(using: .utf8)!)
-            return computed.map { String(format: "%02hhx", $0) }.joined()
+            return Insecure.SHA1.hash(utf8: self).hexString
         }
     }
+
+    /**
+     Computes the hash value of the string using the specified hash function.
+
+     The UTF-8 representation of the string is hashed.
+
+     ```swift
+     let hash = string.hash(SHA256.self)
+     ```
+
+     - Parameter function: The hash function to use, like `SHA256` or `Insecure.MD5`.
+     - Returns: The computed hash value as a lowercase hexadecimal string.
+     */
+    func hash<Function: HashFunction>(_ function: Function.Type) -> String {
+        Function.hash(utf8: self).hexString
+    }
 }
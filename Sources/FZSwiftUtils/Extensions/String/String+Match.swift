@@ -27,6 +27,118 @@ internal extension StringMatch {
     }
 }
 
+public extension String {
+    /// A lazy sequence of the matches of a regular expression in a string.
+    struct MatchSequence: Sequence {
+        /// The regular expression.
+        public let regularExpression: NSRegularExpression
+        /// The searched string.
+        public let string: String
+        let utf16String: NSString
+
+        init(_ regularExpression: NSRegularExpression, string: String) {
+            self.regularExpression = regularExpression
+            self.string = string
+            // A UTF-16 copy lets each search access the string without converting it again.
+            let utf16 = Array(string.utf16)
+            utf16String = utf16.withUnsafeBufferPointer { buffer in
+                guard let baseAddress = buffer.baseAddress else { return NSString() }
+                return NSString(characters: baseAddress, length: buffer.count)
+            }
+        }
+
+        public func makeIterator() -> Iterator {
+            Iterator(sequence: self)
+        }
+
+        /// An iterator that searches the next match of a regular expression when it's requested.
+        public struct Iterator: IteratorProtocol {
+            let sequence: MatchSequence
+            var location = 0
+
+            init(sequence: MatchSequence) {
+                self.sequence = sequence
+            }
+
+            public mutating func next() -> Match? {
+                let length = sequence.utf16String.length
+                guard location <= length else { return nil }
+                let range = NSRange(location: location, length: length - location)
+                guard let result = sequence.regularExpression.firstMatch(in: sequence.utf16String as String, options: [.withTransparentBounds, .withoutAnchoringBounds], range: range) else {
+                    location = length + 1
+                    return nil
+                }
+                if result.range.length > 0 {
+                    location = result.range.upperBound
+                } else if result.range.location < length, UTF16.isLeadSurrogate(sequence.utf16String.character(at: result.range.location)) {
+                    location = result.range.location + 2
+                } else {
+                    location = result.range.location + 1
+                }
+                return Match(result: result, source: sequence.string)
+            }
+        }
+
+        /// A match of a regular expression. The range of the match is converted to string indexes only when it's accessed.
+        public struct Match {
+            /// The result of the regular expression.
+            public let result: NSTextCheckingResult
+            /// The searched string.
+            public let source: String
+
+            /// The UTF-16 range of the match.
+            public var nsRange: NSRange {
+                result.range
+            }
+
+            /// The range of the match.
+            public var range: Range<String.Index> {
+                Range(result.range, in: source)!
+            }
+
+            /// The matched string.
+            public var string: Substring {
+                source[range]
+            }
+
+            /**
+             Returns the range of the specified capture group.
+
+             - Parameter group: The index of the capture group. `0` returns the range of the whole match.
+             - Returns: The range, or `nil` if the capture group didn't participate in the match.
+             */
+            public func range(at group: Int) -> Range<String.Index>? {
+                Range(result.range(at: group), in: source)
+            }
+
+            /**
+             Returns the range of the capture group with the specified name.
+
+             - Parameter name: The name of the capture group.
+             - Returns: The range, or `nil` if the capture group didn't participate in the match.
+             */
+            public func range(withName name: String) -> Range<String.Index>? {
+                Range(result.range(withName: name), in: source)
+            }
+
+            /**
+             Returns the string of the specified capture group.
+
+             - Parameter group: The index of the capture group. `0` returns the whole match.
+             - Returns: The string, or `nil` if the capture group didn't participate in the match.
+             */
+            public func string(at group: Int) -> Substring? {
+                range(at: group).map { source[$0] }
+            }
+
+            /// The match as `StringMatch`.
+            public var stringMatch: StringMatch {
+                StringMatch(result, source: source)
+            }
+        }
+    }
+}
+
 public enum StringMatchOption {
     case lines
     case composedCharacterSequences
@@ -51,7 +163,7 @@ public extension String {
      - Returns: An array of words.
      */
     var words: [String] {
-        self.matches(for: .words).compactMap({$0.string})
+        lazyWords.map(String.init)
     }
 
     /**
@@ -60,7 +172,7 @@ public extension String {
      - Returns: An array of lines.
      */
     var lines: [String] {
-        self.matches(for: .lines).compactMap({$0.string})
+        lazyLines.map(String.init)
     }
 
     /**
@@ -69,7 +181,7 @@ public extension String {
      - Returns: An array of sentences.
      */
     var sentences: [String] {
-        self.matches(for: .sentences).compactMap({$0.string})
+        lazySentences.map(String.init)
     }
         
     /**
@@ -79,14 +191,40 @@ public extension String {
      - Returns: An array of `StringMatch` objects representing the matches found.
      */
     func matches(regex: String) -> [StringMatch] {
-        let string = self
-        let regex = try? NSRegularExpression(pattern: regex, options: [])
-        return regex?.matches(in: string, range: NSMakeRange(0, string.utf16.count)).compactMap { StringMatch($0, source: string) } ?? []
+        guard let regex = try? NSRegularExpression.cached(pattern: regex) else { return [] }
+        return regex.matches(in: self, range: NSRange(location: 0, length: utf16.count)).map { StringMatch($0, source: self) }
+    }
+    
+    /**
+     Returns a lazy sequence of the matches of the specified regular expression pattern.
+     
+     The compiled regular expression is cached. The matches are found one at a time while iterating the sequence.
+     
+     - Parameters:
+        - pattern: The regular expression pattern to search for.
+        - options: The regular expression options.
+     - Throws: Throws if the pattern isn't a valid regular expression.
+     */
+    func regexMatches(_ pattern: String, options: NSRegularExpression.Options = []) throws -> MatchSequence {
+        MatchSequence(try NSRegularExpression.cached(pattern: pattern, options: options), string: self)
+    }
+    
+    /**
+     Returns a lazy sequence of the matches of the specified regular expression.
+     
+     - Parameter regularExpression: The regular expression to search for.
+     */
+    func matches(of regularExpression: NSRegularExpression) -> MatchSequence {
+        MatchSequence(regularExpression, string: self)
     }
     
     /**
      Finds all matches of substrings between the two specified strings.
      
+     The strings are matched literally. Like the regular expression `from(.*?)to`, a match ends at the first occurrence of the ending string, and the text between the strings doesn't span multiple lines. The ending string itself can contain a newline.
+
+     Empty strings behave like in the regular expression: If `fromString` is empty, a match starts where the previous match ended or at the start of the line that contains the ending string. If `toString` is empty, a match ends right after the starting string.
+     
      - Parameters:
      - fromString: The starting string to search for.
      - toString: The ending string to search for.
@@ -95,17 +233,39 @@ public extension String {
      - Returns: An array of `StringMatch` objects representing the matches found.
      */
     func matches(between fromString: String, and toString: String, includingFromTo: Bool = false) -> [StringMatch] {
-        let pattern = fromString + "(.*?)" + toString
-        var matches = self.matches(regex: pattern)
-        if includingFromTo == false {
-            matches = matches.compactMap({ match in
-                let lowerBound = self.index(match.range.lowerBound, offsetBy: fromString.count)
-                let upperBound = self.index(match.range.upperBound, offsetBy: -toString.count)
-                let range = lowerBound..<upperBound
-                let score = self.distance(from: range.lowerBound, to: range.upperBound)
-                let string = String(match.string.dropFirst(fromString.count).dropLast(toString.count))
-                return StringMatch(string: string, range: range, score: score)
-            })
+        var matches: [StringMatch] = []
+        var searchStart = startIndex
+        while true {
+            let fromRange: Range<Index>? = fromString.isEmpty ? searchStart..<searchStart : range(of: fromString, options: .literal, range: searchStart..<endIndex)
+            guard let fromRange = fromRange else { break }
+            let lineEnd = self[fromRange.upperBound...].firstIndex(where: { $0.isNewline }) ?? endIndex
+            // The ending string has to start at the latest at the end of the line, but it can contain the newline.
+            let searchEnd = index(lineEnd, offsetBy: toString.count + 1, limitedBy: endIndex) ?? endIndex
+            var toRange: Range<Index>? = toString.isEmpty ? fromRange.upperBound..<fromRange.upperBound : range(of: toString, options: .literal, range: fromRange.upperBound..<searchEnd)
+            if let range = toRange, range.lowerBound > lineEnd {
+                toRange = nil
+            }
+            guard let toRange = toRange else {
+                if !fromString.isEmpty {
+                    searchStart = index(after: fromRange.lowerBound)
+                } else if lineEnd < endIndex {
+                    // No match can start on this line anymore.
+                    searchStart = index(after: lineEnd)
+                } else {
+                    break
+                }
+                continue
+            }
+            let range = includingFromTo ? fromRange.lowerBound..<toRange.upperBound : fromRange.upperBound..<toRange.lowerBound
+            matches.append(StringMatch(string: String(self[range]), range: range, score: distance(from: range.lowerBound, to: range.upperBound)))
+            if toRange.upperBound > fromRange.lowerBound {
+                searchStart = toRange.upperBound
+            } else if toRange.upperBound < endIndex {
+                // Like a regular expression, the search continues after an empty match.
+                searchStart = index(after: toRange.upperBound)
+            } else {
+                break
+            }
         }
         return matches
     }
@@ -25,8 +25,24 @@ public extension String {
      - Returns: A randomly generated string based on the specified randomization types and length.
      */
     static func random(using types: [RandomizationType] = [.letters, .lettersUppercase], length: Int = 8) -> String {
-        let letters = types.map(\.rawValue).reduce("", +)
-        return String((0 ..< length).map { _ in letters.randomElement()! })
+        var generator = SystemRandomNumberGenerator()
+        return random(using: types, length: length, generator: &generator)
+    }
+
+    /**
+     Generates a random string using the specified random number generator.
+
+     Use a ``SeededRandomNumberGenerator`` to generate the same strings for the same seed.
+
+     - Parameters:
+        - types: An array of `RandomizationType` values specifying the types of characters to be used.
+        - length: The length of the generated random string.
+        - generator: The random number generator to use.
+
+     - Returns: A randomly generated string based on the specified randomization types and length.
+     */
+    static func random<G: RandomNumberGenerator>(using types: [RandomizationType] = [.letters, .lettersUppercase], length: Int = 8, generator: inout G) -> String {
+        RandomCharacterPool(types).string(length: length, generator: &generator)
     }
 
     /**
@@ -41,6 +57,40 @@ public extension String {
     static func random(using types: [RandomizationType] = [.letters, .lettersUppercase], length: Range<Int>) -> String {
         return random(using: Array(types), length: Int.random(in: length))
     }
+
+    /**
+     Generates an array of random strings.
+
+     The characters of all strings are generated at once, which is much faster than generating each string individually.
+
+     - Parameters:
+        - count: The number of strings to generate.
+        - types: An array of `RandomizationType` values specifying the types of characters to be used.
+        - length: The length of each generated random string.
+
+     - Returns: An array of randomly generated strings based on the specified randomization types and length.
+     */
+    static func random(count: Int, using types: [RandomizationType] = [.letters, .lettersUppercase], length: Int = 8) -> [String] {
+        var generator = SystemRandomNumberGenerator()
+        return random(count: count, using: types, length: length, generator: &generator)
+    }
+
+    /**
+     Generates an array of random strings using the specified random number generator.
+
+     The characters of all strings are generated at once, which is much faster than generating each string individually. Use a ``SeededRandomNumberGenerator`` to generate the same strings for the same seed.
+
+     - Parameters:
+        - count: The number of strings to generate.
+        - types: An array of `RandomizationType` values specifying the types of characters to be used.
+        - length: The length of each generated random string.
+        - generator: The random number generator to use.
+
+     - Returns: An array of randomly generated strings based on the specified randomization types and length.
+     */
+    static func random<G: RandomNumberGenerator>(count: Int, using types: [RandomizationType] = [.letters, .lettersUppercase], length: Int = 8, generator: inout G) -> [String] {
+        RandomCharacterPool(types).strings(count: count, length: length, generator: &generator)
+    }
 }
 
 public extension String {
@@ -54,12 +104,103 @@ public extension String {
       */
     static func loremIpsum(ofLength length: Int = 445) -> String {
         guard length > 0 else { return "" }
-        let loremIpsum = """
-        Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat. Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur. Excepteur sint occaecat cupidatat non proident, sunt in culpa qui officia deserunt mollit anim id est laborum.
-        """
-        if loremIpsum.count > length {
-            return String(loremIpsum[loremIpsum.startIndex ..< loremIpsum.index(loremIpsum.startIndex, offsetBy: length)])
+        guard length < loremIpsumText.utf8.count else { return loremIpsumText }
+        // The text is ASCII, so its UTF-8 prefix has the same number of characters.
+        return String(decoding: loremIpsumText.utf8.prefix(length), as: UTF8.self)
+    }
+
+    internal static let loremIpsumText = """
+    Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat. Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur. Excepteur sint occaecat cupidatat non proident, sunt in culpa qui officia deserunt mollit anim id est laborum.
+    """
+}
+
+/**
+ The characters of randomization types.
+
+ Random characters are picked by filling a buffer with random bytes, eight bytes per call of the random number generator. Bytes that would favor some characters over others are rejected, so that every character of the pool is equally likely.
+ */
+struct RandomCharacterPool {
+    let scalars: [Unicode.Scalar]
+    /// The UTF-8 code units of the characters, if all characters are ASCII.
+    let asciiBytes: [UInt8]?
+
+    init(_ types: [String.RandomizationType]) {
+        scalars = types.flatMap { $0.rawValue.unicodeScalars }
+        asciiBytes = scalars.allSatisfy(\.isASCII) ? scalars.map { UInt8($0.value) } : nil
+    }
+
+    func string<G: RandomNumberGenerator>(length: Int, generator: inout G) -> String {
+        guard length > 0, !scalars.isEmpty else { return "" }
+        guard let asciiBytes = asciiBytes else {
+            return String(String.UnicodeScalarView(indices(count: length, generator: &generator).map { scalars[$0] }))
+        }
+        if #available(macOS 11.0, iOS 14.0, tvOS 14.0, watchOS 7.0, *) {
+            return String(unsafeUninitializedCapacity: length) {
+                fill($0, from: asciiBytes, generator: &generator)
+                return length
+            }
+        }
+        let bytes = [UInt8](unsafeUninitializedCapacity: length) { buffer, initializedCount in
+            fill(buffer, from: asciiBytes, generator: &generator)
+            initializedCount = length
+        }
+        return String(decoding: bytes, as: UTF8.self)
+    }
+
+    func strings<G: RandomNumberGenerator>(count: Int, length: Int, generator: inout G) -> [String] {
+        guard count > 0 else { return [] }
+        guard length > 0, !scalars.isEmpty else { return Array(repeating: "", count: count) }
+        guard let asciiBytes = asciiBytes else {
+            return (0 ..< count).map { _ in string(length: length, generator: &generator) }
+        }
+        let bytes = [UInt8](unsafeUninitializedCapacity: count * length) { buffer, initializedCount in
+            fill(buffer, from: asciiBytes, generator: &generator)
+            initializedCount = buffer.count
+        }
+        return bytes.withUnsafeBufferPointer { bytes in
+            stride(from: 0, to: bytes.count, by: length).map {
+                String(decoding: UnsafeBufferPointer(rebasing: bytes[$0 ..< $0 + length]), as: UTF8.self)
+            }
+        }
+    }
+
+    /// Fills the buffer with random bytes of the pool.
+    func fill<G: RandomNumberGenerator>(_ buffer: UnsafeMutableBufferPointer<UInt8>, from pool: [UInt8], generator: inout G) {
+        forEachIndex(count: buffer.count, generator: &generator) { buffer[$0] = pool[$1] }
+    }
+
+    /// Returns the specified number of random indices of the pool.
+    func indices<G: RandomNumberGenerator>(count: Int, generator: inout G) -> [Int] {
+        var indices = [Int](repeating: 0, count: count)
+        forEachIndex(count: count, generator: &generator) { indices[$0] = $1 }
+        return indices
+    }
+
+    /**
+     Calls the handler with the offsets up to the specified count and a uniformly distributed random index of the pool for each offset.
+
+     Each random byte is used if it's below the largest multiple of the pool size, as the remainder of the division by the pool size is otherwise biased.
+     */
+    func forEachIndex<G: RandomNumberGenerator>(count: Int, generator: inout G, _ handler: (_ offset: Int, _ index: Int) -> Void) {
+        let poolSize = scalars.count
+        guard poolSize <= 256 else {
+            for offset in 0 ..< count {
+                handler(offset, Int.random(in: 0 ..< poolSize, using: &generator))
+            }
+            return
+        }
+        let limit = 256 - 256 % poolSize
+        var offset = 0
+        while offset < count {
+            var random = generator.next()
+            for _ in 0 ..< 8 {
+                let byte = Int(random & 0xFF)
+                random &>>= 8
+                guard byte < limit else { continue }
+                handler(offset, byte % poolSize)
+                offset += 1
+                if offset == count { return }
+            }
         }
-        return loremIpsum
     }
 }
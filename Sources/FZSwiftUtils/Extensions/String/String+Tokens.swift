@@ -0,0 +1,210 @@
+//
+//  String+Tokens.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+public extension String {
+    /**
+     A lazy sequence of the words in the string.
+
+     The words are the same as in ``words``, but they are found while iterating the sequence and returned as substrings of the string.
+     */
+    var lazyWords: TokenSequence {
+        TokenSequence(self, unit: .words)
+    }
+
+    /**
+     A lazy sequence of the whitespace-separated words in the string.
+
+     Unlike ``lazyWords``, punctuation stays part of the words, e.g. `"Hello, world!"` returns `"Hello,"` and `"world!"`.
+     */
+    var lazyWhitespaceSeparatedWords: TokenSequence {
+        TokenSequence(self, unit: .whitespaceSeparatedWords)
+    }
+
+    /**
+     A lazy sequence of the lines in the string.
+
+     The lines don't include their line terminators. Lines are separated by `LF`, `CR`, `CRLF`, `NEL`, and the Unicode line and paragraph separators.
+     */
+    var lazyLines: TokenSequence {
+        TokenSequence(self, unit: .lines)
+    }
+
+    /**
+     A lazy sequence of the sentences in the string.
+
+     The sentences are the same as in ``sentences``, but they are found while iterating the sequence and returned as substrings of the string.
+     */
+    var lazySentences: TokenSequence {
+        TokenSequence(self, unit: .sentences)
+    }
+
+    /// A lazy sequence of the tokens of a string.
+    struct TokenSequence: Sequence {
+        /// The unit of the tokens.
+        public enum Unit: Hashable, Sendable {
+            /// Words.
+            case words
+            /// Words separated by whitespace.
+            case whitespaceSeparatedWords
+            /// Lines.
+            case lines
+            /// Sentences.
+            case sentences
+        }
+
+        /// The tokenized string.
+        public let string: Substring
+
+        /// The unit of the tokens.
+        public let unit: Unit
+
+        /**
+         Creates a sequence of the tokens of the specified string.
+
+         - Parameters:
+            - string: The string to tokenize.
+            - unit: The unit of the tokens.
+         */
+        public init<S: StringProtocol>(_ string: S, unit: Unit) {
+            self.string = Substring(string)
+            self.unit = unit
+        }
+
+        public func makeIterator() -> Iterator {
+            Iterator(string: string, unit: unit)
+        }
+
+        /// An iterator over the tokens of a string.
+        public struct Iterator: IteratorProtocol {
+            let string: Substring
+            let unit: Unit
+            var position: String.Index
+            /// The ranges of the words or sentences found by the last enumeration.
+            var ranges: [Range<String.Index>] = []
+            var rangeIndex = 0
+
+            /// The number of words or sentences found by one enumeration.
+            static let batchSize = 256
+
+            init(string: Substring, unit: Unit) {
+                self.string = string
+                self.unit = unit
+                position = string.startIndex
+            }
+
+            public mutating func next() -> Substring? {
+                switch unit {
+                case .lines: return nextLine()
+                case .whitespaceSeparatedWords: return nextWhitespaceSeparatedWord()
+                case .words: return nextEnumerated(.byWords)
+                case .sentences: return nextEnumerated(.bySentences)
+                }
+            }
+
+            /// Finds the next line by scanning the UTF-8 bytes for line terminators.
+            mutating func nextLine() -> Substring? {
+                let utf8 = string.utf8
+                let end = utf8.endIndex
+                guard position < end else { return nil }
+                let start = position
+                var index = position
+                while index < end {
+                    let byte = utf8[index]
+                    var next = utf8.index(after: index)
+                    var isTerminator = false
+                    switch byte {
+                    case 0x0A:
+                        isTerminator = true
+                    case 0x0D:
+                        isTerminator = true
+                        if next < end, utf8[next] == 0x0A {
+                            next = utf8.index(after: next)
+                        }
+                    case 0xC2:
+                        // NEL (U+0085)
+                        if next < end, utf8[next] == 0x85 {
+                            isTerminator = true
+                            next = utf8.index(after: next)
+                        }
+                    case 0xE2:
+                        // Line separator (U+2028) and paragraph separator (U+2029)
+                        if next < end, utf8[next] == 0x80 {
+                            let last = utf8.index(after: next)
+                            if last < end, utf8[last] == 0xA8 || utf8[last] == 0xA9 {
+                                isTerminator = true
+                                next = utf8.index(after: last)
+                            }
+                        }
+                    default:
+                        break
+                    }
+                    if isTerminator {
+                        position = next
+                        return token(start ..< index)
+                    }
+                    index = next
+                }
+                position = end
+                return token(start ..< end)
+            }
+
+            /// Finds the next word by scanning the Unicode scalars for whitespace, ASCII characters are checked without looking up their Unicode properties.
+            mutating func nextWhitespaceSeparatedWord() -> Substring? {
+                let scalars = string.unicodeScalars
+                let end = scalars.endIndex
+                while position < end, Self.isWhitespace(scalars[position]) {
+                    position = scalars.index(after: position)
+                }
+                guard position < end else { return nil }
+                let start = position
+                while position < end, !Self.isWhitespace(scalars[position]) {
+                    position = scalars.index(after: position)
+                }
+                return token(start ..< position)
+            }
+
+            /// Returns the next word or sentence, enumerating them in batches.
+            mutating func nextEnumerated(_ options: NSString.EnumerationOptions) -> Substring? {
+                if rangeIndex == ranges.count {
+                    guard position < string.endIndex else { return nil }
+                    var ranges = self.ranges
+                    ranges.removeAll(keepingCapacity: true)
+                    var enumeratedEnd = string.endIndex
+                    // Enumerates the base string, as enumerating a substring bridges a copy of it.
+                    string.base.enumerateSubstrings(in: position ..< string.endIndex, options: options.union(.substringNotRequired)) { _, range, enclosingRange, stop in
+                        ranges.append(range)
+                        if ranges.count == Self.batchSize {
+                            enumeratedEnd = enclosingRange.upperBound
+                            stop = true
+                        }
+                    }
+                    self.ranges = ranges
+                    rangeIndex = 0
+                    position = enumeratedEnd
+                    guard !ranges.isEmpty else { return nil }
+                }
+                rangeIndex += 1
+                return string[ranges[rangeIndex - 1]]
+            }
+
+            /// Returns the substring of the range, which isn't rounded to character boundaries.
+            func token(_ range: Range<String.Index>) -> Substring {
+                Substring(string.unicodeScalars[range])
+            }
+
+            @inline(__always)
+            static func isWhitespace(_ scalar: Unicode.Scalar) -> Bool {
+                if scalar.isASCII {
+                    return scalar == " " || (scalar.value >= 0x09 && scalar.value <= 0x0D)
+                }
+                return scalar.properties.isWhitespace
+            }
+        }
+    }
+}
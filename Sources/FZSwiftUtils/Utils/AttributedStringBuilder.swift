@@ -0,0 +1,127 @@
+//
+//  AttributedStringBuilder.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ Builds an attributed string from many pieces.
+
+ Appending to a `NSMutableAttributedString` merges the attribute runs and may reallocate the storage for every piece. The builder instead collects the text of all pieces in a single string and their attributes as runs, and creates the attributed string in one pass with ``build()``.
+
+ ```swift
+ var builder = AttributedStringBuilder()
+ for entry in logEntries {
+     builder.append(entry.date, attributes: [.foregroundColor: NSUIColor.gray])
+     builder.append(" ")
+     builder.append(entry.message)
+     builder.append("\n")
+ }
+ let attributedString = builder.build()
+ ```
+ */
+public struct AttributedStringBuilder {
+    /// The text of the appended pieces.
+    var text = ""
+    /// The attributes of the text, with their ranges as UTF-16 offsets.
+    var runs: [(range: NSRange, attributes: [NSAttributedString.Key: Any])] = []
+
+    /// The length of the appended text, in UTF-16 code units.
+    public private(set) var length = 0
+
+    /// A Boolean value indicating whether no text has been appended.
+    public var isEmpty: Bool {
+        length == 0
+    }
+
+    /**
+     Creates a builder.
+
+     - Parameter minimumCapacity: The number of UTF-8 code units of text to reserve storage for.
+     */
+    public init(minimumCapacity: Int = 0) {
+        text.reserveCapacity(minimumCapacity)
+    }
+
+    /// Reserves storage for the specified number of UTF-8 code units of text.
+    public mutating func reserveCapacity(_ minimumCapacity: Int) {
+        text.reserveCapacity(minimumCapacity)
+    }
+
+    /**
+     Appends the string with the specified attributes.
+
+     - Parameters:
+        - string: The string to append.
+        - attributes: The attributes of the string.
+     */
+    public mutating func append<S: StringProtocol>(_ string: S, attributes: [NSAttributedString.Key: Any] = [:]) {
+        let stringLength = string.utf16.count
+        guard stringLength > 0 else { return }
+        if !attributes.isEmpty {
+            runs.append((NSRange(location: length, length: stringLength), attributes))
+        }
+        text.append(contentsOf: string)
+        length += stringLength
+    }
+
+    /// Appends the attributed string.
+    public mutating func append(_ attributedString: NSAttributedString) {
+        let stringLength = attributedString.length
+        guard stringLength > 0 else { return }
+        let offset = length
+        attributedString.enumerateAttributes(in: NSRange(location: 0, length: stringLength), options: []) { attributes, range, _ in
+            guard !attributes.isEmpty else { return }
+            runs.append((NSRange(location: offset + range.location, length: range.length), attributes))
+        }
+        text.append(attributedString.string)
+        length += stringLength
+    }
+
+    /// Appends the attributed strings, adding the specified separator between each of them.
+    public mutating func append<S: Sequence>(contentsOf attributedStrings: S, separator: NSAttributedString? = nil) where S.Element: NSAttributedString {
+        var isFirst = true
+        for attributedString in attributedStrings {
+            if !isFirst, let separator = separator {
+                append(separator)
+            }
+            append(attributedString)
+            isFirst = false
+        }
+    }
+
+    /// Returns the attributed string of the appended pieces.
+    public func build() -> NSAttributedString {
+        let attributedString = NSMutableAttributedString(string: text)
+        guard !runs.isEmpty else { return attributedString }
+        attributedString.beginEditing()
+        for run in runs {
+            attributedString.setAttributes(run.attributes, range: run.range)
+        }
+        attributedString.endEditing()
+        return attributedString
+    }
+
+    /// Removes all appended pieces.
+    public mutating func removeAll(keepingCapacity keepCapacity: Bool = false) {
+        text.removeAll(keepingCapacity: keepCapacity)
+        runs.removeAll(keepingCapacity: keepCapacity)
+        length = 0
+    }
+}
+
+@available(macOS 12, iOS 15, tvOS 15, watchOS 8, *)
+public extension AttributedStringBuilder {
+    /// Appends the attributed string.
+    mutating func append(_ attributedString: AttributedString) {
+        append(NSAttributedString(attributedString))
+    }
+
+    /// Returns the attributed string of the appended pieces.
+    func buildAttributedString() -> AttributedString {
+        AttributedString(build())
+    }
+}
@@ -0,0 +1,590 @@
+//
+//  DiskCache.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import CryptoKit
+import Foundation
+
+/**
+ A thread-safe persistent cache that stores data in a directory and evicts the least recently used data when the cache exceeds its size limit.
+
+ Each value is stored in a file named by the SHA-256 hash of its key. Changes are recorded in an append-only journal, so opening a cache only reads the journal instead of every file in the directory. Data is written to a temporary file that is synchronized to disk and then atomically replaces the previous file, so a crash never leaves a partially written value behind. Large values are memory-mapped when read.
+
+ ```swift
+ let cache = try DiskCache(name: "Thumbnails", sizeLimit: .gigabytes(1))
+ try cache.setData(thumbnailData, forKey: url.absoluteString)
+ let data = cache.data(forKey: url.absoluteString)
+ ```
+ */
+public final class DiskCache {
+    /// Disk cache errors.
+    public enum Errors: Error {
+        /// The journal of the cache is corrupted or has an unsupported version.
+        case invalidJournal
+    }
+
+    /// The directory of the cache.
+    public let directory: URL
+
+    /// The maximum total size of the data in the cache.
+    public var sizeLimit: DataSize {
+        didSet {
+            lock.lock()
+            trim()
+            lock.unlock()
+        }
+    }
+
+    /// The size from which data is memory-mapped instead of copied into memory when read.
+    public let mappingThreshold: DataSize
+
+    struct Entry {
+        var key: String
+        var size: Int
+        /// The value of `writeCount` when the data was written, or `0` if the entry was restored from the journal.
+        var version = 0
+        var previous: Int = -1
+        var next: Int = -1
+    }
+
+    let lock = NSLock()
+    var indexes: [String: Int] = [:]
+    var entries: [Entry] = []
+    var freeIndexes: [Int] = []
+    var head = -1
+    var tail = -1
+    var size = 0
+    /// The number of writes, used to tell whether the data of an entry was replaced.
+    var writeCount = 0
+
+    let journalURL: URL
+    let temporaryDirectory: URL
+    var journalHandle: FileHandle?
+    var journalBuffer = Data()
+    var journalRecordCount = 0
+    /// The length of the valid records of the restored journal.
+    var journalLength: Int?
+    /// The names of the temporary files that are being written.
+    var pendingTemporaryFiles: Set<String> = []
+
+    static let journalMagic: [UInt8] = [0x46, 0x5A, 0x44, 0x43, 0x01] // "FZDC", version 1
+    static let journalBufferSize = 16 * 1024
+
+    enum Operation: UInt8 {
+        case set = 1
+        case remove = 2
+        case access = 3
+    }
+
+    /**
+     Creates a disk cache in the specified directory.
+
+     If the directory contains a cache, its contents are restored from the journal.
+
+     - Parameters:
+        - directory: The directory of the cache. The directory is created if it doesn't exist.
+        - sizeLimit: The maximum total size of the data in the cache.
+        - mappingThreshold: The size from which data is memory-mapped instead of copied into memory when read. The default value is `64` kilobytes.
+     - Throws: Throws if the directory couldn't be created or if the journal couldn't be opened.
+     */
+    public init(directory: URL, sizeLimit: DataSize, mappingThreshold: DataSize = .kilobytes(64)) throws {
+        self.directory = directory
+        self.sizeLimit = sizeLimit
+        self.mappingThreshold = mappingThreshold
+        journalURL = directory.appendingPathComponent("journal")
+        temporaryDirectory = directory.appendingPathComponent("tmp", isDirectory: true)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        if FileManager.default.fileExists(at: journalURL) {
+            do {
+                try restoreJournal()
+            } catch {
+                // A corrupted journal can't be trusted, so the cache starts empty.
+                try removeAllFiles()
+            }
+        }
+        try FileManager.default.createDirectory(at: temporaryDirectory, withIntermediateDirectories: true)
+        try openJournal()
+        trim()
+    }
+
+    /**
+     Creates a disk cache with the specified name in the caches directory of the user.
+
+     - Parameters:
+        - name: The name of the cache.
+        - sizeLimit: The maximum total size of the data in the cache.
+     - Throws: Throws if the directory couldn't be created or if the journal couldn't be opened.
+     */
+    public convenience init(name: String, sizeLimit: DataSize) throws {
+        let cachesDirectory = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first ?? FileManager.default.temporaryDirectory
+        try self.init(directory: cachesDirectory.appendingPathComponent(name, isDirectory: true), sizeLimit: sizeLimit)
+    }
+
+    deinit {
+        flushJournal()
+        journalHandle?.closeFile()
+    }
+
+    /// Accesses the data associated with the specified key.
+    public subscript(key: String) -> Data? {
+        get { data(forKey: key) }
+        set {
+            if let newValue = newValue {
+                try? setData(newValue, forKey: key)
+            } else {
+                removeData(forKey: key)
+            }
+        }
+    }
+
+    /**
+     Returns the data associated with the specified key.
+
+     - Parameter key: The key.
+     - Returns: The data, or `nil` if the cache doesn't contain data for the key.
+     */
+    public func data(forKey key: String) -> Data? {
+        lock.lock()
+        guard let index = indexes[key] else {
+            lock.unlock()
+            return nil
+        }
+        let options: Data.ReadingOptions = entries[index].size >= mappingThreshold.bytes ? .alwaysMapped : []
+        let version = entries[index].version
+        lock.unlock()
+        let data = try? Data(contentsOf: fileURL(for: key), options: options)
+        lock.lock()
+        defer { lock.unlock() }
+        guard let index = indexes[key] else { return data }
+        guard let data = data else {
+            // The file was removed outside of the cache, unless the data was replaced while it was read.
+            if entries[index].version == version {
+                remove(index)
+                appendJournalRecord(.remove, key: key)
+            }
+            return nil
+        }
+        moveToFront(index)
+        appendJournalRecord(.access, key: key)
+        return data
+    }
+
+    /**
+     Stores the specified data for the key.
+
+     - Parameters:
+        - data: The data.
+        - key: The key.
+     - Throws: Throws if the data couldn't be written.
+     */
+    public func setData(_ data: Data, forKey key: String) throws {
+        let temporaryURL = temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        lock.lock()
+        pendingTemporaryFiles.insert(temporaryURL.lastPathComponent)
+        lock.unlock()
+        do {
+            try Self.writeSynchronized(data, to: temporaryURL)
+        } catch {
+            lock.lock()
+            pendingTemporaryFiles.remove(temporaryURL.lastPathComponent)
+            lock.unlock()
+            try? FileManager.default.removeItem(at: temporaryURL)
+            throw error
+        }
+        lock.lock()
+        defer { lock.unlock() }
+        pendingTemporaryFiles.remove(temporaryURL.lastPathComponent)
+        guard rename(temporaryURL.path, fileURL(for: key).path) == 0 else {
+            let error = NSError(domain: NSPOSIXErrorDomain, code: Int(errno))
+            try? FileManager.default.removeItem(at: temporaryURL)
+            throw error
+        }
+        writeCount += 1
+        if let index = indexes[key] {
+            size += data.count - entries[index].size
+            entries[index].size = data.count
+            entries[index].version = writeCount
+            moveToFront(index)
+        } else {
+            let index = makeEntry(Entry(key: key, size: data.count, version: writeCount))
+            indexes[key] = index
+            linkToFront(index)
+            size += data.count
+        }
+        appendJournalRecord(.set, key: key, size: data.count)
+        trim()
+        flushJournal()
+    }
+
+    /**
+     Removes the data for the specified key.
+
+     - Parameter key: The key.
+     */
+    public func removeData(forKey key: String) {
+        lock.lock()
+        defer { lock.unlock() }
+        guard let index = indexes[key] else { return }
+        removeFile(at: index)
+        flushJournal()
+    }
+
+    /**
+     Removes all data from the cache.
+
+     - Throws: Throws if the files couldn't be removed.
+     */
+    public func removeAll() throws {
+        lock.lock()
+        defer { lock.unlock() }
+        journalHandle?.closeFile()
+        journalHandle = nil
+        journalBuffer.removeAll()
+        try removeAllFiles()
+        try FileManager.default.createDirectory(at: temporaryDirectory, withIntermediateDirectories: true)
+        try openJournal()
+    }
+
+    /// Returns a Boolean value indicating whether the cache contains data for the specified key.
+    public func contains(_ key: String) -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return indexes[key] != nil
+    }
+
+    /// The number of values in the cache.
+    public var count: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return indexes.count
+    }
+
+    /// The total size of the data in the cache.
+    public var totalSize: DataSize {
+        lock.lock()
+        defer { lock.unlock() }
+        return DataSize(size)
+    }
+
+    /// The keys of the cache, ordered from the most to the least recently used.
+    public var keys: [String] {
+        lock.lock()
+        defer { lock.unlock() }
+        var keys: [String] = []
+        keys.reserveCapacity(indexes.count)
+        var index = head
+        while index >= 0 {
+            keys.append(entries[index].key)
+            index = entries[index].next
+        }
+        return keys
+    }
+
+    /**
+     Returns the url of the file that stores the data for the specified key.
+
+     - Parameter key: The key.
+     - Returns: The file url, or `nil` if the cache doesn't contain data for the key.
+     */
+    public func fileURL(forKey key: String) -> URL? {
+        contains(key) ? fileURL(for: key) : nil
+    }
+
+    /**
+     Rewrites the journal so that it only contains the current contents of the cache.
+
+     The journal is compacted automatically when it grows considerably larger than the cache.
+
+     - Throws: Throws if the journal couldn't be written.
+     */
+    public func compactJournal() throws {
+        lock.lock()
+        defer { lock.unlock() }
+        try compact()
+    }
+
+    /**
+     Writes the pending changes of the journal to disk.
+
+     Access records are buffered and only affect the eviction order. Changes of the cache content are written immediately.
+     */
+    public func synchronize() {
+        lock.lock()
+        defer { lock.unlock() }
+        flushJournal()
+    }
+
+    /**
+     Removes files in the cache directory that aren't referenced by the journal, like files of a write that was interrupted.
+
+     This method enumerates the complete directory. The directory is enumerated without locking the cache.
+     */
+    public func removeUnreferencedFiles() {
+        lock.lock()
+        var referenced = Set(indexes.keys.map { Self.fileName(for: $0) })
+        lock.unlock()
+        let excluded: Set<String> = [journalURL.lastPathComponent, temporaryDirectory.lastPathComponent]
+        let contents = (try? FileManager.default.contentsOfDirectory(atPath: directory.path)) ?? []
+        let candidates = contents.filter { !excluded.contains($0) && !referenced.contains($0) }
+        if !candidates.isEmpty {
+            // Files for keys that were stored while enumerating the directory are kept.
+            lock.lock()
+            referenced = Set(indexes.keys.map { Self.fileName(for: $0) })
+            for name in candidates where !referenced.contains(name) {
+                try? FileManager.default.removeItem(atPath: directory.appendingPathComponent(name).path)
+            }
+            lock.unlock()
+        }
+        let temporaryFiles = (try? FileManager.default.contentsOfDirectory(atPath: temporaryDirectory.path)) ?? []
+        guard !temporaryFiles.isEmpty else { return }
+        lock.lock()
+        for name in temporaryFiles where !pendingTemporaryFiles.contains(name) {
+            try? FileManager.default.removeItem(atPath: temporaryDirectory.appendingPathComponent(name).path)
+        }
+        lock.unlock()
+    }
+}
+
+extension DiskCache: @unchecked Sendable {}
+
+extension DiskCache {
+    func fileURL(for key: String) -> URL {
+        directory.appendingPathComponent(Self.fileName(for: key))
+    }
+
+    static func fileName(for key: String) -> String {
+        SHA256.hash(utf8: key).hexString
+    }
+
+    // MARK: LRU list
+
+    func makeEntry(_ entry: Entry) -> Int {
+        if let index = freeIndexes.popLast() {
+            entries[index] = entry
+            return index
+        }
+        entries.append(entry)
+        return entries.count - 1
+    }
+
+    func linkToFront(_ index: Int) {
+        entries[index].previous = -1
+        entries[index].next = head
+        if head >= 0 {
+            entries[head].previous = index
+        } else {
+            tail = index
+        }
+        head = index
+    }
+
+    func unlink(_ index: Int) {
+        let previous = entries[index].previous
+        let next = entries[index].next
+        if previous >= 0 {
+            entries[previous].next = next
+        } else {
+            head = next
+        }
+        if next >= 0 {
+            entries[next].previous = previous
+        } else {
+            tail = previous
+        }
+    }
+
+    func moveToFront(_ index: Int) {
+        guard head != index else { return }
+        unlink(index)
+        linkToFront(index)
+    }
+
+    func remove(_ index: Int) {
+        unlink(index)
+        size -= entries[index].size
+        indexes[entries[index].key] = nil
+        entries[index].key = ""
+        freeIndexes.append(index)
+    }
+
+    func removeFile(at index: Int) {
+        let key = entries[index].key
+        try? FileManager.default.removeItem(at: fileURL(for: key))
+        remove(index)
+        appendJournalRecord(.remove, key: key)
+    }
+
+    func trim() {
+        var didRemove = false
+        while size > sizeLimit.bytes, tail >= 0 {
+            removeFile(at: tail)
+            didRemove = true
+        }
+        if didRemove {
+            flushJournal()
+        }
+    }
+
+    func removeAllFiles() throws {
+        if let contents = try? FileManager.default.contentsOfDirectory(at: directory, includingPropertiesForKeys: nil) {
+            for url in contents {
+                try FileManager.default.removeItem(at: url)
+            }
+        }
+        indexes.removeAll()
+        entries.removeAll()
+        freeIndexes.removeAll()
+        head = -1
+        tail = -1
+        size = 0
+        journalRecordCount = 0
+        journalLength = nil
+    }
+
+    // MARK: Journal
+
+    func openJournal() throws {
+        if !FileManager.default.fileExists(at: journalURL) {
+            try Self.writeSynchronized(Data(Self.journalMagic), to: journalURL)
+        }
+        journalHandle = try FileHandle(forWritingTo: journalURL)
+        if let journalLength = journalLength {
+            // Removes a truncated last record, so that new records don't follow its partial bytes.
+            journalHandle?.truncateFile(atOffset: UInt64(journalLength))
+            self.journalLength = nil
+        }
+        journalHandle?.seekToEndOfFile()
+    }
+
+    func restoreJournal() throws {
+        let journal = try Data(contentsOf: journalURL, options: .alwaysMapped)
+        try journal.withUnsafeBytes { buffer in
+            let magic = Self.journalMagic
+            guard buffer.count >= magic.count, buffer.prefix(magic.count).elementsEqual(magic) else {
+                throw Errors.invalidJournal
+            }
+            var offset = magic.count
+            while offset < buffer.count {
+                // A truncated last record is the result of an interrupted write. It's ignored and removed when the journal is opened.
+                var recordEnd = offset
+                guard let rawOperation = read(UInt8.self, buffer, &recordEnd),
+                      let operation = Operation(rawValue: rawOperation) else { throw Errors.invalidJournal }
+                guard let keyLength = read(UInt32.self, buffer, &recordEnd), recordEnd + Int(keyLength) <= buffer.count else { break }
+                let key = String(decoding: UnsafeRawBufferPointer(rebasing: buffer[recordEnd ..< recordEnd + Int(keyLength)]), as: UTF8.self)
+                recordEnd += Int(keyLength)
+                var entrySize = 0
+                if operation == .set {
+                    guard let value = read(UInt64.self, buffer, &recordEnd) else { break }
+                    guard let value = Int(exactly: value) else { throw Errors.invalidJournal }
+                    entrySize = value
+                }
+                offset = recordEnd
+                journalRecordCount += 1
+                switch operation {
+                case .set:
+                    if let index = indexes[key] {
+                        size += entrySize - entries[index].size
+                        entries[index].size = entrySize
+                        moveToFront(index)
+                    } else {
+                        let index = makeEntry(Entry(key: key, size: entrySize))
+                        indexes[key] = index
+                        linkToFront(index)
+                        size += entrySize
+                    }
+                case .remove:
+                    if let index = indexes[key] {
+                        remove(index)
+                    }
+                case .access:
+                    if let index = indexes[key] {
+                        moveToFront(index)
+                    }
+                }
+            }
+            journalLength = offset
+        }
+    }
+
+    @inline(__always)
+    func read<T: FixedWidthInteger>(_ type: T.Type, _ buffer: UnsafeRawBufferPointer, _ offset: inout Int) -> T? {
+        guard offset + MemoryLayout<T>.size <= buffer.count else { return nil }
+        let value = buffer.loadUnaligned(fromByteOffset: offset, as: T.self)
+        offset += MemoryLayout<T>.size
+        return T(littleEndian: value)
+    }
+
+    func appendJournalRecord(_ operation: Operation, key: String, size: Int = 0) {
+        Self.appendRecord(operation, key: key, size: size, to: &journalBuffer)
+        journalRecordCount += 1
+        if journalBuffer.count >= Self.journalBufferSize {
+            flushJournal()
+        }
+    }
+
+    static func appendRecord(_ operation: Operation, key: String, size: Int, to data: inout Data) {
+        data.append(operation.rawValue)
+        var keyLength = UInt32(key.utf8.count).littleEndian
+        withUnsafeBytes(of: &keyLength) { data.append(contentsOf: $0) }
+        data.append(contentsOf: key.utf8)
+        if operation == .set {
+            var size = UInt64(size).littleEndian
+            withUnsafeBytes(of: &size) { data.append(contentsOf: $0) }
+        }
+    }
+
+    func flushJournal() {
+        guard !journalBuffer.isEmpty, let journalHandle = journalHandle else { return }
+        journalHandle.write(journalBuffer)
+        journalBuffer.removeAll(keepingCapacity: true)
+        if journalRecordCount > Swift.max(1024, indexes.count * 4) {
+            try? compact()
+        }
+    }
+
+    /// Writes the entries from the least to the most recently used into a new journal that replaces the current one.
+    func compact() throws {
+        var journal = Data(Self.journalMagic)
+        var index = tail
+        while index >= 0 {
+            Self.appendRecord(.set, key: entries[index].key, size: entries[index].size, to: &journal)
+            index = entries[index].previous
+        }
+        let temporaryURL = temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        try Self.writeSynchronized(journal, to: temporaryURL)
+        journalHandle?.closeFile()
+        journalHandle = nil
+        journalBuffer.removeAll(keepingCapacity: true)
+        guard rename(temporaryURL.path, journalURL.path) == 0 else {
+            let error = NSError(domain: NSPOSIXErrorDomain, code: Int(errno))
+            try? FileManager.default.removeItem(at: temporaryURL)
+            try openJournal()
+            throw error
+        }
+        journalRecordCount = indexes.count
+        try openJournal()
+    }
+
+    /// Writes the data to a new file and synchronizes it to disk, so that it's complete when the file is renamed.
+    static func writeSynchronized(_ data: Data, to url: URL) throws {
+        let fileDescriptor = open(url.path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0o644)
+        guard fileDescriptor >= 0 else { throw NSError(domain: NSPOSIXErrorDomain, code: Int(errno)) }
+        defer { close(fileDescriptor) }
+        try data.withUnsafeBytes { buffer in
+            var offset = 0
+            while offset < buffer.count {
+                let result = write(fileDescriptor, buffer.baseAddress! + offset, buffer.count - offset)
+                if result < 0, errno == EINTR { continue }
+                guard result > 0 else { throw NSError(domain: NSPOSIXErrorDomain, code: Int(errno)) }
+                offset += result
+            }
+        }
+        // F_FULLFSYNC flushes the drive cache as well, fsync only hands the data to the drive.
+        guard fcntl(fileDescriptor, F_FULLFSYNC) == 0 || fsync(fileDescriptor) == 0 else {
+            throw NSError(domain: NSPOSIXErrorDomain, code: Int(errno))
+        }
+    }
+}
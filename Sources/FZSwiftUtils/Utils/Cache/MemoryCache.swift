@@ -0,0 +1,533 @@
+//
+//  MemoryCache.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ A thread-safe in-memory cache that evicts values by their cost, count and age.
+
+ Reading, inserting and evicting values is `O(1)`. The values are stored in a hash map and linked in recency order, and the cache is divided into independently locked shards, so that concurrent access from many threads doesn't contend on a single lock.
+
+ ```swift
+ let cache = MemoryCache<URL, Data>(totalCostLimit: .megabytes(200), ttl: .minutes(10))
+ cache.setValue(data, forKey: url, cost: DataSize(data.count))
+ let cached = cache[url]
+ ```
+
+ The limits are distributed evenly across the shards, so the cache can start evicting before a limit is reached if the keys aren't evenly distributed.
+ */
+public final class MemoryCache<Key: Hashable, Value> {
+    /// The policy that decides which values are evicted from a cache.
+    public enum Policy: Hashable {
+        /// Evicts the least recently used values.
+        case lru
+        /**
+         Evicts values with a segmented least recently used policy.
+
+         New values are inserted into a probationary segment and move to a protected segment when they are accessed again, so that values that are only accessed once can't evict frequently used values.
+         */
+        case slru
+        /**
+         Evicts values with a segmented least recently used policy and only admits a new value if it's estimated to be used more frequently than the value it would evict.
+
+         The access frequency is estimated with a compact sketch of recent reads and writes. Use this policy for workloads where a large number of keys is only requested once.
+         */
+        case lfu
+    }
+
+    /// The statistics of a cache.
+    public struct Statistics: Hashable {
+        /// The number of reads that returned a value.
+        public internal(set) var hits: Int = 0
+        /// The number of reads that didn't return a value.
+        public internal(set) var misses: Int = 0
+        /// The number of values that have been inserted.
+        public internal(set) var insertions: Int = 0
+        /// The number of values that have been evicted to stay within the limits of the cache.
+        public internal(set) var evictions: Int = 0
+        /// The number of values that have been removed because their time to live elapsed.
+        public internal(set) var expirations: Int = 0
+        /// The number of values that weren't inserted because of the ``MemoryCache/Policy/lfu`` admission policy.
+        public internal(set) var rejections: Int = 0
+
+        /// The ratio of reads that returned a value.
+        public var hitRate: Double {
+            hits + misses == 0 ? 0.0 : Double(hits) / Double(hits + misses)
+        }
+
+        static func + (lhs: Self, rhs: Self) -> Self {
+            var statistics = lhs
+            statistics.hits += rhs.hits
+            statistics.misses += rhs.misses
+            statistics.insertions += rhs.insertions
+            statistics.evictions += rhs.evictions
+            statistics.expirations += rhs.expirations
+            statistics.rejections += rhs.rejections
+            return statistics
+        }
+    }
+
+    /// The maximum total cost of the values of the cache, or `zero` if the cost isn't limited.
+    public let totalCostLimit: DataSize
+
+    /// The maximum number of values in the cache, or `0` if the count isn't limited.
+    public let countLimit: Int
+
+    /// The default time to live of the values, or `nil` if values don't expire.
+    public let ttl: TimeDuration?
+
+    /// The eviction policy of the cache.
+    public let policy: Policy
+
+    let shards: [Shard]
+    let shardMask: Int
+
+    /**
+     Creates a memory cache with the specified limits.
+
+     - Parameters:
+        - totalCostLimit: The maximum total cost of the values, or `zero` to not limit the cost.
+        - countLimit: The maximum number of values, or `0` to not limit the count.
+        - ttl: The default time to live of the values, or `nil` if values don't expire.
+        - policy: The eviction policy. The default value is ``Policy/lru``.
+        - shardCount: The number of independently locked shards, or `nil` to choose a number based on the processor count and limits. The value is rounded up to the next power of two.
+     */
+    public init(totalCostLimit: DataSize = .zero, countLimit: Int = 0, ttl: TimeDuration? = nil, policy: Policy = .lru, shardCount: Int? = nil) {
+        self.totalCostLimit = totalCostLimit
+        self.countLimit = countLimit
+        self.ttl = ttl
+        self.policy = policy
+        var shardCount = shardCount ?? ProcessInfo.processInfo.activeProcessorCount * 2
+        if countLimit > 0 {
+            // Small caches would lose most of their precision when divided across many shards.
+            shardCount = Swift.min(shardCount, Swift.max(1, countLimit / 64))
+        }
+        shardCount = Swift.max(1, shardCount).nextPowerOfTwo
+        shardMask = shardCount - 1
+        let shardCountLimit = countLimit > 0 ? (countLimit + shardCount - 1) / shardCount : 0
+        let shardCostLimit = totalCostLimit.bytes > 0 ? (totalCostLimit.bytes + shardCount - 1) / shardCount : 0
+        shards = (0 ..< shardCount).map { _ in Shard(countLimit: shardCountLimit, costLimit: shardCostLimit, policy: policy) }
+    }
+
+    /// Accesses the value associated with the specified key.
+    public subscript(key: Key) -> Value? {
+        get { value(forKey: key) }
+        set {
+            if let newValue = newValue {
+                setValue(newValue, forKey: key)
+            } else {
+                removeValue(forKey: key)
+            }
+        }
+    }
+
+    /**
+     Returns the value associated with the specified key.
+
+     - Parameter key: The key.
+     - Returns: The value, or `nil` if the cache doesn't contain a value for the key or if the value expired.
+     */
+    public func value(forKey key: Key) -> Value? {
+        let hash = key.hashValue
+        return shard(for: hash).value(forKey: key, hash: hash, now: Self.now)
+    }
+
+    /**
+     Returns the value associated with the specified key, or inserts the value returned by the specified handler.
+
+     - Parameters:
+        - key: The key.
+        - cost: The cost of a new value.
+        - handler: The handler that returns the value if the cache doesn't contain a value for the key.
+     */
+    public func value(forKey key: Key, cost: DataSize = .zero, orInsert handler: () throws -> Value) rethrows -> Value {
+        if let value = value(forKey: key) {
+            return value
+        }
+        let value = try handler()
+        setValue(value, forKey: key, cost: cost)
+        return value
+    }
+
+    /**
+     Sets the value for the specified key.
+
+     - Parameters:
+        - value: The value.
+        - key: The key.
+        - cost: The cost of the value, like the size of its data.
+        - ttl: The time to live of the value, or `nil` to use the default ``ttl`` of the cache.
+     */
+    public func setValue(_ value: Value, forKey key: Key, cost: DataSize = .zero, ttl: TimeDuration? = nil) {
+        let hash = key.hashValue
+        let now = Self.now
+        var expiration: UInt64 = 0
+        if let ttl = ttl ?? self.ttl {
+            let nanoseconds = Swift.max(0, ttl.seconds) * 1_000_000_000
+            // Infinite durations and expirations past UInt64.max don't expire.
+            if nanoseconds < Double(UInt64.max) {
+                let (sum, overflow) = now.addingReportingOverflow(UInt64(nanoseconds))
+                expiration = overflow ? 0 : sum
+            }
+        }
+        shard(for: hash).setValue(value, forKey: key, hash: hash, cost: Swift.max(0, cost.bytes), expiration: expiration)
+    }
+
+    /**
+     Removes the value for the specified key.
+
+     - Parameter key: The key.
+     - Returns: The removed value, or `nil` if the cache didn't contain a value for the key.
+     */
+    @discardableResult
+    public func removeValue(forKey key: Key) -> Value? {
+        let hash = key.hashValue
+        return shard(for: hash).removeValue(forKey: key)
+    }
+
+    /// Removes all values from the cache.
+    public func removeAll() {
+        shards.forEach { $0.removeAll() }
+    }
+
+    /// Removes all values whose time to live elapsed.
+    public func removeExpiredValues() {
+        let now = Self.now
+        shards.forEach { $0.removeExpired(now: now) }
+    }
+
+    /// The number of values in the cache, including expired values that haven't been removed yet.
+    public var count: Int {
+        shards.reduce(0) { count, shard in count + shard.synchronized { $0.count } }
+    }
+
+    /// The total cost of the values in the cache.
+    public var totalCost: DataSize {
+        DataSize(shards.reduce(0) { cost, shard in cost + shard.synchronized { $0.totalCost } })
+    }
+
+    /// The hit, miss and eviction statistics of the cache.
+    public var statistics: Statistics {
+        shards.reduce(Statistics()) { statistics, shard in statistics + shard.synchronized { $0.statistics } }
+    }
+
+    /// Resets the statistics of the cache.
+    public func resetStatistics() {
+        shards.forEach { $0.synchronized { $0.statistics = Statistics() } }
+    }
+
+    @inline(__always)
+    func shard(for hash: Int) -> Shard {
+        // Mixes the high bits into the shard index, as the low bits of some hash values are poorly distributed.
+        shards[(hash ^ (hash >> 32) ^ (hash >> 16)) & shardMask]
+    }
+
+    static var now: UInt64 {
+        DispatchTime.now().uptimeNanoseconds
+    }
+}
+
+extension MemoryCache {
+    final class Shard {
+        enum Segment: Int {
+            case probation = 0
+            case protected = 1
+        }
+
+        struct Entry {
+            var key: Key
+            var value: Value?
+            var hash: Int
+            var cost: Int
+            var expiration: UInt64
+            var segment: Segment = .probation
+            var previous: Int = -1
+            var next: Int = -1
+        }
+
+        let lock = NSLock()
+        let countLimit: Int
+        let costLimit: Int
+        let protectedCountLimit: Int
+        let protectedCostLimit: Int
+        let isSegmented: Bool
+        var sketch: FrequencySketch?
+
+        var indexes: [Key: Int] = [:]
+        var entries: [Entry] = []
+        var freeIndexes: [Int] = []
+        var heads = [-1, -1]
+        var tails = [-1, -1]
+        var segmentCounts = [0, 0]
+        var segmentCosts = [0, 0]
+        var statistics = Statistics()
+
+        init(countLimit: Int, costLimit: Int, policy: Policy) {
+            self.countLimit = countLimit
+            self.costLimit = costLimit
+            isSegmented = policy != .lru
+            // The protected segment holds 80% of the cache, as proposed for SLRU.
+            protectedCountLimit = countLimit > 0 ? Swift.max(1, countLimit * 4 / 5) : 0
+            protectedCostLimit = costLimit > 0 ? Swift.max(1, costLimit * 4 / 5) : 0
+            if policy == .lfu {
+                sketch = FrequencySketch(capacity: countLimit > 0 ? countLimit : 1024)
+            }
+        }
+
+        var count: Int {
+            segmentCounts[0] + segmentCounts[1]
+        }
+
+        var totalCost: Int {
+            segmentCosts[0] + segmentCosts[1]
+        }
+
+        @inline(__always)
+        func synchronized<T>(_ body: (Shard) throws -> T) rethrows -> T {
+            lock.lock()
+            defer { lock.unlock() }
+            return try body(self)
+        }
+
+        func value(forKey key: Key, hash: Int, now: UInt64) -> Value? {
+            lock.lock()
+            defer { lock.unlock() }
+            sketch?.increment(hash)
+            guard let index = indexes[key] else {
+                statistics.misses += 1
+                return nil
+            }
+            if isExpired(index, now: now) {
+                remove(index)
+                statistics.expirations += 1
+                statistics.misses += 1
+                return nil
+            }
+            statistics.hits += 1
+            touch(index)
+            return entries[index].value
+        }
+
+        func setValue(_ value: Value, forKey key: Key, hash: Int, cost: Int, expiration: UInt64) {
+            lock.lock()
+            defer { lock.unlock() }
+            sketch?.increment(hash)
+            if let index = indexes[key] {
+                segmentCosts[entries[index].segment.rawValue] += cost - entries[index].cost
+                entries[index].value = value
+                entries[index].cost = cost
+                entries[index].expiration = expiration
+                touch(index)
+                trim()
+                return
+            }
+            if let sketch = sketch, exceedsLimits(addingCost: cost), let victim = evictionCandidate(),
+               sketch.frequency(hash) <= sketch.frequency(entries[victim].hash) {
+                statistics.rejections += 1
+                return
+            }
+            let index = makeEntry(Entry(key: key, value: value, hash: hash, cost: cost, expiration: expiration))
+            indexes[key] = index
+            link(index, to: .probation)
+            statistics.insertions += 1
+            trim()
+        }
+
+        func removeValue(forKey key: Key) -> Value? {
+            lock.lock()
+            defer { lock.unlock() }
+            guard let index = indexes[key] else { return nil }
+            let value = entries[index].value
+            remove(index)
+            return value
+        }
+
+        func removeAll() {
+            lock.lock()
+            defer { lock.unlock() }
+            indexes.removeAll()
+            entries.removeAll()
+            freeIndexes.removeAll()
+            heads = [-1, -1]
+            tails = [-1, -1]
+            segmentCounts = [0, 0]
+            segmentCosts = [0, 0]
+        }
+
+        func removeExpired(now: UInt64) {
+            lock.lock()
+            defer { lock.unlock() }
+            for segment in [Segment.probation, .protected] {
+                var index = tails[segment.rawValue]
+                while index >= 0 {
+                    let previous = entries[index].previous
+                    if isExpired(index, now: now) {
+                        remove(index)
+                        statistics.expirations += 1
+                    }
+                    index = previous
+                }
+            }
+        }
+
+        @inline(__always)
+        func isExpired(_ index: Int, now: UInt64) -> Bool {
+            let expiration = entries[index].expiration
+            return expiration != 0 && expiration <= now
+        }
+
+        @inline(__always)
+        func exceedsLimits(addingCost cost: Int = 0, addingCount addedCount: Int = 1) -> Bool {
+            (countLimit > 0 && count + addedCount > countLimit) || (costLimit > 0 && totalCost + cost > costLimit)
+        }
+
+        func makeEntry(_ entry: Entry) -> Int {
+            if let index = freeIndexes.popLast() {
+                entries[index] = entry
+                return index
+            }
+            entries.append(entry)
+            return entries.count - 1
+        }
+
+        /// Marks the entry as recently used.
+        func touch(_ index: Int) {
+            let segment = entries[index].segment
+            unlink(index)
+            if isSegmented, segment == .probation {
+                link(index, to: .protected)
+                // Demotes the least recently used protected entries to keep the protected segment within its limits.
+                while segmentCounts[1] > 1, (protectedCountLimit > 0 && segmentCounts[1] > protectedCountLimit) || (protectedCostLimit > 0 && segmentCosts[1] > protectedCostLimit) {
+                    let tail = tails[1]
+                    unlink(tail)
+                    link(tail, to: .probation)
+                }
+            } else {
+                link(index, to: segment)
+            }
+        }
+
+        /// The least recently used entry of the probationary segment, or of the protected segment if the probationary segment is empty.
+        func evictionCandidate() -> Int? {
+            if tails[0] >= 0 { return tails[0] }
+            if tails[1] >= 0 { return tails[1] }
+            return nil
+        }
+
+        func trim() {
+            while exceedsLimits(addingCount: 0), let index = evictionCandidate() {
+                remove(index)
+                statistics.evictions += 1
+            }
+        }
+
+        func link(_ index: Int, to segment: Segment) {
+            let list = segment.rawValue
+            entries[index].segment = segment
+            entries[index].previous = -1
+            entries[index].next = heads[list]
+            if heads[list] >= 0 {
+                entries[heads[list]].previous = index
+            } else {
+                tails[list] = index
+            }
+            heads[list] = index
+            segmentCounts[list] += 1
+            segmentCosts[list] += entries[index].cost
+        }
+
+        func unlink(_ index: Int) {
+            let list = entries[index].segment.rawValue
+            let previous = entries[index].previous
+            let next = entries[index].next
+            if previous >= 0 {
+                entries[previous].next = next
+            } else {
+                heads[list] = next
+            }
+            if next >= 0 {
+                entries[next].previous = previous
+            } else {
+                tails[list] = previous
+            }
+            segmentCounts[list] -= 1
+            segmentCosts[list] -= entries[index].cost
+        }
+
+        func remove(_ index: Int) {
+            unlink(index)
+            indexes[entries[index].key] = nil
+            entries[index].value = nil
+            freeIndexes.append(index)
+        }
+    }
+
+    /// A count-min sketch with 4 bit counters that estimates how often keys were accessed recently.
+    struct FrequencySketch {
+        var table: [UInt8]
+        let mask: Int
+        let sampleSize: Int
+        var additions = 0
+
+        static var seeds: (UInt64, UInt64, UInt64, UInt64) {
+            (0x9E37_79B9_7F4A_7C15, 0xC2B2_AE3D_27D4_EB4F, 0x1656_67B1_9E37_79F9, 0x85EB_CA77_C2B2_AE63)
+        }
+
+        init(capacity: Int) {
+            let size = Swift.min(Swift.max(64, capacity * 4), 1 << 24).nextPowerOfTwo
+            table = [UInt8](repeating: 0, count: size)
+            mask = size - 1
+            sampleSize = size * 10
+        }
+
+        @inline(__always)
+        func index(_ hash: Int, _ seed: UInt64) -> Int {
+            var value = UInt64(bitPattern: Int64(hash)) &* seed
+            value ^= value >> 29
+            return Int(truncatingIfNeeded: value) & mask
+        }
+
+        func frequency(_ hash: Int) -> UInt8 {
+            let seeds = Self.seeds
+            return Swift.min(table[index(hash, seeds.0)], table[index(hash, seeds.1)], table[index(hash, seeds.2)], table[index(hash, seeds.3)])
+        }
+
+        mutating func increment(_ hash: Int) {
+            let seeds = Self.seeds
+            increment(at: index(hash, seeds.0))
+            increment(at: index(hash, seeds.1))
+            increment(at: index(hash, seeds.2))
+            increment(at: index(hash, seeds.3))
+            additions += 1
+            if additions >= sampleSize {
+                // Ages the counters so that the sketch adapts to changing access patterns.
+                for index in table.indices {
+                    table[index] >>= 1
+                }
+                additions /= 2
+            }
+        }
+
+        @inline(__always)
+        mutating func increment(at index: Int) {
+            if table[index] < 15 {
+                table[index] += 1
+            }
+        }
+    }
+}
+
+extension MemoryCache.Shard: @unchecked Sendable {}
+extension MemoryCache: @unchecked Sendable {}
+
+extension Int {
+    /// The smallest power of two that is greater than or equal to the value.
+    var nextPowerOfTwo: Int {
+        guard self > 1 else { return 1 }
+        return 1 << (Int.bitWidth - (self - 1).leadingZeroBitCount)
+    }
+}
@@ -0,0 +1,620 @@
+//
+//  IntervalTree.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ A collection of intervals with associated values that can be queried for the intervals overlapping a range or containing a value.
+
+ The tree is a self-balancing (AVL) binary search tree ordered by the lower bound of its intervals. Each node stores the largest upper bound of its subtree, which lets queries skip every subtree that can't contain a match.
+
+ Inserting and removing an interval is `O(log n)`. Querying the intervals that overlap a range or contain a value is `O(log n + k)` for typical data, where `k` is the number of matching intervals, and never worse than `O(min(n, k log n))`.
+
+ ```swift
+ var tree = IntervalTree<Int, String>()
+ tree.insert(0..<10, value: "a")
+ tree.insert(5...15, value: "b")
+
+ tree.elements(containing: 12) // [5...15: "b"]
+ tree.elements(overlapping: 8..<20) // [0..<10: "a", 5...15: "b"]
+ ```
+
+ Both half-open (`Range`) and closed (`ClosedRange`) intervals can be stored in the same tree.
+ */
+public struct IntervalTree<Bound: Comparable, Value> {
+    /// An interval of the tree and its associated value.
+    public struct Element {
+        /// The lower bound of the interval.
+        public let lowerBound: Bound
+
+        /// The upper bound of the interval.
+        public let upperBound: Bound
+
+        /// A Boolean value indicating whether the upper bound is part of the interval.
+        public let includesUpperBound: Bool
+
+        /// The value associated with the interval.
+        public var value: Value
+
+        /**
+         Creates an element with the specified half-open range and value.
+
+         - Parameters:
+            - range: The range of the interval.
+            - value: The value associated with the interval.
+         */
+        public init(_ range: Range<Bound>, value: Value) {
+            lowerBound = range.lowerBound
+            upperBound = range.upperBound
+            includesUpperBound = false
+            self.value = value
+        }
+
+        /**
+         Creates an element with the specified closed range and value.
+
+         - Parameters:
+            - range: The range of the interval.
+            - value: The value associated with the interval.
+         */
+        public init(_ range: ClosedRange<Bound>, value: Value) {
+            lowerBound = range.lowerBound
+            upperBound = range.upperBound
+            includesUpperBound = true
+            self.value = value
+        }
+
+        /// A Boolean value indicating whether the interval contains no values.
+        public var isEmpty: Bool {
+            lowerBound == upperBound && !includesUpperBound
+        }
+
+        /// Returns a Boolean value indicating whether the interval contains the specified value.
+        public func contains(_ value: Bound) -> Bool {
+            lowerBound <= value && (value < upperBound || (includesUpperBound && value == upperBound))
+        }
+
+        /// Returns a Boolean value indicating whether the interval overlaps the specified range.
+        public func overlaps(_ range: Range<Bound>) -> Bool {
+            overlaps(range.lowerBound, range.upperBound, false)
+        }
+
+        /// Returns a Boolean value indicating whether the interval overlaps the specified range.
+        public func overlaps(_ range: ClosedRange<Bound>) -> Bool {
+            overlaps(range.lowerBound, range.upperBound, true)
+        }
+
+        @inline(__always)
+        func overlaps(_ lower: Bound, _ upper: Bound, _ closed: Bool) -> Bool {
+            guard !isEmpty, lower < upper || (closed && lower == upper) else { return false }
+            return (lowerBound < upper || (closed && lowerBound == upper)) && (lower < upperBound || (includesUpperBound && lower == upperBound))
+        }
+    }
+
+    struct Node {
+        var element: Element
+        var left: Int = -1
+        var right: Int = -1
+        var height: Int = 1
+        var maxUpperBound: Bound
+        var maxIncludesUpperBound: Bool
+
+        init(_ element: Element) {
+            self.element = element
+            maxUpperBound = element.upperBound
+            maxIncludesUpperBound = element.includesUpperBound
+        }
+    }
+
+    var nodes: [Node] = []
+    var freeIndexes: [Int] = []
+    var root: Int = -1
+
+    /// The number of intervals in the tree.
+    public private(set) var count: Int = 0
+
+    /// A Boolean value indicating whether the tree is empty.
+    public var isEmpty: Bool {
+        count == 0
+    }
+
+    /// Creates an empty interval tree.
+    public init() {}
+
+    /**
+     Creates an interval tree with the specified elements.
+
+     - Parameter elements: The elements of the tree.
+     - Complexity: `O(n log n)`. If the elements are already sorted by their lower bound, use ``init(sorted:)``.
+     */
+    public init(_ elements: some Sequence<Element>) {
+        self.init(sorted: elements.sorted(by: { Self.compare($0, $1) < 0 }))
+    }
+
+    /**
+     Creates an interval tree with the specified elements that are sorted by their lower bound.
+
+     - Parameter elements: The elements of the tree, sorted by their lower bound in ascending order.
+     - Complexity: `O(n)`.
+     */
+    public init(sorted elements: some Collection<Element>) {
+        nodes.reserveCapacity(elements.count)
+        var previous: Element?
+        for element in elements {
+            if let previous = previous {
+                precondition(Self.compare(previous, element) <= 0, "Elements must be sorted by their lower bound.")
+            }
+            nodes.append(Node(element))
+            previous = element
+        }
+        count = nodes.count
+        root = build(0, nodes.count - 1)
+    }
+
+    /**
+     Inserts the specified half-open range and value.
+
+     - Parameters:
+        - range: The range to insert.
+        - value: The value associated with the range.
+     - Complexity: `O(log n)`.
+     */
+    public mutating func insert(_ range: Range<Bound>, value: Value) {
+        insert(Element(range, value: value))
+    }
+
+    /**
+     Inserts the specified closed range and value.
+
+     - Parameters:
+        - range: The range to insert.
+        - value: The value associated with the range.
+     - Complexity: `O(log n)`.
+     */
+    public mutating func insert(_ range: ClosedRange<Bound>, value: Value) {
+        insert(Element(range, value: value))
+    }
+
+    /**
+     Inserts the specified element.
+
+     - Parameter element: The element to insert.
+     - Complexity: `O(log n)`.
+     */
+    public mutating func insert(_ element: Element) {
+        root = insert(element, into: root)
+        count += 1
+    }
+
+    /**
+     Removes an interval matching the specified half-open range.
+
+     - Parameter range: The range to remove.
+     - Returns: The value of the removed interval, or `nil` if the tree doesn't contain the range.
+     - Complexity: `O(log n)`.
+     */
+    @discardableResult
+    public mutating func remove(_ range: Range<Bound>) -> Value? {
+        remove(range.lowerBound, range.upperBound, false, where: { _ in true })?.value
+    }
+
+    /**
+     Removes an interval matching the specified closed range.
+
+     - Parameter range: The range to remove.
+     - Returns: The value of the removed interval, or `nil` if the tree doesn't contain the range.
+     - Complexity: `O(log n)`.
+     */
+    @discardableResult
+    public mutating func remove(_ range: ClosedRange<Bound>) -> Value? {
+        remove(range.lowerBound, range.upperBound, true, where: { _ in true })?.value
+    }
+
+    /**
+     Removes an interval matching the specified half-open range whose value satisfies the given predicate.
+
+     - Parameters:
+        - range: The range to remove.
+        - predicate: A closure that returns `true` if the value of an interval with the range should be removed.
+     - Returns: The value of the removed interval, or `nil` if no interval matches.
+     */
+    @discardableResult
+    public mutating func remove(_ range: Range<Bound>, where predicate: (Value) -> Bool) -> Value? {
+        remove(range.lowerBound, range.upperBound, false, where: predicate)?.value
+    }
+
+    /**
+     Removes an interval matching the specified closed range whose value satisfies the given predicate.
+
+     - Parameters:
+        - range: The range to remove.
+        - predicate: A closure that returns `true` if the value of an interval with the range should be removed.
+     - Returns: The value of the removed interval, or `nil` if no interval matches.
+     */
+    @discardableResult
+    public mutating func remove(_ range: ClosedRange<Bound>, where predicate: (Value) -> Bool) -> Value? {
+        remove(range.lowerBound, range.upperBound, true, where: predicate)?.value
+    }
+
+    /// Removes all intervals from the tree.
+    public mutating func removeAll(keepingCapacity keepCapacity: Bool = false) {
+        nodes.removeAll(keepingCapacity: keepCapacity)
+        freeIndexes.removeAll(keepingCapacity: keepCapacity)
+        root = -1
+        count = 0
+    }
+
+    /**
+     Returns the intervals that overlap the specified half-open range, sorted by their lower bound.
+
+     - Parameter range: The range to query.
+     - Complexity: `O(log n + k)`, where `k` is the number of returned intervals.
+     */
+    public func elements(overlapping range: Range<Bound>) -> [Element] {
+        var elements: [Element] = []
+        collect(range.lowerBound, range.upperBound, false, from: root, into: &elements)
+        return elements
+    }
+
+    /**
+     Returns the intervals that overlap the specified closed range, sorted by their lower bound.
+
+     - Parameter range: The range to query.
+     - Complexity: `O(log n + k)`, where `k` is the number of returned intervals.
+     */
+    public func elements(overlapping range: ClosedRange<Bound>) -> [Element] {
+        var elements: [Element] = []
+        collect(range.lowerBound, range.upperBound, true, from: root, into: &elements)
+        return elements
+    }
+
+    /**
+     Returns the intervals that contain the specified value, sorted by their lower bound.
+
+     - Parameter value: The value to query.
+     - Complexity: `O(log n + k)`, where `k` is the number of returned intervals.
+     */
+    public func elements(containing value: Bound) -> [Element] {
+        var elements: [Element] = []
+        collect(value, value, true, from: root, into: &elements)
+        return elements
+    }
+
+    /**
+     Returns a Boolean value indicating whether any interval overlaps the specified half-open range.
+
+     - Parameter range: The range to query.
+     */
+    public func intersects(_ range: Range<Bound>) -> Bool {
+        firstOverlap(range.lowerBound, range.upperBound, false, from: root) != nil
+    }
+
+    /**
+     Returns a Boolean value indicating whether any interval overlaps the specified closed range.
+
+     - Parameter range: The range to query.
+     */
+    public func intersects(_ range: ClosedRange<Bound>) -> Bool {
+        firstOverlap(range.lowerBound, range.upperBound, true, from: root) != nil
+    }
+
+    /// The intervals of the tree, sorted by their lower bound.
+    public var elements: [Element] {
+        Array(self)
+    }
+}
+
+extension IntervalTree: Sequence {
+    /// An iterator over the intervals of an interval tree, sorted by their lower bound.
+    public struct Iterator: IteratorProtocol {
+        let tree: IntervalTree
+        var stack: [Int] = []
+
+        init(_ tree: IntervalTree) {
+            self.tree = tree
+            pushLeft(tree.root)
+        }
+
+        mutating func pushLeft(_ index: Int) {
+            var index = index
+            while index >= 0 {
+                stack.append(index)
+                index = tree.nodes[index].left
+            }
+        }
+
+        public mutating func next() -> Element? {
+            guard let index = stack.popLast() else { return nil }
+            pushLeft(tree.nodes[index].right)
+            return tree.nodes[index].element
+        }
+    }
+
+    public func makeIterator() -> Iterator {
+        Iterator(self)
+    }
+
+    public var underestimatedCount: Int {
+        count
+    }
+}
+
+extension IntervalTree: ExpressibleByArrayLiteral {
+    public init(arrayLiteral elements: Element...) {
+        self.init(elements)
+    }
+}
+
+extension IntervalTree.Element: CustomStringConvertible {
+    public var description: String {
+        "\(lowerBound)\(includesUpperBound ? "..." : "..<")\(upperBound): \(value)"
+    }
+}
+
+public extension IntervalTree where Bound == Date {
+    /**
+     Inserts the specified date interval and value.
+
+     - Parameters:
+        - interval: The date interval to insert.
+        - value: The value associated with the date interval.
+     - Complexity: `O(log n)`.
+     */
+    mutating func insert(_ interval: DateInterval, value: Value) {
+        insert(interval.start ... interval.end, value: value)
+    }
+
+    /**
+     Removes an interval matching the specified date interval.
+
+     - Parameter interval: The date interval to remove.
+     - Returns: The value of the removed interval, or `nil` if the tree doesn't contain the date interval.
+     */
+    @discardableResult
+    mutating func remove(_ interval: DateInterval) -> Value? {
+        remove(interval.start ... interval.end)
+    }
+
+    /**
+     Returns the intervals that overlap the specified date interval, sorted by their start date.
+
+     - Parameter interval: The date interval to query.
+     - Complexity: `O(log n + k)`, where `k` is the number of returned intervals.
+     */
+    func elements(overlapping interval: DateInterval) -> [Element] {
+        elements(overlapping: interval.start ... interval.end)
+    }
+
+    /**
+     Returns a Boolean value indicating whether any interval overlaps the specified date interval.
+
+     - Parameter interval: The date interval to query.
+     */
+    func intersects(_ interval: DateInterval) -> Bool {
+        intersects(interval.start ... interval.end)
+    }
+}
+
+public extension IntervalTree.Element where Bound == Date {
+    /// The date interval of the element.
+    var dateInterval: DateInterval {
+        DateInterval(start: lowerBound, end: upperBound)
+    }
+
+    /**
+     Creates an element with the specified date interval and value.
+
+     - Parameters:
+        - interval: The date interval.
+        - value: The value associated with the date interval.
+     */
+    init(_ interval: DateInterval, value: Value) {
+        self.init(interval.start ... interval.end, value: value)
+    }
+}
+
+extension IntervalTree {
+    @inline(__always)
+    static func compare(_ lhs: Element, _ rhs: Element) -> Int {
+        compare(lhs.lowerBound, lhs.upperBound, lhs.includesUpperBound, rhs)
+    }
+
+    @inline(__always)
+    static func compare(_ lower: Bound, _ upper: Bound, _ closed: Bool, _ element: Element) -> Int {
+        if lower != element.lowerBound { return lower < element.lowerBound ? -1 : 1 }
+        if upper != element.upperBound { return upper < element.upperBound ? -1 : 1 }
+        if closed != element.includesUpperBound { return closed ? 1 : -1 }
+        return 0
+    }
+
+    @inline(__always)
+    func height(_ index: Int) -> Int {
+        index >= 0 ? nodes[index].height : 0
+    }
+
+    mutating func makeNode(_ element: Element) -> Int {
+        if let index = freeIndexes.popLast() {
+            nodes[index] = Node(element)
+            return index
+        }
+        nodes.append(Node(element))
+        return nodes.count - 1
+    }
+
+    mutating func update(_ index: Int) {
+        let left = nodes[index].left
+        let right = nodes[index].right
+        var maxUpperBound = nodes[index].element.upperBound
+        var maxIncludesUpperBound = nodes[index].element.includesUpperBound
+        mergeMaximum(of: left, into: &maxUpperBound, &maxIncludesUpperBound)
+        mergeMaximum(of: right, into: &maxUpperBound, &maxIncludesUpperBound)
+        nodes[index].height = 1 + Swift.max(height(left), height(right))
+        nodes[index].maxUpperBound = maxUpperBound
+        nodes[index].maxIncludesUpperBound = maxIncludesUpperBound
+    }
+
+    @inline(__always)
+    func mergeMaximum(of child: Int, into maxUpperBound: inout Bound, _ maxIncludesUpperBound: inout Bool) {
+        guard child >= 0 else { return }
+        let upperBound = nodes[child].maxUpperBound
+        if upperBound > maxUpperBound {
+            maxUpperBound = upperBound
+            maxIncludesUpperBound = nodes[child].maxIncludesUpperBound
+        } else if upperBound == maxUpperBound, nodes[child].maxIncludesUpperBound {
+            maxIncludesUpperBound = true
+        }
+    }
+
+    mutating func rotateLeft(_ index: Int) -> Int {
+        let right = nodes[index].right
+        nodes[index].right = nodes[right].left
+        nodes[right].left = index
+        update(index)
+        update(right)
+        return right
+    }
+
+    mutating func rotateRight(_ index: Int) -> Int {
+        let left = nodes[index].left
+        nodes[index].left = nodes[left].right
+        nodes[left].right = index
+        update(index)
+        update(left)
+        return left
+    }
+
+    mutating func rebalance(_ index: Int) -> Int {
+        update(index)
+        let left = nodes[index].left
+        let right = nodes[index].right
+        let balance = height(left) - height(right)
+        if balance > 1 {
+            if height(nodes[left].left) < height(nodes[left].right) {
+                let rotated = rotateLeft(left)
+                nodes[index].left = rotated
+            }
+            return rotateRight(index)
+        } else if balance < -1 {
+            if height(nodes[right].right) < height(nodes[right].left) {
+                let rotated = rotateRight(right)
+                nodes[index].right = rotated
+            }
+            return rotateLeft(index)
+        }
+        return index
+    }
+
+    mutating func build(_ low: Int, _ high: Int) -> Int {
+        guard low <= high else { return -1 }
+        let mid = low + (high - low) / 2
+        let left = build(low, mid - 1)
+        let right = build(mid + 1, high)
+        nodes[mid].left = left
+        nodes[mid].right = right
+        update(mid)
+        return mid
+    }
+
+    mutating func insert(_ element: Element, into index: Int) -> Int {
+        guard index >= 0 else { return makeNode(element) }
+        if Self.compare(element, nodes[index].element) < 0 {
+            let left = insert(element, into: nodes[index].left)
+            nodes[index].left = left
+        } else {
+            let right = insert(element, into: nodes[index].right)
+            nodes[index].right = right
+        }
+        return rebalance(index)
+    }
+
+    mutating func remove(_ lower: Bound, _ upper: Bound, _ closed: Bool, where predicate: (Value) -> Bool) -> Element? {
+        var removed: Element?
+        root = remove(lower, upper, closed, from: root, where: predicate, removed: &removed)
+        if removed != nil {
+            count -= 1
+        }
+        return removed
+    }
+
+    mutating func remove(_ lower: Bound, _ upper: Bound, _ closed: Bool, from index: Int, where predicate: (Value) -> Bool, removed: inout Element?) -> Int {
+        guard index >= 0 else { return index }
+        let order = Self.compare(lower, upper, closed, nodes[index].element)
+        if order < 0 {
+            let left = remove(lower, upper, closed, from: nodes[index].left, where: predicate, removed: &removed)
+            nodes[index].left = left
+        } else if order > 0 {
+            let right = remove(lower, upper, closed, from: nodes[index].right, where: predicate, removed: &removed)
+            nodes[index].right = right
+        } else if predicate(nodes[index].element.value) {
+            removed = nodes[index].element
+            return removeNode(index)
+        } else {
+            // Equal intervals can end up in both subtrees after rotations.
+            let left = remove(lower, upper, closed, from: nodes[index].left, where: predicate, removed: &removed)
+            nodes[index].left = left
+            if removed == nil {
+                let right = remove(lower, upper, closed, from: nodes[index].right, where: predicate, removed: &removed)
+                nodes[index].right = right
+            }
+        }
+        return removed != nil ? rebalance(index) : index
+    }
+
+    mutating func removeNode(_ index: Int) -> Int {
+        let left = nodes[index].left
+        let right = nodes[index].right
+        freeIndexes.append(index)
+        guard left >= 0 else { return right }
+        guard right >= 0 else { return left }
+        let (newRight, minimum) = removeMinimum(right)
+        nodes[minimum].left = left
+        nodes[minimum].right = newRight
+        return rebalance(minimum)
+    }
+
+    mutating func removeMinimum(_ index: Int) -> (root: Int, minimum: Int) {
+        let left = nodes[index].left
+        guard left >= 0 else { return (nodes[index].right, index) }
+        let (newLeft, minimum) = removeMinimum(left)
+        nodes[index].left = newLeft
+        return (rebalance(index), minimum)
+    }
+
+    @inline(__always)
+    func canOverlap(_ index: Int, _ lower: Bound) -> Bool {
+        let upperBound = nodes[index].maxUpperBound
+        return lower < upperBound || (lower == upperBound && nodes[index].maxIncludesUpperBound)
+    }
+
+    @inline(__always)
+    func startsAfter(_ index: Int, _ upper: Bound, _ closed: Bool) -> Bool {
+        let lowerBound = nodes[index].element.lowerBound
+        return lowerBound > upper || (lowerBound == upper && !closed)
+    }
+
+    func collect(_ lower: Bound, _ upper: Bound, _ closed: Bool, from index: Int, into elements: inout [Element]) {
+        guard index >= 0, canOverlap(index, lower) else { return }
+        collect(lower, upper, closed, from: nodes[index].left, into: &elements)
+        guard !startsAfter(index, upper, closed) else { return }
+        if nodes[index].element.overlaps(lower, upper, closed) {
+            elements.append(nodes[index].element)
+        }
+        collect(lower, upper, closed, from: nodes[index].right, into: &elements)
+    }
+
+    func firstOverlap(_ lower: Bound, _ upper: Bound, _ closed: Bool, from index: Int) -> Int? {
+        guard index >= 0, canOverlap(index, lower) else { return nil }
+        if let match = firstOverlap(lower, upper, closed, from: nodes[index].left) {
+            return match
+        }
+        guard !startsAfter(index, upper, closed) else { return nil }
+        if nodes[index].element.overlaps(lower, upper, closed) {
+            return index
+        }
+        return firstOverlap(lower, upper, closed, from: nodes[index].right)
+    }
+}
@@ -0,0 +1,173 @@
+//
+//  PathTree.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ A prefix tree of file paths that maps file urls to values and supports fast directory queries.
+
+ In contrast to a ``RadixTree``, prefixes respect path components: `/Users/Flo` isn't treated as a prefix of `/Users/Florian`.
+
+ ```swift
+ var watchedFolders = PathTree<String>()
+ watchedFolders[URL(fileURLWithPath: "/Users/Florian/Documents")] = "Documents"
+
+ watchedFolders.nearestAncestor(of: URL(fileURLWithPath: "/Users/Florian/Documents/Notes/Todo.txt")) // (Documents url, "Documents")
+ watchedFolders.containsAncestor(of: URL(fileURLWithPath: "/Users/Florian/Downloads/Image.png")) // false
+ ```
+
+ Urls are compared by their standardized path. Iterating a tree returns its elements ordered by their paths.
+ */
+public struct PathTree<Value> {
+    var tree = RadixTree<Value>()
+
+    /// The number of paths in the tree.
+    public var count: Int {
+        tree.count
+    }
+
+    /// A Boolean value indicating whether the tree is empty.
+    public var isEmpty: Bool {
+        tree.isEmpty
+    }
+
+    /// Creates an empty path tree.
+    public init() {}
+
+    /// Accesses the value associated with the specified file url.
+    public subscript(url: URL) -> Value? {
+        get { tree.value(for: Self.key(for: url)) }
+        set { tree[Self.key(for: url)] = newValue }
+    }
+
+    /// Accesses the value associated with the specified file path.
+    public subscript(path: String) -> Value? {
+        get { self[URL(fileURLWithPath: path)] }
+        set { self[URL(fileURLWithPath: path)] = newValue }
+    }
+
+    /// Returns a Boolean value indicating whether the tree contains the specified file url.
+    public func contains(_ url: URL) -> Bool {
+        tree.contains(Self.key(for: url))
+    }
+
+    /**
+     Updates the value stored for the specified file url, or adds a new url if it doesn't exist.
+
+     - Parameters:
+        - value: The new value.
+        - url: The file url.
+     - Returns: The value that was replaced, or `nil` if a new url was added.
+     */
+    @discardableResult
+    public mutating func updateValue(_ value: Value, for url: URL) -> Value? {
+        tree.updateValue(value, forKey: Self.key(for: url))
+    }
+
+    /**
+     Removes the specified file url and its associated value.
+
+     - Parameter url: The file url to remove.
+     - Returns: The removed value, or `nil` if the url isn't in the tree.
+     */
+    @discardableResult
+    public mutating func removeValue(for url: URL) -> Value? {
+        tree.removeValue(forKey: Self.key(for: url))
+    }
+
+    /// Removes all urls and values from the tree.
+    public mutating func removeAll(keepingCapacity keepCapacity: Bool = false) {
+        tree.removeAll(keepingCapacity: keepCapacity)
+    }
+
+    /**
+     Returns the urls located inside the specified directory and their values, ordered by their paths.
+
+     - Parameters:
+        - directory: The directory url.
+        - includingDirectory: A Boolean value indicating whether the directory itself should be included if it's in the tree.
+     */
+    public func elements(in directory: URL, includingDirectory: Bool = false) -> [(url: URL, value: Value)] {
+        let key = Self.key(for: directory)
+        return tree.elements(withPrefix: key).compactMap {
+            guard includingDirectory || $0.key != key else { return nil }
+            return (Self.url(for: $0.key), $0.value)
+        }
+    }
+
+    /**
+     Returns the values of the urls located inside the specified directory, ordered by their paths.
+
+     - Parameters:
+        - directory: The directory url.
+        - includingDirectory: A Boolean value indicating whether the value of the directory itself should be included if it's in the tree.
+     */
+    public func values(in directory: URL, includingDirectory: Bool = false) -> [Value] {
+        let key = Self.key(for: directory)
+        let values = tree.values(withPrefix: key)
+        guard !includingDirectory, tree.contains(key) else { return values }
+        // The directory itself is always the first result of its prefix query.
+        return Array(values.dropFirst())
+    }
+
+    /**
+     Returns the deepest url in the tree that is the specified url or one of its parent directories, and its value.
+
+     - Parameter url: The file url.
+     */
+    public func nearestAncestor(of url: URL) -> (url: URL, value: Value)? {
+        guard let match = tree.longestPrefixMatch(for: Self.key(for: url)) else { return nil }
+        return (Self.url(for: match.key), match.value)
+    }
+
+    /**
+     Returns a Boolean value indicating whether the tree contains the specified url or any of its parent directories.
+
+     - Parameter url: The file url.
+     - Complexity: `O(m)`, where `m` is the length of the path in bytes.
+     */
+    public func containsAncestor(of url: URL) -> Bool {
+        tree.longestPrefixMatch(for: Self.key(for: url)) != nil
+    }
+
+    /// The urls of the tree, ordered by their paths.
+    public var urls: [URL] {
+        map { $0.url }
+    }
+}
+
+extension PathTree: Sequence {
+    /// An iterator over the elements of a path tree, ordered by their paths.
+    public struct Iterator: IteratorProtocol {
+        var iterator: RadixTree<Value>.Iterator
+
+        public mutating func next() -> (url: URL, value: Value)? {
+            guard let element = iterator.next() else { return nil }
+            return (PathTree.url(for: element.key), element.value)
+        }
+    }
+
+    public func makeIterator() -> Iterator {
+        Iterator(iterator: tree.makeIterator())
+    }
+
+    public var underestimatedCount: Int {
+        count
+    }
+}
+
+extension PathTree {
+    /// Keys are standardized paths that end with a slash, so that a prefix of a key always ends at a path component.
+    static func key(for url: URL) -> String {
+        let path = url.standardizedFileURL.path
+        return path.hasSuffix("/") ? path : path + "/"
+    }
+
+    static func url(for key: String) -> URL {
+        URL(fileURLWithPath: key == "/" ? key : String(key.dropLast()))
+    }
+}
@@ -0,0 +1,434 @@
+//
+//  RadixTree.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ A compressed prefix tree (radix tree) that maps strings to values and supports fast prefix queries.
+
+ Keys are stored as UTF-8 bytes and chains of nodes with a single child are merged into one edge. Looking up, inserting and removing a key is `O(m)`, where `m` is the length of the key in bytes, independently of the number of keys in the tree.
+
+ ```swift
+ var tree: RadixTree<Int> = ["apple": 1, "application": 2, "banana": 3]
+
+ tree.values(withPrefix: "app") // [1, 2]
+ tree.longestPrefixMatch(for: "applesauce") // (key: "apple", value: 1)
+ ```
+
+ Iterating a tree returns its elements ordered by the UTF-8 bytes of their keys.
+ */
+public struct RadixTree<Value> {
+    struct Node {
+        var label: [UInt8]
+        var value: Value?
+        var children: [Int] = []
+        var childBytes: [UInt8] = []
+
+        init(label: [UInt8], value: Value? = nil) {
+            self.label = label
+            self.value = value
+        }
+    }
+
+    var nodes: [Node] = [Node(label: [])]
+    var freeIndexes: [Int] = []
+
+    /// The number of keys in the tree.
+    public private(set) var count: Int = 0
+
+    /// A Boolean value indicating whether the tree is empty.
+    public var isEmpty: Bool {
+        count == 0
+    }
+
+    /// Creates an empty radix tree.
+    public init() {}
+
+    /**
+     Creates a radix tree with the keys and values of the specified dictionary.
+
+     - Parameter dictionary: The dictionary.
+     */
+    public init(_ dictionary: [String: Value]) {
+        for (key, value) in dictionary {
+            updateValue(value, forKey: key)
+        }
+    }
+
+    /// Accesses the value associated with the specified key.
+    public subscript(key: String) -> Value? {
+        get { value(for: key) }
+        set {
+            if let newValue = newValue {
+                updateValue(newValue, forKey: key)
+            } else {
+                removeValue(forKey: key)
+            }
+        }
+    }
+
+    /**
+     Returns the value associated with the specified key.
+
+     - Parameter key: The key.
+     - Complexity: `O(m)`, where `m` is the length of the key in bytes.
+     */
+    public func value(for key: String) -> Value? {
+        Self.withBytes(key) { key in
+            nodeIndex(for: key).flatMap { nodes[$0].value }
+        }
+    }
+
+    /// Returns a Boolean value indicating whether the tree contains the specified key.
+    public func contains(_ key: String) -> Bool {
+        value(for: key) != nil
+    }
+
+    /**
+     Updates the value stored for the specified key, or adds a new key-value pair if the key doesn't exist.
+
+     - Parameters:
+        - value: The new value.
+        - key: The key.
+     - Returns: The value that was replaced, or `nil` if a new key-value pair was added.
+     - Complexity: `O(m)`, where `m` is the length of the key in bytes.
+     */
+    @discardableResult
+    public mutating func updateValue(_ value: Value, forKey key: String) -> Value? {
+        Self.withBytes(key) { key in
+            var node = 0
+            var offset = 0
+            while offset < key.count {
+                let (position, found) = childPosition(of: node, for: key[offset])
+                guard found else {
+                    let child = makeNode(label: Array(key[offset...]), value: value)
+                    nodes[node].children.insert(child, at: position)
+                    nodes[node].childBytes.insert(key[offset], at: position)
+                    count += 1
+                    return nil
+                }
+                let child = nodes[node].children[position]
+                let common = commonPrefixLength(nodes[child].label, key, offset)
+                if common < nodes[child].label.count {
+                    // Splits the edge at the first differing byte.
+                    let label = nodes[child].label
+                    let intermediate = makeNode(label: Array(label[..<common]))
+                    nodes[child].label = Array(label[common...])
+                    nodes[intermediate].children = [child]
+                    nodes[intermediate].childBytes = [label[common]]
+                    nodes[node].children[position] = intermediate
+                    node = intermediate
+                } else {
+                    node = child
+                }
+                offset += common
+            }
+            let oldValue = nodes[node].value
+            nodes[node].value = value
+            if oldValue == nil {
+                count += 1
+            }
+            return oldValue
+        }
+    }
+
+    /**
+     Removes the specified key and its associated value.
+
+     - Parameter key: The key to remove.
+     - Returns: The removed value, or `nil` if the key isn't in the tree.
+     - Complexity: `O(m)`, where `m` is the length of the key in bytes.
+     */
+    @discardableResult
+    public mutating func removeValue(forKey key: String) -> Value? {
+        Self.withBytes(key) { key in
+            var path: [(node: Int, position: Int)] = []
+            var node = 0
+            var offset = 0
+            while offset < key.count {
+                let (position, found) = childPosition(of: node, for: key[offset])
+                guard found else { return nil }
+                let child = nodes[node].children[position]
+                let label = nodes[child].label
+                guard key.count - offset >= label.count, commonPrefixLength(label, key, offset) == label.count else { return nil }
+                path.append((node, position))
+                node = child
+                offset += label.count
+            }
+            guard let value = nodes[node].value else { return nil }
+            nodes[node].value = nil
+            count -= 1
+
+            guard let (parent, position) = path.last else { return value }
+            if nodes[node].children.isEmpty {
+                nodes[parent].children.remove(at: position)
+                nodes[parent].childBytes.remove(at: position)
+                freeNode(node)
+                if parent != 0, nodes[parent].value == nil, nodes[parent].children.count == 1 {
+                    mergeWithChild(parent)
+                }
+            } else if nodes[node].children.count == 1 {
+                mergeWithChild(node)
+            }
+            return value
+        }
+    }
+
+    /// Removes all keys and values from the tree.
+    public mutating func removeAll(keepingCapacity keepCapacity: Bool = false) {
+        nodes.removeAll(keepingCapacity: keepCapacity)
+        nodes.append(Node(label: []))
+        freeIndexes.removeAll(keepingCapacity: keepCapacity)
+        count = 0
+    }
+
+    /**
+     Returns the values of all keys that start with the specified prefix, ordered by their keys.
+
+     - Parameters:
+        - prefix: The prefix.
+        - limit: The maximum number of values to return, or `nil` to return all matching values.
+     - Complexity: `O(m + k)`, where `m` is the length of the prefix in bytes and `k` is the number of nodes below the prefix.
+     */
+    public func values(withPrefix prefix: String, limit: Int? = nil) -> [Value] {
+        var values: [Value] = []
+        let limit = limit ?? .max
+        guard limit > 0, let (node, _) = subtree(withPrefix: prefix) else { return values }
+        var stack = [node]
+        while let node = stack.popLast() {
+            if let value = nodes[node].value {
+                values.append(value)
+                if values.count >= limit { break }
+            }
+            stack.append(contentsOf: nodes[node].children.reversed())
+        }
+        return values
+    }
+
+    /**
+     Returns all keys that start with the specified prefix and their values, ordered by their keys.
+
+     - Parameters:
+        - prefix: The prefix.
+        - limit: The maximum number of elements to return, or `nil` to return all matching elements.
+     - Complexity: `O(m + k)`, where `m` is the length of the prefix in bytes and `k` is the number of nodes below the prefix.
+     */
+    public func elements(withPrefix prefix: String, limit: Int? = nil) -> [(key: String, value: Value)] {
+        let limit = limit ?? .max
+        guard limit > 0, let (node, keyBytes) = subtree(withPrefix: prefix) else { return [] }
+        var elements: [(key: String, value: Value)] = []
+        var iterator = Iterator(self, node: node, keyBytes: keyBytes)
+        while elements.count < limit, let element = iterator.next() {
+            elements.append(element)
+        }
+        return elements
+    }
+
+    /**
+     Returns all keys that start with the specified prefix, ordered by their bytes.
+
+     - Parameters:
+        - prefix: The prefix.
+        - limit: The maximum number of keys to return, or `nil` to return all matching keys.
+     */
+    public func keys(withPrefix prefix: String, limit: Int? = nil) -> [String] {
+        elements(withPrefix: prefix, limit: limit).map { $0.key }
+    }
+
+    /**
+     Returns a Boolean value indicating whether the tree contains any key that starts with the specified prefix.
+
+     - Parameter prefix: The prefix.
+     - Complexity: `O(m)`, where `m` is the length of the prefix in bytes.
+     */
+    public func containsKey(withPrefix prefix: String) -> Bool {
+        subtree(withPrefix: prefix) != nil
+    }
+
+    /**
+     Returns the longest key in the tree that is a prefix of the specified string, and its value.
+
+     ```swift
+     let tree: RadixTree = ["/Users": 1, "/Users/Florian": 2]
+     tree.longestPrefixMatch(for: "/Users/Florian/Documents") // (key: "/Users/Florian", value: 2)
+     ```
+
+     - Parameter string: The string.
+     - Complexity: `O(m)`, where `m` is the length of the string in bytes.
+     */
+    public func longestPrefixMatch(for string: String) -> (key: String, value: Value)? {
+        Self.withBytes(string) { bytes in
+            var node = 0
+            var offset = 0
+            var match: (length: Int, value: Value)? = nodes[0].value.map { (0, $0) }
+            while offset < bytes.count {
+                let (position, found) = childPosition(of: node, for: bytes[offset])
+                guard found else { break }
+                let child = nodes[node].children[position]
+                let label = nodes[child].label
+                guard bytes.count - offset >= label.count, commonPrefixLength(label, bytes, offset) == label.count else { break }
+                node = child
+                offset += label.count
+                if let value = nodes[node].value {
+                    match = (offset, value)
+                }
+            }
+            guard let match = match else { return nil }
+            return (String(decoding: UnsafeBufferPointer(rebasing: bytes[..<match.length]), as: UTF8.self), match.value)
+        }
+    }
+
+    /// The keys of the tree, ordered by their bytes.
+    public var keys: [String] {
+        map { $0.key }
+    }
+
+    /// The values of the tree, ordered by their keys.
+    public var values: [Value] {
+        map { $0.value }
+    }
+}
+
+extension RadixTree: Sequence {
+    /// An iterator over the elements of a radix tree, ordered by the bytes of their keys.
+    public struct Iterator: IteratorProtocol {
+        let tree: RadixTree
+        var stack: [(node: Int, keyLength: Int)]
+        var keyBytes: [UInt8]
+
+        init(_ tree: RadixTree, node: Int = 0, keyBytes: [UInt8] = []) {
+            self.tree = tree
+            self.keyBytes = keyBytes
+            stack = [(node, keyBytes.count - tree.nodes[node].label.count)]
+        }
+
+        public mutating func next() -> (key: String, value: Value)? {
+            while let (node, keyLength) = stack.popLast() {
+                keyBytes.removeSubrange(keyLength...)
+                keyBytes.append(contentsOf: tree.nodes[node].label)
+                for child in tree.nodes[node].children.reversed() {
+                    stack.append((child, keyBytes.count))
+                }
+                if let value = tree.nodes[node].value {
+                    return (String(decoding: keyBytes, as: UTF8.self), value)
+                }
+            }
+            return nil
+        }
+    }
+
+    public func makeIterator() -> Iterator {
+        Iterator(self)
+    }
+
+    public var underestimatedCount: Int {
+        count
+    }
+}
+
+extension RadixTree: ExpressibleByDictionaryLiteral {
+    public init(dictionaryLiteral elements: (String, Value)...) {
+        for (key, value) in elements {
+            updateValue(value, forKey: key)
+        }
+    }
+}
+
+extension RadixTree {
+    @inline(__always)
+    static func withBytes<Result>(_ string: String, _ body: (UnsafeBufferPointer<UInt8>) throws -> Result) rethrows -> Result {
+        var string = string
+        return try string.withUTF8(body)
+    }
+
+    @inline(__always)
+    func childPosition(of node: Int, for byte: UInt8) -> (position: Int, found: Bool) {
+        let childBytes = nodes[node].childBytes
+        var low = 0
+        var high = childBytes.count
+        while low < high {
+            let mid = (low + high) / 2
+            if childBytes[mid] < byte {
+                low = mid + 1
+            } else {
+                high = mid
+            }
+        }
+        return (low, low < childBytes.count && childBytes[low] == byte)
+    }
+
+    @inline(__always)
+    func commonPrefixLength(_ label: [UInt8], _ bytes: UnsafeBufferPointer<UInt8>, _ offset: Int) -> Int {
+        let length = Swift.min(label.count, bytes.count - offset)
+        var index = 0
+        while index < length, label[index] == bytes[offset + index] {
+            index += 1
+        }
+        return index
+    }
+
+    func nodeIndex(for key: UnsafeBufferPointer<UInt8>) -> Int? {
+        var node = 0
+        var offset = 0
+        while offset < key.count {
+            let (position, found) = childPosition(of: node, for: key[offset])
+            guard found else { return nil }
+            let child = nodes[node].children[position]
+            let label = nodes[child].label
+            guard key.count - offset >= label.count, commonPrefixLength(label, key, offset) == label.count else { return nil }
+            node = child
+            offset += label.count
+        }
+        return node
+    }
+
+    /// Returns the topmost node whose keys all start with the prefix, and the key bytes of that node.
+    func subtree(withPrefix prefix: String) -> (node: Int, keyBytes: [UInt8])? {
+        Self.withBytes(prefix) { prefix in
+            var node = 0
+            var offset = 0
+            var keyBytes: [UInt8] = []
+            while offset < prefix.count {
+                let (position, found) = childPosition(of: node, for: prefix[offset])
+                guard found else { return nil }
+                let child = nodes[node].children[position]
+                let label = nodes[child].label
+                let common = commonPrefixLength(label, prefix, offset)
+                guard common == label.count || offset + common == prefix.count else { return nil }
+                keyBytes.append(contentsOf: label)
+                node = child
+                offset += label.count
+            }
+            guard node != 0 || count > 0 else { return nil }
+            return (node, keyBytes)
+        }
+    }
+
+    mutating func makeNode(label: [UInt8], value: Value? = nil) -> Int {
+        if let index = freeIndexes.popLast() {
+            nodes[index] = Node(label: label, value: value)
+            return index
+        }
+        nodes.append(Node(label: label, value: value))
+        return nodes.count - 1
+    }
+
+    mutating func freeNode(_ index: Int) {
+        nodes[index] = Node(label: [])
+        freeIndexes.append(index)
+    }
+
+    /// Merges the node with its only child.
+    mutating func mergeWithChild(_ node: Int) {
+        let child = nodes[node].children[0]
+        nodes[node].label.append(contentsOf: nodes[child].label)
+        nodes[node].value = nodes[child].value
+        nodes[node].children = nodes[child].children
+        nodes[node].childBytes = nodes[child].childBytes
+        freeNode(child)
+    }
+}
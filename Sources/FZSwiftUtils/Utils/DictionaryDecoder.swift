@@ -0,0 +1,452 @@
+//
+//  DictionaryDecoder.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ A decoder that decodes values directly from dictionaries.
+
+ Unlike converting a dictionary with `JSONSerialization` and decoding the data with `JSONDecoder`, the values are read directly from the dictionary. The decoder uses the same strategies as `JSONDecoder`. Like `JSONDecoder`, the keys of `[String: Value]` dictionaries aren't converted with the key decoding strategy.
+
+ The dictionary can contain property list values that aren't valid JSON, like `Date` and `Data`, which are decoded as they are. Numbers are decoded to any numeric type that represents them exactly, and `Bool` only from Boolean values, like `JSONDecoder` does.
+
+ ```swift
+ let properties = try DictionaryDecoder().decode(ImageProperties.self, from: dictionary)
+ ```
+ */
+public final class DictionaryDecoder {
+    /// The strategy used when decoding dates. The default value is `deferredToDate`.
+    public var dateDecodingStrategy: JSONDecoder.DateDecodingStrategy = .deferredToDate
+
+    /// The strategy used when decoding data. The default value is `base64`.
+    public var dataDecodingStrategy: JSONDecoder.DataDecodingStrategy = .base64
+
+    /// The strategy used when decoding keys. The default value is `useDefaultKeys`.
+    public var keyDecodingStrategy: JSONDecoder.KeyDecodingStrategy = .useDefaultKeys
+
+    /// The strategy used when decoding infinite and NaN floating point values from strings. The default value is `throw`.
+    public var nonConformingFloatDecodingStrategy: JSONDecoder.NonConformingFloatDecodingStrategy = .throw
+
+    /// Contextual information to customize the decoding.
+    public var userInfo: [CodingUserInfoKey: Any] = [:]
+
+    /**
+     Creates a dictionary decoder with the specified strategies.
+
+     - Parameters:
+        - dateDecodingStrategy: The strategy used when decoding dates.
+        - dataDecodingStrategy: The strategy used when decoding data.
+        - keyDecodingStrategy: The strategy used when decoding keys.
+        - nonConformingFloatDecodingStrategy: The strategy used when decoding infinite and NaN floating point values from strings.
+     */
+    public init(dateDecodingStrategy: JSONDecoder.DateDecodingStrategy = .deferredToDate, dataDecodingStrategy: JSONDecoder.DataDecodingStrategy = .base64, keyDecodingStrategy: JSONDecoder.KeyDecodingStrategy = .useDefaultKeys, nonConformingFloatDecodingStrategy: JSONDecoder.NonConformingFloatDecodingStrategy = .throw) {
+        self.dateDecodingStrategy = dateDecodingStrategy
+        self.dataDecodingStrategy = dataDecodingStrategy
+        self.keyDecodingStrategy = keyDecodingStrategy
+        self.nonConformingFloatDecodingStrategy = nonConformingFloatDecodingStrategy
+    }
+
+    /// Creates a dictionary decoder with the strategies and user info of the specified JSON decoder.
+    public convenience init(_ decoder: JSONDecoder) {
+        self.init(dateDecodingStrategy: decoder.dateDecodingStrategy, dataDecodingStrategy: decoder.dataDecodingStrategy, keyDecodingStrategy: decoder.keyDecodingStrategy, nonConformingFloatDecodingStrategy: decoder.nonConformingFloatDecodingStrategy)
+        userInfo = decoder.userInfo
+    }
+
+    /**
+     Decodes a value of the specified type from the dictionary.
+
+     - Parameters:
+        - type: The type of the value to decode.
+        - dictionary: The dictionary to decode.
+     - Returns: The decoded value.
+     - Throws: Throws if the dictionary doesn't match the type or if an error occurs while decoding.
+     */
+    public func decode<T: Decodable>(_ type: T.Type, from dictionary: [String: Any]) throws -> T {
+        try decode(type, fromObject: dictionary)
+    }
+
+    /**
+     Decodes a value of the specified type from the dictionary.
+
+     - Parameters:
+        - type: The type of the value to decode.
+        - dictionary: The dictionary to decode.
+     - Returns: The decoded value.
+     - Throws: Throws if the dictionary doesn't match the type or if an error occurs while decoding.
+     */
+    public func decode<T: Decodable>(_ type: T.Type, from dictionary: NSDictionary) throws -> T {
+        try decode(type, fromObject: dictionary)
+    }
+
+    /**
+     Decodes a value of the specified type from the dictionary.
+
+     - Parameters:
+        - type: The type of the value to decode.
+        - dictionary: The dictionary to decode.
+     - Returns: The decoded value.
+     - Throws: Throws if the dictionary doesn't match the type or if an error occurs while decoding.
+     */
+    public func decode<T: Decodable>(_ type: T.Type, from dictionary: CFDictionary) throws -> T {
+        try decode(type, fromObject: dictionary as NSDictionary)
+    }
+
+    /**
+     Decodes a value of the specified type from a dictionary, array or single value.
+
+     - Parameters:
+        - type: The type of the value to decode.
+        - object: The object to decode.
+     - Returns: The decoded value.
+     - Throws: Throws if the object doesn't match the type or if an error occurs while decoding.
+     */
+    public func decode<T: Decodable>(_ type: T.Type, fromObject object: Any) throws -> T {
+        try _DictionaryDecoder(value: object, options: options, codingPath: []).unbox(object, as: type)
+    }
+
+    var options: Options {
+        Options(dateDecodingStrategy: dateDecodingStrategy, dataDecodingStrategy: dataDecodingStrategy, keyDecodingStrategy: keyDecodingStrategy, nonConformingFloatDecodingStrategy: nonConformingFloatDecodingStrategy, userInfo: userInfo)
+    }
+
+    struct Options {
+        let dateDecodingStrategy: JSONDecoder.DateDecodingStrategy
+        let dataDecodingStrategy: JSONDecoder.DataDecodingStrategy
+        let keyDecodingStrategy: JSONDecoder.KeyDecodingStrategy
+        let nonConformingFloatDecodingStrategy: JSONDecoder.NonConformingFloatDecodingStrategy
+        let userInfo: [CodingUserInfoKey: Any]
+    }
+}
+
+final class _DictionaryDecoder: Decoder {
+    let value: Any
+    let options: DictionaryDecoder.Options
+    let codingPath: [CodingKey]
+
+    var userInfo: [CodingUserInfoKey: Any] {
+        options.userInfo
+    }
+
+    init(value: Any, options: DictionaryDecoder.Options, codingPath: [CodingKey]) {
+        self.value = value
+        self.options = options
+        self.codingPath = codingPath
+    }
+
+    func container<Key: CodingKey>(keyedBy type: Key.Type) throws -> KeyedDecodingContainer<Key> {
+        guard let dictionary = value as? [String: Any] else {
+            throw typeMismatch([String: Any].self, value, at: codingPath)
+        }
+        return KeyedDecodingContainer(KeyedContainer<Key>(decoder: self, dictionary: convertedKeys(of: dictionary), codingPath: codingPath))
+    }
+
+    func unkeyedContainer() throws -> UnkeyedDecodingContainer {
+        guard let array = value as? [Any] else {
+            throw typeMismatch([Any].self, value, at: codingPath)
+        }
+        return UnkeyedContainer(decoder: self, array: array, codingPath: codingPath)
+    }
+
+    func singleValueContainer() throws -> SingleValueDecodingContainer {
+        self
+    }
+
+    /// Returns the dictionary with its keys converted with the key decoding strategy.
+    func convertedKeys(of dictionary: [String: Any]) -> [String: Any] {
+        switch options.keyDecodingStrategy {
+        case .useDefaultKeys:
+            return dictionary
+        case .convertFromSnakeCase:
+            return Dictionary(dictionary.map { (DictionaryCodingKey.convertFromSnakeCase($0.key), $0.value) }, uniquingKeysWith: { first, _ in first })
+        case .custom(let closure):
+            return Dictionary(dictionary.map { (closure(codingPath + [DictionaryCodingKey(stringValue: $0.key)]).stringValue, $0.value) }, uniquingKeysWith: { first, _ in first })
+        @unknown default:
+            return dictionary
+        }
+    }
+
+    func typeMismatch(_ type: Any.Type, _ value: Any, at codingPath: [CodingKey]) -> DecodingError {
+        let description = value is NSNull ? "Expected \(type) value but found null instead." : "Expected to decode \(type) but found \(Swift.type(of: value)) instead."
+        return value is NSNull ? .valueNotFound(type, .init(codingPath: codingPath, debugDescription: description)) : .typeMismatch(type, .init(codingPath: codingPath, debugDescription: description))
+    }
+
+    /**
+     Decodes a value of the specified type from the value.
+
+     The primitive types are decoded directly, as their `init(from:)` implementation decodes them from a single value container, which calls this method again.
+     */
+    func unbox<T: Decodable>(_ value: Any, as type: T.Type, at codingPath: [CodingKey]? = nil) throws -> T {
+        let codingPath = codingPath ?? self.codingPath
+        switch type {
+        case is String.Type:
+            guard let string = value as? String else { throw typeMismatch(type, value, at: codingPath) }
+            return string as! T
+        case is Bool.Type:
+            guard let bool = Self.boolValue(of: value) else { throw typeMismatch(type, value, at: codingPath) }
+            return bool as! T
+        case is Double.Type:
+            return try unboxDouble(value, as: type, at: codingPath) as! T
+        case is Float.Type:
+            if let float = value as? Float, Self.boolValue(of: value) == nil { return float as! T }
+            return Float(try unboxDouble(value, as: type, at: codingPath)) as! T
+        case is Int.Type: return try unboxInteger(value, as: Int.self, at: codingPath) as! T
+        case is Int8.Type: return try unboxInteger(value, as: Int8.self, at: codingPath) as! T
+        case is Int16.Type: return try unboxInteger(value, as: Int16.self, at: codingPath) as! T
+        case is Int32.Type: return try unboxInteger(value, as: Int32.self, at: codingPath) as! T
+        case is Int64.Type: return try unboxInteger(value, as: Int64.self, at: codingPath) as! T
+        case is UInt.Type: return try unboxInteger(value, as: UInt.self, at: codingPath) as! T
+        case is UInt8.Type: return try unboxInteger(value, as: UInt8.self, at: codingPath) as! T
+        case is UInt16.Type: return try unboxInteger(value, as: UInt16.self, at: codingPath) as! T
+        case is UInt32.Type: return try unboxInteger(value, as: UInt32.self, at: codingPath) as! T
+        case is UInt64.Type: return try unboxInteger(value, as: UInt64.self, at: codingPath) as! T
+        case is Date.Type: return try unboxDate(value, at: codingPath) as! T
+        case is Data.Type: return try unboxData(value, at: codingPath) as! T
+        case is URL.Type:
+            if let url = value as? URL { return url as! T }
+            guard let string = value as? String else { throw typeMismatch(type, value, at: codingPath) }
+            guard let url = URL(string: string) else {
+                throw DecodingError.dataCorrupted(.init(codingPath: codingPath, debugDescription: "Invalid URL string."))
+            }
+            return url as! T
+        case is Decimal.Type:
+            guard let decimal = value as? Decimal ?? (value as? NSNumber)?.decimalValue else { throw typeMismatch(type, value, at: codingPath) }
+            return decimal as! T
+        case let dictionaryType as StringKeyedDictionaryDecodable.Type:
+            // Like `JSONDecoder`, the keys of string keyed dictionaries aren't converted with the key decoding strategy.
+            guard let dictionary = value as? [String: Any] else { throw typeMismatch(type, value, at: codingPath) }
+            var decoded: [String: Any] = [:]
+            decoded.reserveCapacity(dictionary.count)
+            for (key, element) in dictionary {
+                decoded[key] = try unbox(element, as: dictionaryType.valueType, at: codingPath + [DictionaryCodingKey(stringValue: key)])
+            }
+            return decoded as! T
+        default:
+            return try T(from: _DictionaryDecoder(value: value, options: options, codingPath: codingPath))
+        }
+    }
+
+    /// Returns the Boolean value of the value, or `nil` if it's a number or no Boolean value.
+    static func boolValue(of value: Any) -> Bool? {
+        #if canImport(Darwin)
+        guard let number = value as? NSNumber, CFGetTypeID(number) == CFBooleanGetTypeID() else { return nil }
+        return number.boolValue
+        #else
+        if let number = value as? NSNumber {
+            return String(cString: number.objCType) == "c" ? number.boolValue : nil
+        }
+        return value as? Bool
+        #endif
+    }
+
+    func unboxDouble<T>(_ value: Any, as type: T.Type, at codingPath: [CodingKey]) throws -> Double {
+        if let double = value as? Double ?? (value as? NSNumber)?.doubleValue, Self.boolValue(of: value) == nil {
+            return double
+        }
+        if let string = value as? String, case .convertFromString(let positiveInfinity, let negativeInfinity, let nan) = options.nonConformingFloatDecodingStrategy {
+            switch string {
+            case positiveInfinity: return .infinity
+            case negativeInfinity: return -.infinity
+            case nan: return .nan
+            default: break
+            }
+        }
+        throw typeMismatch(type, value, at: codingPath)
+    }
+
+    func unboxInteger<T: FixedWidthInteger>(_ value: Any, as type: T.Type, at codingPath: [CodingKey]) throws -> T {
+        guard Self.boolValue(of: value) == nil else {
+            throw typeMismatch(type, value, at: codingPath)
+        }
+        if let integer = value as? T {
+            return integer
+        }
+        guard let number = value as? NSNumber else {
+            throw typeMismatch(type, value, at: codingPath)
+        }
+        // Integers are converted from their 64-bit value, as doubles can't represent all integers above 2^53.
+        let integer: T?
+        switch String(cString: number.objCType) {
+        case "d", "f": integer = T(exactly: number.doubleValue)
+        case "Q": integer = T(exactly: number.uint64Value)
+        default: integer = T(exactly: number.int64Value)
+        }
+        guard let integer = integer else {
+            throw DecodingError.dataCorrupted(.init(codingPath: codingPath, debugDescription: "Parsed number <\(number)> does not fit in \(type)."))
+        }
+        return integer
+    }
+
+    func unboxDate(_ value: Any, at codingPath: [CodingKey]) throws -> Date {
+        if let date = value as? Date {
+            return date
+        }
+        switch options.dateDecodingStrategy {
+        case .deferredToDate:
+            return try Date(from: _DictionaryDecoder(value: value, options: options, codingPath: codingPath))
+        case .secondsSince1970:
+            return Date(timeIntervalSince1970: try unbox(value, as: Double.self, at: codingPath))
+        case .millisecondsSince1970:
+            return Date(timeIntervalSince1970: try unbox(value, as: Double.self, at: codingPath) / 1000.0)
+        case .iso8601:
+            guard let date = ISO8601DateFormatter().date(from: try unbox(value, as: String.self, at: codingPath)) else {
+                throw DecodingError.dataCorrupted(.init(codingPath: codingPath, debugDescription: "Expected date string to be ISO8601-formatted."))
+            }
+            return date
+        case .formatted(let formatter):
+            guard let date = formatter.date(from: try unbox(value, as: String.self, at: codingPath)) else {
+                throw DecodingError.dataCorrupted(.init(codingPath: codingPath, debugDescription: "Date string does not match format expected by formatter."))
+            }
+            return date
+        case .custom(let closure):
+            return try closure(_DictionaryDecoder(value: value, options: options, codingPath: codingPath))
+        @unknown default:
+            return try Date(from: _DictionaryDecoder(value: value, options: options, codingPath: codingPath))
+        }
+    }
+
+    func unboxData(_ value: Any, at codingPath: [CodingKey]) throws -> Data {
+        if let data = value as? Data {
+            return data
+        }
+        switch options.dataDecodingStrategy {
+        case .deferredToData:
+            return try Data(from: _DictionaryDecoder(value: value, options: options, codingPath: codingPath))
+        case .base64:
+            guard let data = Data(base64Encoded: try unbox(value, as: String.self, at: codingPath)) else {
+                throw DecodingError.dataCorrupted(.init(codingPath: codingPath, debugDescription: "Encountered Data is not valid Base64."))
+            }
+            return data
+        case .custom(let closure):
+            return try closure(_DictionaryDecoder(value: value, options: options, codingPath: codingPath))
+        @unknown default:
+            return try Data(from: _DictionaryDecoder(value: value, options: options, codingPath: codingPath))
+        }
+    }
+}
+
+extension _DictionaryDecoder: SingleValueDecodingContainer {
+    func decodeNil() -> Bool {
+        value is NSNull
+    }
+
+    func decode<T: Decodable>(_ type: T.Type) throws -> T {
+        try unbox(value, as: type)
+    }
+}
+
+extension _DictionaryDecoder {
+    struct KeyedContainer<Key: CodingKey>: KeyedDecodingContainerProtocol {
+        let decoder: _DictionaryDecoder
+        let dictionary: [String: Any]
+        let codingPath: [CodingKey]
+
+        var allKeys: [Key] {
+            dictionary.keys.compactMap { Key(stringValue: $0) }
+        }
+
+        func contains(_ key: Key) -> Bool {
+            dictionary[key.stringValue] != nil
+        }
+
+        func value(forKey key: Key) throws -> Any {
+            guard let value = dictionary[key.stringValue] else {
+                throw DecodingError.keyNotFound(key, .init(codingPath: codingPath, debugDescription: "No value associated with key \(key.stringValue)."))
+            }
+            return value
+        }
+
+        func decodeNil(forKey key: Key) throws -> Bool {
+            try value(forKey: key) is NSNull
+        }
+
+        func decode<T: Decodable>(_ type: T.Type, forKey key: Key) throws -> T {
+            try decoder.unbox(value(forKey: key), as: type, at: codingPath + [key])
+        }
+
+        func decodeIfPresent<T: Decodable>(_ type: T.Type, forKey key: Key) throws -> T? {
+            guard let value = dictionary[key.stringValue], !(value is NSNull) else { return nil }
+            return try decoder.unbox(value, as: type, at: codingPath + [key])
+        }
+
+        func nestedContainer<NestedKey: CodingKey>(keyedBy type: NestedKey.Type, forKey key: Key) throws -> KeyedDecodingContainer<NestedKey> {
+            try _DictionaryDecoder(value: value(forKey: key), options: decoder.options, codingPath: codingPath + [key]).container(keyedBy: type)
+        }
+
+        func nestedUnkeyedContainer(forKey key: Key) throws -> UnkeyedDecodingContainer {
+            try _DictionaryDecoder(value: value(forKey: key), options: decoder.options, codingPath: codingPath + [key]).unkeyedContainer()
+        }
+
+        func superDecoder() throws -> Decoder {
+            _DictionaryDecoder(value: dictionary[DictionaryCodingKey.superKey.stringValue] ?? NSNull(), options: decoder.options, codingPath: codingPath + [DictionaryCodingKey.superKey])
+        }
+
+        func superDecoder(forKey key: Key) throws -> Decoder {
+            _DictionaryDecoder(value: dictionary[key.stringValue] ?? NSNull(), options: decoder.options, codingPath: codingPath + [key])
+        }
+    }
+
+    struct UnkeyedContainer: UnkeyedDecodingContainer {
+        let decoder: _DictionaryDecoder
+        let array: [Any]
+        let codingPath: [CodingKey]
+        var currentIndex = 0
+
+        init(decoder: _DictionaryDecoder, array: [Any], codingPath: [CodingKey]) {
+            self.decoder = decoder
+            self.array = array
+            self.codingPath = codingPath
+        }
+
+        var count: Int? {
+            array.count
+        }
+
+        var isAtEnd: Bool {
+            currentIndex >= array.count
+        }
+
+        var currentCodingPath: [CodingKey] {
+            codingPath + [DictionaryCodingKey(index: currentIndex)]
+        }
+
+        func currentValue<T>(_ type: T.Type) throws -> Any {
+            guard !isAtEnd else {
+                throw DecodingError.valueNotFound(type, .init(codingPath: currentCodingPath, debugDescription: "Unkeyed container is at end."))
+            }
+            return array[currentIndex]
+        }
+
+        mutating func decodeNil() throws -> Bool {
+            guard try currentValue(Any?.self) is NSNull else { return false }
+            currentIndex += 1
+            return true
+        }
+
+        mutating func decode<T: Decodable>(_ type: T.Type) throws -> T {
+            let value = try decoder.unbox(currentValue(type), as: type, at: currentCodingPath)
+            currentIndex += 1
+            return value
+        }
+
+        mutating func nestedContainer<NestedKey: CodingKey>(keyedBy type: NestedKey.Type) throws -> KeyedDecodingContainer<NestedKey> {
+            let container = try _DictionaryDecoder(value: currentValue(type), options: decoder.options, codingPath: currentCodingPath).container(keyedBy: type)
+            currentIndex += 1
+            return container
+        }
+
+        mutating func nestedUnkeyedContainer() throws -> UnkeyedDecodingContainer {
+            let container = try _DictionaryDecoder(value: currentValue([Any].self), options: decoder.options, codingPath: currentCodingPath).unkeyedContainer()
+            currentIndex += 1
+            return container
+        }
+
+        mutating func superDecoder() throws -> Decoder {
+            let superDecoder = _DictionaryDecoder(value: try currentValue(Any.self), options: decoder.options, codingPath: currentCodingPath)
+            currentIndex += 1
+            return superDecoder
+        }
+    }
+}
@@ -0,0 +1,440 @@
+//
+//  DictionaryEncoder.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ An encoder that encodes values directly to dictionaries.
+
+ Unlike encoding a value with `JSONEncoder` and converting the data with `JSONSerialization`, the values are written directly to the dictionary. The encoder uses the same strategies as `JSONEncoder`, and numbers are stored as `NSNumber` like `JSONSerialization` stores them, so the dictionaries are the same as the ones of the JSON round trip: Like `JSONEncoder`, the keys of `[String: Value]` dictionaries aren't converted with the key encoding strategy, and non-finite floating point values throw unless ``nonConformingFloatEncodingStrategy`` converts them to strings.
+
+ ```swift
+ let dictionary = try DictionaryEncoder().encode(options)
+ ```
+ */
+public final class DictionaryEncoder {
+    /// The strategy used when encoding dates. The default value is `deferredToDate`.
+    public var dateEncodingStrategy: JSONEncoder.DateEncodingStrategy = .deferredToDate
+
+    /// The strategy used when encoding data. The default value is `base64`.
+    public var dataEncodingStrategy: JSONEncoder.DataEncodingStrategy = .base64
+
+    /// The strategy used when encoding keys. The default value is `useDefaultKeys`.
+    public var keyEncodingStrategy: JSONEncoder.KeyEncodingStrategy = .useDefaultKeys
+
+    /// The strategy used when encoding infinite and NaN floating point values. The default value is `throw`.
+    public var nonConformingFloatEncodingStrategy: JSONEncoder.NonConformingFloatEncodingStrategy = .throw
+
+    /// Contextual information to customize the encoding.
+    public var userInfo: [CodingUserInfoKey: Any] = [:]
+
+    /**
+     Creates a dictionary encoder with the specified strategies.
+
+     - Parameters:
+        - dateEncodingStrategy: The strategy used when encoding dates.
+        - dataEncodingStrategy: The strategy used when encoding data.
+        - keyEncodingStrategy: The strategy used when encoding keys.
+        - nonConformingFloatEncodingStrategy: The strategy used when encoding infinite and NaN floating point values.
+     */
+    public init(dateEncodingStrategy: JSONEncoder.DateEncodingStrategy = .deferredToDate, dataEncodingStrategy: JSONEncoder.DataEncodingStrategy = .base64, keyEncodingStrategy: JSONEncoder.KeyEncodingStrategy = .useDefaultKeys, nonConformingFloatEncodingStrategy: JSONEncoder.NonConformingFloatEncodingStrategy = .throw) {
+        self.dateEncodingStrategy = dateEncodingStrategy
+        self.dataEncodingStrategy = dataEncodingStrategy
+        self.keyEncodingStrategy = keyEncodingStrategy
+        self.nonConformingFloatEncodingStrategy = nonConformingFloatEncodingStrategy
+    }
+
+    /// Creates a dictionary encoder with the strategies and user info of the specified JSON encoder.
+    public convenience init(_ encoder: JSONEncoder) {
+        self.init(dateEncodingStrategy: encoder.dateEncodingStrategy, dataEncodingStrategy: encoder.dataEncodingStrategy, keyEncodingStrategy: encoder.keyEncodingStrategy, nonConformingFloatEncodingStrategy: encoder.nonConformingFloatEncodingStrategy)
+        userInfo = encoder.userInfo
+    }
+
+    /**
+     Encodes the specified value to a dictionary.
+
+     - Parameter value: The value to encode.
+     - Returns: The dictionary representation of the value.
+     - Throws: Throws if the value doesn't encode to a keyed container or if an error occurs while encoding.
+     */
+    public func encode<T: Encodable>(_ value: T) throws -> [String: Any] {
+        guard let dictionary = try encodeToObject(value) as? [String: Any] else {
+            throw EncodingError.invalidValue(value, .init(codingPath: [], debugDescription: "Top-level \(T.self) did not encode to a dictionary."))
+        }
+        return dictionary
+    }
+
+    /**
+     Encodes the specified value to a dictionary, array or single value.
+
+     - Parameter value: The value to encode.
+     - Returns: The encoded object. Dictionaries are returned as `[String: Any]`, arrays as `[Any]` and `nil` values as `NSNull`.
+     - Throws: Throws if an error occurs while encoding.
+     */
+    public func encodeToObject<T: Encodable>(_ value: T) throws -> Any {
+        let encoder = _DictionaryEncoder(options: options, codingPath: [])
+        return _DictionaryEncoder.resolve(try encoder.box(value))
+    }
+
+    var options: Options {
+        Options(dateEncodingStrategy: dateEncodingStrategy, dataEncodingStrategy: dataEncodingStrategy, keyEncodingStrategy: keyEncodingStrategy, nonConformingFloatEncodingStrategy: nonConformingFloatEncodingStrategy, userInfo: userInfo)
+    }
+
+    struct Options {
+        let dateEncodingStrategy: JSONEncoder.DateEncodingStrategy
+        let dataEncodingStrategy: JSONEncoder.DataEncodingStrategy
+        let keyEncodingStrategy: JSONEncoder.KeyEncodingStrategy
+        let nonConformingFloatEncodingStrategy: JSONEncoder.NonConformingFloatEncodingStrategy
+        let userInfo: [CodingUserInfoKey: Any]
+    }
+}
+
+/// A dictionary that is filled by a keyed encoding container.
+final class EncodedDictionary {
+    var values: [String: Any] = [:]
+}
+
+/// An array that is filled by an unkeyed encoding container.
+final class EncodedArray {
+    var values: [Any] = []
+}
+
+/// A value that is set by a nested encoder.
+final class EncodedReference {
+    var value: Any?
+}
+
+final class _DictionaryEncoder: Encoder {
+    let options: DictionaryEncoder.Options
+    let codingPath: [CodingKey]
+    let reference = EncodedReference()
+
+    var userInfo: [CodingUserInfoKey: Any] {
+        options.userInfo
+    }
+
+    init(options: DictionaryEncoder.Options, codingPath: [CodingKey]) {
+        self.options = options
+        self.codingPath = codingPath
+    }
+
+    func container<Key: CodingKey>(keyedBy type: Key.Type) -> KeyedEncodingContainer<Key> {
+        let dictionary: EncodedDictionary
+        if let existing = reference.value as? EncodedDictionary {
+            dictionary = existing
+        } else {
+            dictionary = EncodedDictionary()
+            reference.value = dictionary
+        }
+        return KeyedEncodingContainer(KeyedContainer(encoder: self, dictionary: dictionary, codingPath: codingPath))
+    }
+
+    func unkeyedContainer() -> UnkeyedEncodingContainer {
+        let array: EncodedArray
+        if let existing = reference.value as? EncodedArray {
+            array = existing
+        } else {
+            array = EncodedArray()
+            reference.value = array
+        }
+        return UnkeyedContainer(encoder: self, array: array, codingPath: codingPath)
+    }
+
+    func singleValueContainer() -> SingleValueEncodingContainer {
+        self
+    }
+
+    /// Returns the value with all encoding containers replaced by their dictionaries and arrays.
+    static func resolve(_ value: Any?) -> Any {
+        switch value {
+        case let dictionary as EncodedDictionary:
+            return dictionary.values.mapValues { resolve($0) }
+        case let array as EncodedArray:
+            return array.values.map { resolve($0) }
+        case let reference as EncodedReference:
+            return resolve(reference.value)
+        case .some(let value):
+            return value
+        case .none:
+            return NSNull()
+        }
+    }
+
+    /**
+     Returns the encoded representation of the value.
+
+     The primitive types are returned directly, as their `encode(to:)` implementation encodes them to a single value container, which calls this method again. Like `JSONSerialization`, numbers are returned as `NSNumber`, so they can be cast to any numeric type that represents them, and `Float` values are widened to the `Double` value of their decimal description.
+     */
+    func box<T: Encodable>(_ value: T, at codingPath: [CodingKey]? = nil) throws -> Any {
+        switch value {
+        case let value as String: return value
+        case let value as Bool: return value
+        case let value as Int: return NSNumber(value: value)
+        case let value as Double: return try box(value, as: value, at: codingPath ?? self.codingPath)
+        case let value as Float: return try box(Double(value.description) ?? Double(value), as: value, at: codingPath ?? self.codingPath)
+        case let value as Int8: return NSNumber(value: value)
+        case let value as Int16: return NSNumber(value: value)
+        case let value as Int32: return NSNumber(value: value)
+        case let value as Int64: return NSNumber(value: value)
+        case let value as UInt: return NSNumber(value: value)
+        case let value as UInt8: return NSNumber(value: value)
+        case let value as UInt16: return NSNumber(value: value)
+        case let value as UInt32: return NSNumber(value: value)
+        case let value as UInt64: return NSNumber(value: value)
+        case let value as Date: return try box(value, at: codingPath ?? self.codingPath)
+        case let value as Data: return try box(value, at: codingPath ?? self.codingPath)
+        case let value as URL: return value.absoluteString
+        case let value as Decimal: return NSDecimalNumber(decimal: value)
+        case let value as StringKeyedDictionaryEncodable:
+            // Like `JSONEncoder`, the keys of string keyed dictionaries aren't converted with the key encoding strategy.
+            let codingPath = codingPath ?? self.codingPath
+            let dictionary = EncodedDictionary()
+            for (key, element) in value as! [String: Encodable] {
+                dictionary.values[key] = try box(element, at: codingPath + [DictionaryCodingKey(stringValue: key)])
+            }
+            return dictionary
+        default:
+            let encoder = _DictionaryEncoder(options: options, codingPath: codingPath ?? self.codingPath)
+            try value.encode(to: encoder)
+            return encoder.reference.value ?? EncodedDictionary()
+        }
+    }
+
+    /// Returns the floating point value as `NSNumber`, or the string of the non-conforming float encoding strategy if it's infinite or NaN.
+    func box<T: Encodable>(_ double: Double, as value: T, at codingPath: [CodingKey]) throws -> Any {
+        guard !double.isFinite else { return NSNumber(value: double) }
+        guard case .convertToString(let positiveInfinity, let negativeInfinity, let nan) = options.nonConformingFloatEncodingStrategy else {
+            throw EncodingError.invalidValue(value, .init(codingPath: codingPath, debugDescription: "Unable to encode \(T.self).\(value) directly. Use the convertToString non-conforming float encoding strategy to specify how the value should be encoded."))
+        }
+        return double.isNaN ? nan : double < 0 ? negativeInfinity : positiveInfinity
+    }
+
+    func box(_ date: Date, at codingPath: [CodingKey]) throws -> Any {
+        switch options.dateEncodingStrategy {
+        case .deferredToDate:
+            return NSNumber(value: date.timeIntervalSinceReferenceDate)
+        case .secondsSince1970:
+            return NSNumber(value: date.timeIntervalSince1970)
+        case .millisecondsSince1970:
+            return NSNumber(value: 1000.0 * date.timeIntervalSince1970)
+        case .iso8601:
+            return ISO8601DateFormatter().string(from: date)
+        case .formatted(let formatter):
+            return formatter.string(from: date)
+        case .custom(let closure):
+            let encoder = _DictionaryEncoder(options: options, codingPath: codingPath)
+            try closure(date, encoder)
+            return encoder.reference.value ?? EncodedDictionary()
+        @unknown default:
+            return NSNumber(value: date.timeIntervalSinceReferenceDate)
+        }
+    }
+
+    func box(_ data: Data, at codingPath: [CodingKey]) throws -> Any {
+        switch options.dataEncodingStrategy {
+        case .deferredToData:
+            return data.map { NSNumber(value: $0) }
+        case .base64:
+            return data.base64EncodedString()
+        case .custom(let closure):
+            let encoder = _DictionaryEncoder(options: options, codingPath: codingPath)
+            try closure(data, encoder)
+            return encoder.reference.value ?? EncodedDictionary()
+        @unknown default:
+            return data.base64EncodedString()
+        }
+    }
+
+    /// Returns the key converted with the key encoding strategy.
+    func convertedKey(_ key: CodingKey, at codingPath: [CodingKey]) -> String {
+        switch options.keyEncodingStrategy {
+        case .useDefaultKeys:
+            return key.stringValue
+        case .convertToSnakeCase:
+            return DictionaryCodingKey.convertToSnakeCase(key.stringValue)
+        case .custom(let closure):
+            return closure(codingPath + [key]).stringValue
+        @unknown default:
+            return key.stringValue
+        }
+    }
+}
+
+extension _DictionaryEncoder: SingleValueEncodingContainer {
+    func encodeNil() throws {
+        reference.value = NSNull()
+    }
+
+    func encode<T: Encodable>(_ value: T) throws {
+        reference.value = try box(value)
+    }
+}
+
+extension _DictionaryEncoder {
+    struct KeyedContainer<Key: CodingKey>: KeyedEncodingContainerProtocol {
+        let encoder: _DictionaryEncoder
+        let dictionary: EncodedDictionary
+        let codingPath: [CodingKey]
+
+        func encodeNil(forKey key: Key) throws {
+            dictionary.values[encoder.convertedKey(key, at: codingPath)] = NSNull()
+        }
+
+        func encode<T: Encodable>(_ value: T, forKey key: Key) throws {
+            dictionary.values[encoder.convertedKey(key, at: codingPath)] = try encoder.box(value, at: codingPath + [key])
+        }
+
+        func nestedContainer<NestedKey: CodingKey>(keyedBy keyType: NestedKey.Type, forKey key: Key) -> KeyedEncodingContainer<NestedKey> {
+            let nested = EncodedDictionary()
+            dictionary.values[encoder.convertedKey(key, at: codingPath)] = nested
+            return KeyedEncodingContainer(KeyedContainer<NestedKey>(encoder: encoder, dictionary: nested, codingPath: codingPath + [key]))
+        }
+
+        func nestedUnkeyedContainer(forKey key: Key) -> UnkeyedEncodingContainer {
+            let nested = EncodedArray()
+            dictionary.values[encoder.convertedKey(key, at: codingPath)] = nested
+            return UnkeyedContainer(encoder: encoder, array: nested, codingPath: codingPath + [key])
+        }
+
+        func superEncoder() -> Encoder {
+            makeSuperEncoder(forKey: DictionaryCodingKey.superKey)
+        }
+
+        func superEncoder(forKey key: Key) -> Encoder {
+            makeSuperEncoder(forKey: key)
+        }
+
+        func makeSuperEncoder(forKey key: CodingKey) -> Encoder {
+            let superEncoder = _DictionaryEncoder(options: encoder.options, codingPath: codingPath + [key])
+            dictionary.values[encoder.convertedKey(key, at: codingPath)] = superEncoder.reference
+            return superEncoder
+        }
+    }
+
+    struct UnkeyedContainer: UnkeyedEncodingContainer {
+        let encoder: _DictionaryEncoder
+        let array: EncodedArray
+        let codingPath: [CodingKey]
+
+        var count: Int {
+            array.values.count
+        }
+
+        var nextCodingPath: [CodingKey] {
+            codingPath + [DictionaryCodingKey(index: count)]
+        }
+
+        func encodeNil() throws {
+            array.values.append(NSNull())
+        }
+
+        func encode<T: Encodable>(_ value: T) throws {
+            array.values.append(try encoder.box(value, at: nextCodingPath))
+        }
+
+        func nestedContainer<NestedKey: CodingKey>(keyedBy keyType: NestedKey.Type) -> KeyedEncodingContainer<NestedKey> {
+            let codingPath = nextCodingPath
+            let nested = EncodedDictionary()
+            array.values.append(nested)
+            return KeyedEncodingContainer(KeyedContainer<NestedKey>(encoder: encoder, dictionary: nested, codingPath: codingPath))
+        }
+
+        func nestedUnkeyedContainer() -> UnkeyedEncodingContainer {
+            let codingPath = nextCodingPath
+            let nested = EncodedArray()
+            array.values.append(nested)
+            return UnkeyedContainer(encoder: encoder, array: nested, codingPath: codingPath)
+        }
+
+        func superEncoder() -> Encoder {
+            let superEncoder = _DictionaryEncoder(options: encoder.options, codingPath: nextCodingPath)
+            array.values.append(superEncoder.reference)
+            return superEncoder
+        }
+    }
+}
+
+/// A dictionary with string keys, whose keys aren't converted with the key encoding strategy.
+protocol StringKeyedDictionaryEncodable {}
+
+extension Dictionary: StringKeyedDictionaryEncodable where Key == String, Value: Encodable {}
+
+/// A dictionary with string keys, whose keys aren't converted with the key decoding strategy.
+protocol StringKeyedDictionaryDecodable {
+    /// The type of the values.
+    static var valueType: Decodable.Type { get }
+}
+
+extension Dictionary: StringKeyedDictionaryDecodable where Key == String, Value: Decodable {
+    static var valueType: Decodable.Type {
+        Value.self
+    }
+}
+
+/// A coding key of a dictionary encoder or decoder.
+struct DictionaryCodingKey: CodingKey {
+    let stringValue: String
+    let intValue: Int?
+
+    init(stringValue: String) {
+        self.stringValue = stringValue
+        intValue = nil
+    }
+
+    init(intValue: Int) {
+        stringValue = "\(intValue)"
+        self.intValue = intValue
+    }
+
+    init(index: Int) {
+        stringValue = "Index \(index)"
+        intValue = index
+    }
+
+    static let superKey = DictionaryCodingKey(stringValue: "super")
+
+    /// Converts a camel case key to snake case, like `JSONEncoder.KeyEncodingStrategy.convertToSnakeCase`.
+    static func convertToSnakeCase(_ key: String) -> String {
+        guard !key.isEmpty else { return key }
+        var words: [Range<String.Index>] = []
+        var wordStart = key.startIndex
+        var searchRange = key.index(after: wordStart) ..< key.endIndex
+        while let upperCaseRange = key.rangeOfCharacter(from: .uppercaseLetters, options: [], range: searchRange) {
+            words.append(wordStart ..< upperCaseRange.lowerBound)
+            searchRange = upperCaseRange.lowerBound ..< searchRange.upperBound
+            guard let lowerCaseRange = key.rangeOfCharacter(from: .lowercaseLetters, options: [], range: searchRange) else {
+                wordStart = searchRange.lowerBound
+                break
+            }
+            let nextCharacterAfterCapital = key.index(after: upperCaseRange.lowerBound)
+            if lowerCaseRange.lowerBound == nextCharacterAfterCapital {
+                wordStart = upperCaseRange.lowerBound
+            } else {
+                let beforeLowerIndex = key.index(before: lowerCaseRange.lowerBound)
+                words.append(upperCaseRange.lowerBound ..< beforeLowerIndex)
+                wordStart = beforeLowerIndex
+            }
+            searchRange = lowerCaseRange.upperBound ..< searchRange.upperBound
+        }
+        words.append(wordStart ..< searchRange.upperBound)
+        return words.map { key[$0].lowercased() }.joined(separator: "_")
+    }
+
+    /// Converts a snake case key to camel case, like `JSONDecoder.KeyDecodingStrategy.convertFromSnakeCase`.
+    static func convertFromSnakeCase(_ key: String) -> String {
+        guard let firstNonUnderscore = key.firstIndex(where: { $0 != "_" }) else { return key }
+        var lastNonUnderscore = key.index(before: key.endIndex)
+        while lastNonUnderscore > firstNonUnderscore, key[lastNonUnderscore] == "_" {
+            key.formIndex(before: &lastNonUnderscore)
+        }
+        let keyRange = firstNonUnderscore ... lastNonUnderscore
+        let components = key[keyRange].split(separator: "_")
+        guard components.count > 1 else { return key }
+        let joined = ([components[0].lowercased()] + components[1...].map(\.capitalized)).joined()
+        return String(key[..<firstNonUnderscore]) + joined + String(key[key.index(after: lastNonUnderscore)...])
+    }
+}
@@ -0,0 +1,457 @@
+//
+//  DirectorySnapshot.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+#if canImport(Darwin)
+import Darwin
+#elseif canImport(Glibc)
+import Glibc
+#endif
+
+/**
+ A snapshot of the items of a directory tree.
+
+ The snapshot stores the path, inode, size, modification date and optionally the ``OSHash`` of every item. It can be written to a compact binary file and read back memory-mapped.
+
+ ``rescan(verifyingFiles:)`` creates an updated snapshot. Directories whose modification date and inode didn't change keep their recorded items, so only their subdirectories are checked again, and ``diff(from:)`` returns the changes between two snapshots:
+
+ ```swift
+ let snapshot = try DirectorySnapshot(contentsOf: snapshotURL)
+ let updatedSnapshot = try snapshot.rescan()
+ let changes = updatedSnapshot.diff(from: snapshot)
+ try updatedSnapshot.write(to: snapshotURL)
+ ```
+ */
+public struct DirectorySnapshot {
+    /// Directory snapshot errors.
+    public enum Errors: Error {
+        /// The url isn't a directory.
+        case invalidDirectory
+        /// The file isn't a directory snapshot.
+        case invalidFile
+        /// The file has been written by an unsupported version.
+        case unsupportedVersion
+    }
+
+    /// An item of the directory tree.
+    public struct Item: Hashable {
+        /// The path of the item relative to the directory of the snapshot, or an empty string for the directory.
+        public let path: String
+        /// A Boolean value indicating whether the item is a directory.
+        public let isDirectory: Bool
+        /// The identifier of the device of the item.
+        public let device: UInt64
+        /// The inode of the item.
+        public let inode: UInt64
+        /// The size of the item, in bytes.
+        public let size: UInt64
+        /// The modification time of the item, in nanoseconds since 1970.
+        let modificationTime: Int64
+        let osHashValue: UInt64?
+
+        /// The modification date of the item.
+        public var modificationDate: Date {
+            Date(timeIntervalSince1970: TimeInterval(modificationTime) / 1_000_000_000)
+        }
+
+        /// The OpenSubtitle hash of the file, or `nil` if the snapshot doesn't include hashes or the file is too small.
+        public var osHash: OSHash? {
+            osHashValue.map { OSHash(value: $0) }
+        }
+
+        /// A Boolean value indicating whether the item has the same inode, size and modification date as the other item.
+        func isUnchanged(comparedTo item: Item) -> Bool {
+            inode == item.inode && device == item.device && size == item.size && modificationTime == item.modificationTime && isDirectory == item.isDirectory
+        }
+    }
+
+    /// The changes between two snapshots.
+    public struct Changes: Hashable {
+        /// A moved or renamed item.
+        public struct Move: Hashable {
+            /// The previous url of the item.
+            public let source: URL
+            /// The current url of the item.
+            public let destination: URL
+        }
+
+        /// The urls of the added items.
+        public internal(set) var added: Set<URL> = []
+        /// The urls of the removed items.
+        public internal(set) var removed: Set<URL> = []
+        /// The urls of the modified files.
+        public internal(set) var modified: Set<URL> = []
+        /// The moved items.
+        public internal(set) var moved: Set<Move> = []
+
+        /// A Boolean value indicating whether there aren't any changes.
+        public var isEmpty: Bool {
+            added.isEmpty && removed.isEmpty && modified.isEmpty && moved.isEmpty
+        }
+    }
+
+    /// The url of the directory.
+    public let url: URL
+
+    /// A Boolean value indicating whether the snapshot includes the OpenSubtitle hash of the files.
+    public let includesHashes: Bool
+
+    /// A Boolean value indicating whether the snapshot includes hidden items.
+    public let includesHiddenFiles: Bool
+
+    /// The items of the directory tree in depth-first order, starting with the directory itself.
+    public let items: [Item]
+
+    /**
+     Creates a snapshot of the directory tree at the specified url.
+
+     - Parameters:
+        - url: The url of the directory.
+        - includesHashes: A Boolean value indicating whether to include the OpenSubtitle hash of the files.
+        - includesHiddenFiles: A Boolean value indicating whether to include hidden items.
+     - Throws: If the url isn't a directory.
+     */
+    public init(url: URL, includesHashes: Bool = false, includesHiddenFiles: Bool = true) throws {
+        self.url = url
+        self.includesHashes = includesHashes
+        self.includesHiddenFiles = includesHiddenFiles
+        items = try Scanner(rootPath: url.path, includesHashes: includesHashes, includesHiddenFiles: includesHiddenFiles, verifyingFiles: true, previous: []).scan()
+    }
+
+    init(url: URL, includesHashes: Bool, includesHiddenFiles: Bool, items: [Item]) {
+        self.url = url
+        self.includesHashes = includesHashes
+        self.includesHiddenFiles = includesHiddenFiles
+        self.items = items
+    }
+
+    /**
+     Returns an updated snapshot of the directory tree.
+
+     The items of directories whose inode and modification date didn't change are taken from the snapshot, and only their subdirectories are checked. The modification date of a directory changes when items are added, removed or renamed, but not when a file is modified in place, so modified files in unchanged directories are only detected when `verifyingFiles` is `true`.
+
+     - Parameter verifyingFiles: A Boolean value indicating whether the files of unchanged directories are checked for modifications.
+     - Throws: If the url of the snapshot isn't a directory anymore.
+     */
+    public func rescan(verifyingFiles: Bool = false) throws -> DirectorySnapshot {
+        let items = try Scanner(rootPath: url.path, includesHashes: includesHashes, includesHiddenFiles: includesHiddenFiles, verifyingFiles: verifyingFiles, previous: items).scan()
+        return DirectorySnapshot(url: url, includesHashes: includesHashes, includesHiddenFiles: includesHiddenFiles, items: items)
+    }
+
+    /**
+     Returns the changes from the previous snapshot to this snapshot.
+
+     An added item is returned as moved if a removed item has the same inode, type, size and modification date. Otherwise a reused inode would turn a removed and an unrelated added file into a move. Files with the same path and a different inode, size, modification date or hash are returned as modified.
+
+     - Parameter previous: The previous snapshot of the directory.
+     */
+    public func diff(from previous: DirectorySnapshot) -> Changes {
+        var previousItems: [String: Item] = [:]
+        previousItems.reserveCapacity(previous.items.count)
+        for item in previous.items {
+            previousItems[item.path] = item
+        }
+        var changes = Changes()
+        var addedItems: [Item] = []
+        for item in items {
+            guard let previousItem = previousItems.removeValue(forKey: item.path) else {
+                addedItems.append(item)
+                continue
+            }
+            if !item.isDirectory, !item.isUnchanged(comparedTo: previousItem) || item.osHashValue != previousItem.osHashValue {
+                changes.modified.insert(url(for: item.path))
+            }
+        }
+        // Several removed items can share an inode, like hard links of a file.
+        var removedItems: [FileIdentifier: [Item]] = [:]
+        for item in previousItems.values {
+            removedItems[FileIdentifier(device: item.device, inode: item.inode), default: []].append(item)
+        }
+        for item in addedItems {
+            let identifier = FileIdentifier(device: item.device, inode: item.inode)
+            if let index = removedItems[identifier]?.firstIndex(where: { $0.isDirectory == item.isDirectory && $0.size == item.size && $0.modificationTime == item.modificationTime }),
+               let source = removedItems[identifier]?.remove(at: index) {
+                changes.moved.insert(Changes.Move(source: previous.url(for: source.path), destination: url(for: item.path)))
+            } else {
+                changes.added.insert(url(for: item.path))
+            }
+        }
+        changes.removed = Set(removedItems.values.joined().map { previous.url(for: $0.path) })
+        return changes
+    }
+
+    /// Returns the url of the item with the specified relative path.
+    func url(for path: String) -> URL {
+        path.isEmpty ? url : url.appendingPathComponent(path)
+    }
+
+    struct FileIdentifier: Hashable {
+        let device: UInt64
+        let inode: UInt64
+    }
+}
+
+extension DirectorySnapshot {
+    /// Scans a directory tree, reusing the items of unchanged directories of a previous scan.
+    final class Scanner {
+        let rootPath: String
+        let includesHashes: Bool
+        let includesHiddenFiles: Bool
+        let verifyingFiles: Bool
+        let previous: [Item]
+        var previousIndexes: [String: Int] = [:]
+        /// The index after the last descendant of each previous item.
+        var subtreeEnds: [Int] = []
+        var items: [Item] = []
+
+        init(rootPath: String, includesHashes: Bool, includesHiddenFiles: Bool, verifyingFiles: Bool, previous: [Item]) {
+            self.rootPath = rootPath
+            self.includesHashes = includesHashes
+            self.includesHiddenFiles = includesHiddenFiles
+            self.verifyingFiles = verifyingFiles
+            self.previous = previous
+        }
+
+        func scan() throws -> [Item] {
+            guard let info = Self.status(atPath: rootPath), info.isDirectory else {
+                throw Errors.invalidDirectory
+            }
+            indexPrevious()
+            items.reserveCapacity(previous.count)
+            let previousIndex = previousIndexes[""]
+            scanDirectory(makeItem("", info: info, previousIndex: previousIndex), absolutePath: rootPath, previousIndex: previousIndex)
+            return items
+        }
+
+        func indexPrevious() {
+            guard !previous.isEmpty else { return }
+            previousIndexes.reserveCapacity(previous.count)
+            subtreeEnds = Array(0..<previous.count).map { $0 + 1 }
+            var directories: [Int] = []
+            for (index, item) in previous.enumerated() {
+                previousIndexes[item.path] = index
+                while let directory = directories.last, !isDescendant(item.path, of: previous[directory].path) {
+                    subtreeEnds[directory] = index
+                    directories.removeLast()
+                }
+                if item.isDirectory {
+                    directories.append(index)
+                }
+            }
+            for directory in directories {
+                subtreeEnds[directory] = previous.count
+            }
+        }
+
+        func isDescendant(_ path: String, of directoryPath: String) -> Bool {
+            guard !directoryPath.isEmpty else { return true }
+            return path.count > directoryPath.count && path.hasPrefix(directoryPath) && path.utf8[path.utf8.index(path.utf8.startIndex, offsetBy: directoryPath.utf8.count)] == UInt8(ascii: "/")
+        }
+
+        func scanDirectory(_ directory: Item, absolutePath: String, previousIndex: Int?) {
+            items.append(directory)
+            if let previousIndex = previousIndex, previous[previousIndex].isDirectory, directory.isUnchanged(comparedTo: previous[previousIndex]) {
+                reuseDirectory(at: previousIndex)
+                return
+            }
+            guard let handle = opendir(absolutePath) else { return }
+            var children: [String] = []
+            while let entry = readdir(handle) {
+                guard includesHiddenFiles || entry.pointee.d_name.0 != CChar(UInt8(ascii: ".")) else { continue }
+                let name = withUnsafePointer(to: &entry.pointee.d_name) {
+                    $0.withMemoryRebound(to: CChar.self, capacity: MemoryLayout.size(ofValue: entry.pointee.d_name)) { String(cString: $0) }
+                }
+                guard name != ".", name != ".." else { continue }
+                children.append(name)
+            }
+            closedir(handle)
+            // Sorting the names by their bytes keeps the items in the order of `ParallelDirectoryWalker.sortedEntries()`, and the descendants of each directory contiguous.
+            children.sort { $0.utf8.lexicographicallyPrecedes($1.utf8) }
+            for child in children {
+                let path = directory.path.isEmpty ? child : directory.path + "/" + child
+                let childAbsolutePath = absolutePath + "/" + child
+                guard let info = Self.status(atPath: childAbsolutePath) else { continue }
+                let childPreviousIndex = previousIndexes[path]
+                let item = makeItem(path, info: info, previousIndex: childPreviousIndex)
+                if item.isDirectory {
+                    scanDirectory(item, absolutePath: childAbsolutePath, previousIndex: childPreviousIndex)
+                } else {
+                    items.append(item)
+                }
+            }
+        }
+
+        /// Takes the items of the unchanged directory from the previous scan and scans its subdirectories.
+        func reuseDirectory(at index: Int) {
+            var child = index + 1
+            while child < subtreeEnds[index] {
+                let item = previous[child]
+                let absolutePath = rootPath + "/" + item.path
+                if item.isDirectory {
+                    if let info = Self.status(atPath: absolutePath) {
+                        let updatedItem = makeItem(item.path, info: info, previousIndex: child)
+                        if updatedItem.isDirectory {
+                            scanDirectory(updatedItem, absolutePath: absolutePath, previousIndex: child)
+                        } else {
+                            items.append(updatedItem)
+                        }
+                    }
+                    child = subtreeEnds[child]
+                } else {
+                    if !verifyingFiles {
+                        items.append(item)
+                    } else if let info = Self.status(atPath: absolutePath) {
+                        items.append(makeItem(item.path, info: info, previousIndex: child))
+                    }
+                    child += 1
+                }
+            }
+        }
+
+        func makeItem(_ path: String, info: stat, previousIndex: Int?) -> Item {
+            let isDirectory = info.isDirectory
+            var osHashValue: UInt64?
+            let item = Item(path: path, isDirectory: isDirectory, device: UInt64(info.st_dev), inode: UInt64(info.st_ino), size: isDirectory ? 0 : UInt64(info.st_size), modificationTime: info.modificationTime, osHashValue: nil)
+            guard includesHashes, info.isRegularFile else { return item }
+            if let previousIndex = previousIndex, item.isUnchanged(comparedTo: previous[previousIndex]) {
+                osHashValue = previous[previousIndex].osHashValue
+            } else {
+                osHashValue = (try? OSHash(path: path.isEmpty ? rootPath : rootPath + "/" + path))?.value
+            }
+            return Item(path: path, isDirectory: false, device: item.device, inode: item.inode, size: item.size, modificationTime: item.modificationTime, osHashValue: osHashValue)
+        }
+
+        static func status(atPath path: String) -> stat? {
+            var info = stat()
+            guard lstat(path, &info) == 0 else { return nil }
+            return info
+        }
+    }
+}
+
+extension DirectorySnapshot {
+    static let magic: [UInt8] = Array("FZDS".utf8)
+    static let version: UInt32 = 1
+    static let headerSize = 32
+    static let recordSize = 56
+
+    /*
+     File layout, all integers little endian:
+
+     Header (32 bytes): magic "FZDS", version (UInt32), item count (UInt64), flags (UInt32), root path length (UInt32), string table size (UInt64).
+     Records (56 bytes each): path offset (UInt32), path length (UInt32), flags (UInt32), reserved (UInt32), device, inode, size (UInt64), modification time (Int64), hash (UInt64).
+     String table: the root path followed by the paths of the items.
+     */
+
+    /**
+     Reads a snapshot from the specified file.
+
+     The file is memory-mapped while reading.
+
+     - Parameter fileURL: The url of the snapshot file.
+     - Throws: If the file couldn't be read or isn't a directory snapshot.
+     */
+    public init(contentsOf fileURL: URL) throws {
+        let data = try Data(contentsOf: fileURL, options: .alwaysMapped)
+        self = try data.withUnsafeBytes { try Self.decode($0) }
+    }
+
+    /**
+     Writes the snapshot to the specified file.
+
+     - Parameter fileURL: The url of the file.
+     - Throws: If the file couldn't be written.
+     */
+    public func write(to fileURL: URL) throws {
+        var records = Data()
+        records.reserveCapacity(items.count * Self.recordSize)
+        var strings = Data(url.path.utf8)
+        let rootPathLength = strings.count
+        for item in items {
+            let pathOffset = strings.count
+            strings.append(contentsOf: item.path.utf8)
+            let flags: UInt32 = (item.isDirectory ? 1 : 0) | (item.osHashValue != nil ? 2 : 0)
+            Self.append(UInt32(pathOffset), to: &records)
+            Self.append(UInt32(strings.count - pathOffset), to: &records)
+            Self.append(flags, to: &records)
+            Self.append(UInt32(0), to: &records)
+            Self.append(item.device, to: &records)
+            Self.append(item.inode, to: &records)
+            Self.append(item.size, to: &records)
+            Self.append(item.modificationTime, to: &records)
+            Self.append(item.osHashValue ?? 0, to: &records)
+        }
+        var data = Data(Self.magic)
+        data.reserveCapacity(Self.headerSize + records.count + strings.count)
+        Self.append(Self.version, to: &data)
+        Self.append(UInt64(items.count), to: &data)
+        Self.append(UInt32((includesHashes ? 1 : 0) | (includesHiddenFiles ? 2 : 0)), to: &data)
+        Self.append(UInt32(rootPathLength), to: &data)
+        Self.append(UInt64(strings.count), to: &data)
+        data.append(records)
+        data.append(strings)
+        try data.write(to: fileURL, options: .atomic)
+    }
+
+    static func append<T: FixedWidthInteger>(_ value: T, to data: inout Data) {
+        var value = value.littleEndian
+        withUnsafeBytes(of: &value) { data.append(contentsOf: $0) }
+    }
+
+    static func read<T: FixedWidthInteger>(_ type: T.Type, _ buffer: UnsafeRawBufferPointer, _ offset: Int) -> T {
+        T(littleEndian: buffer.loadUnaligned(fromByteOffset: offset, as: T.self))
+    }
+
+    static func decode(_ buffer: UnsafeRawBufferPointer) throws -> DirectorySnapshot {
+        guard buffer.count >= headerSize, Array(buffer[0..<4]) == magic else { throw Errors.invalidFile }
+        guard read(UInt32.self, buffer, 4) == version else { throw Errors.unsupportedVersion }
+        let flags = read(UInt32.self, buffer, 16)
+        let rootPathLength = Int(read(UInt32.self, buffer, 20))
+        // The counts of a corrupted file can be arbitrary large, so they are checked against the size of the file without overflowing.
+        guard let itemCount = Int(exactly: read(UInt64.self, buffer, 8)),
+              let stringTableSize = Int(exactly: read(UInt64.self, buffer, 24)) else { throw Errors.invalidFile }
+        let recordsSize = itemCount.multipliedReportingOverflow(by: recordSize)
+        let recordsEnd = recordsSize.partialValue.addingReportingOverflow(headerSize)
+        let fileSize = recordsEnd.partialValue.addingReportingOverflow(stringTableSize)
+        guard !recordsSize.overflow, !recordsEnd.overflow, !fileSize.overflow, fileSize.partialValue == buffer.count, rootPathLength <= stringTableSize else { throw Errors.invalidFile }
+        let stringTableOffset = recordsEnd.partialValue
+        func string(at offset: Int, length: Int) -> String {
+            String(decoding: UnsafeRawBufferPointer(rebasing: buffer[(stringTableOffset + offset)..<(stringTableOffset + offset + length)]), as: UTF8.self)
+        }
+        var items: [Item] = []
+        items.reserveCapacity(itemCount)
+        for index in 0..<itemCount {
+            let offset = headerSize + index * recordSize
+            let pathOffset = Int(read(UInt32.self, buffer, offset))
+            let pathLength = Int(read(UInt32.self, buffer, offset + 4))
+            let itemFlags = read(UInt32.self, buffer, offset + 8)
+            guard pathOffset + pathLength <= stringTableSize else { throw Errors.invalidFile }
+            items.append(Item(path: string(at: pathOffset, length: pathLength), isDirectory: itemFlags & 1 != 0, device: read(UInt64.self, buffer, offset + 16), inode: read(UInt64.self, buffer, offset + 24), size: read(UInt64.self, buffer, offset + 32), modificationTime: read(Int64.self, buffer, offset + 40), osHashValue: itemFlags & 2 != 0 ? read(UInt64.self, buffer, offset + 48) : nil))
+        }
+        let url = URL(fileURLWithPath: string(at: 0, length: rootPathLength), isDirectory: true)
+        return DirectorySnapshot(url: url, includesHashes: flags & 1 != 0, includesHiddenFiles: flags & 2 != 0, items: items)
+    }
+}
+
+extension stat {
+    var isDirectory: Bool {
+        st_mode & S_IFMT == S_IFDIR
+    }
+
+    var isRegularFile: Bool {
+        st_mode & S_IFMT == S_IFREG
+    }
+
+    /// The modification time, in nanoseconds since 1970.
+    var modificationTime: Int64 {
+        #if canImport(Darwin)
+        return Int64(st_mtimespec.tv_sec) * 1_000_000_000 + Int64(st_mtimespec.tv_nsec)
+        #else
+        return Int64(st_mtim.tv_sec) * 1_000_000_000 + Int64(st_mtim.tv_nsec)
+        #endif
+    }
+}
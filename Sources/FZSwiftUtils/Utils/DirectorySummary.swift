@@ -0,0 +1,276 @@
+//
+//  DirectorySummary.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+#if canImport(Darwin)
+import Darwin
+#elseif canImport(Glibc)
+import Glibc
+#endif
+
+/**
+ The sizes, file counts and file ages of a directory tree.
+
+ The tree is walked with ``ParallelDirectoryWalker`` and each file is read with a single `lstat` on the walker's workers.
+
+ ```swift
+ let summary = try DirectorySummary(url: downloadsURL)
+ summary.allocatedSize // 12.4 GB
+ summary.fileCounts[.video] // 42
+ summary.largestFiles.first?.url
+ ```
+
+ Files with several hard links are counted once. Sizes only include regular files.
+ */
+public struct DirectorySummary {
+    /// A file of the directory tree.
+    public struct File: Hashable {
+        /// The url of the file.
+        public let url: URL
+        /// The logical size of the file.
+        public let size: DataSize
+        /// The size allocated on disk for the file.
+        public let allocatedSize: DataSize
+        /// The content modification date of the file.
+        public let modificationDate: Date
+    }
+
+    /// The files of a range of modification ages.
+    public struct AgeBucket: Hashable {
+        /// The minimum age of the files.
+        public let minimumAge: TimeDuration
+        /// The maximum age of the files, or `nil` for the bucket of the oldest files.
+        public let maximumAge: TimeDuration?
+        /// The number of files.
+        public internal(set) var fileCount: Int = 0
+        /// The logical size of the files.
+        public internal(set) var size: DataSize = .zero
+    }
+
+    /// The url of the directory.
+    public let url: URL
+
+    /// The logical size of the files.
+    public internal(set) var size: DataSize = .zero
+
+    /// The size allocated on disk for the files.
+    public internal(set) var allocatedSize: DataSize = .zero
+
+    /// The number of files.
+    public internal(set) var fileCount: Int = 0
+
+    /// The number of directories.
+    public internal(set) var directoryCount: Int = 0
+
+    /// The number of symbolic links and other items that aren't files or directories.
+    public internal(set) var otherItemCount: Int = 0
+
+    /// The number of files for their file type. The type of a file is determined by its extension, files without extension are counted as `other("")`.
+    public internal(set) var fileCounts: [URL.FileType: Int] = [:]
+
+    /// The logical size of the files for their file type.
+    public internal(set) var sizes: [URL.FileType: DataSize] = [:]
+
+    /// The largest files, sorted by descending size.
+    public internal(set) var largestFiles: [File] = []
+
+    /// The files grouped by the age of their content modification date.
+    public internal(set) var ageHistogram: [AgeBucket] = []
+
+    /// The default maximum ages of the buckets of ``ageHistogram``.
+    public static let defaultAgeBoundaries: [TimeDuration] = [.days(1), .weeks(1), .days(30), .days(365)]
+
+    /**
+     Summarizes the directory tree at the specified url.
+
+     - Parameters:
+        - url: The url of the directory.
+        - options: The options for walking the directory.
+        - largestFilesCount: The number of largest files to return.
+        - ageBoundaries: The maximum ages of the buckets of ``ageHistogram``. Files older than the last boundary are counted in an additional bucket.
+        - progress: The progress that reports the number of summarized items, or `nil`. Cancelling the progress cancels the summary.
+        - isCancelled: A handler that is periodically called while walking the tree. Return `true` to cancel the summary. It's called from several threads.
+     - Throws: `CancellationError` if the summary is cancelled.
+     */
+    public init(url: URL, options: Set<URL.DirectoryEnumerationOption> = [.includeSubdirectoryDescendants, .includeHiddenFiles], largestFilesCount: Int = 10, ageBoundaries: [TimeDuration] = DirectorySummary.defaultAgeBoundaries, progress: Progress? = nil, isCancelled: (() -> Bool)? = nil) throws {
+        self.url = url
+        let boundaries = ageBoundaries.sorted(by: { $0.seconds < $1.seconds })
+        let walker = ParallelDirectoryWalker(url: url, options: options)
+        let accumulators = (0..<max(1, walker.maxConcurrentDirectoryReads)).map { _ in Accumulator(boundaries: boundaries, largestFilesCount: largestFilesCount) }
+        let hardLinks = HardLinkSet()
+        let counter = ProgressCounter(progress: progress)
+        let now = Date().timeIntervalSince1970
+        var walk: ParallelDirectoryWalker.Walk?
+        walk = ParallelDirectoryWalker.Walk(walker: walker) { entry, worker in
+            let accumulator = accumulators[worker]
+            accumulator.add(entry, now: now, hardLinks: hardLinks)
+            accumulator.pendingProgress += 1
+            if accumulator.pendingProgress == 256 {
+                counter.add(accumulator.pendingProgress)
+                accumulator.pendingProgress = 0
+                if progress?.isCancelled == true || isCancelled?() == true {
+                    walk?.cancel()
+                }
+            }
+        }
+        progress?.isCancellable = true
+        // The handler of the caller is called as well and restored after the walk.
+        let previousCancellationHandler = progress?.cancellationHandler
+        progress?.cancellationHandler = { [weak walk] in
+            walk?.cancel()
+            previousCancellationHandler?()
+        }
+        walk?.run()
+        let wasCancelled = walk?.cancelled == true
+        walk = nil
+        progress?.cancellationHandler = previousCancellationHandler
+        guard !wasCancelled else { throw CancellationError() }
+        counter.add(accumulators.reduce(0) { $0 + $1.pendingProgress })
+
+        var size = 0
+        var allocatedSize = 0
+        var sizes: [URL.FileType: Int] = [:]
+        ageHistogram = (0...boundaries.count).map { AgeBucket(minimumAge: $0 == 0 ? .zero : boundaries[$0 - 1], maximumAge: $0 < boundaries.count ? boundaries[$0] : nil) }
+        var largestFiles: [File] = []
+        for accumulator in accumulators {
+            size += accumulator.size
+            allocatedSize += accumulator.allocatedSize
+            fileCount += accumulator.fileCount
+            directoryCount += accumulator.directoryCount
+            otherItemCount += accumulator.otherItemCount
+            fileCounts.merge(accumulator.fileCounts, uniquingKeysWith: +)
+            sizes.merge(accumulator.sizes, uniquingKeysWith: +)
+            for (index, bucket) in accumulator.ageBuckets.enumerated() {
+                ageHistogram[index].fileCount += bucket.fileCount
+                ageHistogram[index].size = DataSize(ageHistogram[index].size.bytes + bucket.size)
+            }
+            largestFiles += accumulator.largestFiles
+        }
+        self.size = DataSize(size)
+        self.allocatedSize = DataSize(allocatedSize)
+        self.sizes = sizes.mapValues { DataSize($0) }
+        self.largestFiles = Array(largestFiles.sorted(by: { $0.size.bytes > $1.size.bytes }).prefix(largestFilesCount))
+    }
+}
+
+extension DirectorySummary {
+    /// The values summarized by one worker, merged after the walk.
+    final class Accumulator {
+        let boundaries: [Double]
+        let largestFilesCount: Int
+        var size = 0
+        var allocatedSize = 0
+        var fileCount = 0
+        var directoryCount = 0
+        var otherItemCount = 0
+        var fileCounts: [URL.FileType: Int] = [:]
+        var sizes: [URL.FileType: Int] = [:]
+        var ageBuckets: [(fileCount: Int, size: Int)]
+        /// The largest files, sorted by ascending size.
+        var largestFiles: [File] = []
+        var fileTypes: [String: URL.FileType] = [:]
+        var pendingProgress = 0
+
+        init(boundaries: [TimeDuration], largestFilesCount: Int) {
+            self.boundaries = boundaries.map { $0.seconds }
+            self.largestFilesCount = largestFilesCount
+            ageBuckets = Array(repeating: (0, 0), count: boundaries.count + 1)
+        }
+
+        func add(_ entry: ParallelDirectoryWalker.Entry, now: TimeInterval, hardLinks: HardLinkSet) {
+            switch entry.type {
+            case .directory:
+                directoryCount += 1
+                return
+            case .regularFile:
+                break
+            default:
+                otherItemCount += 1
+                return
+            }
+            var info = stat()
+            guard lstat(entry.path, &info) == 0 else { return }
+            if info.st_nlink > 1, !hardLinks.insert(device: UInt64(info.st_dev), inode: UInt64(info.st_ino)) {
+                return
+            }
+            let fileSize = Int(info.st_size)
+            let fileAllocatedSize = Int(info.st_blocks) * 512
+            #if canImport(Darwin)
+            let modificationTime = TimeInterval(info.st_mtimespec.tv_sec)
+            #else
+            let modificationTime = TimeInterval(info.st_mtim.tv_sec)
+            #endif
+            fileCount += 1
+            size += fileSize
+            allocatedSize += fileAllocatedSize
+
+            let fileType = fileType(for: entry.path)
+            fileCounts[fileType, default: 0] += 1
+            sizes[fileType, default: 0] += fileSize
+
+            let age = now - modificationTime
+            let bucket = boundaries.firstIndex(where: { age < $0 }) ?? boundaries.count
+            ageBuckets[bucket].fileCount += 1
+            ageBuckets[bucket].size += fileSize
+
+            guard largestFilesCount > 0 else { return }
+            if largestFiles.count == largestFilesCount {
+                guard fileSize > largestFiles[0].size.bytes else { return }
+                largestFiles.removeFirst()
+            }
+            let file = File(url: entry.url, size: DataSize(fileSize), allocatedSize: DataSize(fileAllocatedSize), modificationDate: Date(timeIntervalSince1970: modificationTime))
+            let index = largestFiles.firstIndex(where: { $0.size.bytes >= fileSize }) ?? largestFiles.count
+            largestFiles.insert(file, at: index)
+        }
+
+        func fileType(for path: String) -> URL.FileType {
+            let pathExtension = (path as NSString).pathExtension.lowercased()
+            if let fileType = fileTypes[pathExtension] {
+                return fileType
+            }
+            let fileType = pathExtension.isEmpty ? .other("") : URL.FileType(fileExtension: pathExtension) ?? .other(pathExtension)
+            fileTypes[pathExtension] = fileType
+            return fileType
+        }
+    }
+
+    /// The files with several hard links that have been counted.
+    final class HardLinkSet {
+        let lock = NSLock()
+        var files: Set<FileIdentifier> = []
+
+        struct FileIdentifier: Hashable {
+            let device: UInt64
+            let inode: UInt64
+        }
+
+        /// Inserts the file and returns `true` if it hasn't been counted yet.
+        func insert(device: UInt64, inode: UInt64) -> Bool {
+            lock.lock()
+            defer { lock.unlock() }
+            return files.insert(FileIdentifier(device: device, inode: inode)).inserted
+        }
+    }
+
+    final class ProgressCounter {
+        let progress: Progress?
+        let lock = NSLock()
+        var count: Int64 = 0
+
+        init(progress: Progress?) {
+            self.progress = progress
+        }
+
+        func add(_ value: Int) {
+            guard let progress = progress else { return }
+            lock.lock()
+            count += Int64(value)
+            progress.completedUnitCount = count
+            lock.unlock()
+        }
+    }
+}
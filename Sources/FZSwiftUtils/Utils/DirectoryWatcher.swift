@@ -0,0 +1,511 @@
+//
+//  DirectoryWatcher.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+#if os(macOS)
+import CoreServices
+#elseif canImport(Darwin)
+import Darwin
+#elseif canImport(Glibc)
+import Glibc
+#endif
+
+/**
+ Watches a directory tree for changes.
+
+ The watcher uses FSEvents on macOS, inotify on Linux and kqueue on other Apple platforms. Events that occur within ``latency`` are coalesced into one batch, and the events of each path are merged into one change.
+
+ The watcher is an `AsyncSequence` of the batches. Watching starts when the iteration starts and stops when it ends:
+
+ ```swift
+ let watcher = DirectoryWatcher(url: libraryURL, latency: .milliseconds(200))
+ for await changes in watcher {
+     snapshot = try snapshot.applying(changes)
+ }
+ ```
+
+ With kqueue only the directories whose contents changed are reported, as ``Change/Kind/modified`` changes.
+ */
+public struct DirectoryWatcher: AsyncSequence {
+    public typealias Element = [Change]
+
+    /// A change of an item.
+    public struct Change: Hashable {
+        /// The kind of a change.
+        public struct Kind: OptionSet, Hashable {
+            public let rawValue: UInt32
+
+            public init(rawValue: UInt32) {
+                self.rawValue = rawValue
+            }
+
+            /// The item was created.
+            public static let created = Kind(rawValue: 1 << 0)
+            /// The item was removed.
+            public static let removed = Kind(rawValue: 1 << 1)
+            /// The item was renamed or moved.
+            public static let renamed = Kind(rawValue: 1 << 2)
+            /// The contents of the item were modified.
+            public static let modified = Kind(rawValue: 1 << 3)
+            /// The attributes of the item were modified.
+            public static let attributesModified = Kind(rawValue: 1 << 4)
+            /// Events were dropped and the item and its descendants need to be scanned again.
+            public static let rescanRequired = Kind(rawValue: 1 << 5)
+        }
+
+        /// The url of the item.
+        public let url: URL
+        /// The kind of the change.
+        public let kind: Kind
+    }
+
+    /// The url of the watched directory.
+    public let url: URL
+
+    /// The duration in which events are coalesced into one batch.
+    public let latency: TimeDuration
+
+    /// A Boolean value indicating whether the items of subdirectories are watched.
+    public let includesSubdirectories: Bool
+
+    /**
+     Creates a watcher for the specified directory.
+
+     - Parameters:
+        - url: The url of the directory.
+        - latency: The duration in which events are coalesced into one batch.
+        - includesSubdirectories: A Boolean value indicating whether the items of subdirectories are watched.
+     */
+    public init(url: URL, latency: TimeDuration = .milliseconds(100), includesSubdirectories: Bool = true) {
+        self.url = url
+        self.latency = latency
+        self.includesSubdirectories = includesSubdirectories
+    }
+
+    public func makeAsyncIterator() -> AsyncStream<[Change]>.Iterator {
+        AsyncStream<[Change]> { continuation in
+            let queue = DispatchQueue(label: "com.fzswiftutils.DirectoryWatcher")
+            let coalescer = Coalescer(queue: queue, latency: latency) { changes in
+                continuation.yield(changes)
+            }
+            let backend = Backend(url: url, includesSubdirectories: includesSubdirectories, queue: queue) { path, kind in
+                coalescer.add(path, kind: kind)
+            }
+            continuation.onTermination = { _ in
+                queue.async {
+                    backend.stop()
+                }
+            }
+            queue.async {
+                if !backend.start() {
+                    continuation.finish()
+                }
+            }
+        }.makeAsyncIterator()
+    }
+}
+
+extension DirectoryWatcher {
+    /// Collects the events of a time window and merges the events of each path.
+    final class Coalescer {
+        let queue: DispatchQueue
+        let latency: TimeDuration
+        let deliver: ([Change]) -> Void
+        var kinds: [String: Change.Kind] = [:]
+        var paths: [String] = []
+        var isScheduled = false
+
+        init(queue: DispatchQueue, latency: TimeDuration, deliver: @escaping ([Change]) -> Void) {
+            self.queue = queue
+            self.latency = latency
+            self.deliver = deliver
+        }
+
+        /// Adds the event. Must be called on the queue.
+        func add(_ path: String, kind: Change.Kind) {
+            if let existing = kinds[path] {
+                kinds[path] = existing.union(kind)
+            } else {
+                kinds[path] = kind
+                paths.append(path)
+            }
+            guard !isScheduled else { return }
+            isScheduled = true
+            queue.asyncAfter(deadline: .now() + latency.seconds) { [weak self] in
+                self?.flush()
+            }
+        }
+
+        func flush() {
+            isScheduled = false
+            guard !paths.isEmpty else { return }
+            let changes = paths.map { Change(url: URL(fileURLWithPath: $0), kind: kinds[$0] ?? []) }
+            kinds.removeAll(keepingCapacity: true)
+            paths.removeAll(keepingCapacity: true)
+            deliver(changes)
+        }
+    }
+}
+
+#if os(macOS)
+extension DirectoryWatcher {
+    /// Watches the directory tree with FSEvents.
+    final class Backend {
+        let path: String
+        let includesSubdirectories: Bool
+        let queue: DispatchQueue
+        let handler: (String, Change.Kind) -> Void
+        var stream: FSEventStreamRef?
+
+        init(url: URL, includesSubdirectories: Bool, queue: DispatchQueue, handler: @escaping (String, Change.Kind) -> Void) {
+            // FSEvents reports the paths with resolved symbolic links.
+            path = url.resolvingSymlinksInPath().path
+            self.includesSubdirectories = includesSubdirectories
+            self.queue = queue
+            self.handler = handler
+        }
+
+        func start() -> Bool {
+            var context = FSEventStreamContext(version: 0, info: Unmanaged.passUnretained(self).toOpaque(), retain: nil, release: nil, copyDescription: nil)
+            let callback: FSEventStreamCallback = { _, info, count, paths, flags, _ in
+                guard let info = info else { return }
+                let backend = Unmanaged<Backend>.fromOpaque(info).takeUnretainedValue()
+                guard let paths = unsafeBitCast(paths, to: NSArray.self) as? [String] else { return }
+                for index in 0..<min(count, paths.count) {
+                    backend.handle(paths[index], flags: flags[index])
+                }
+            }
+            let createFlags = FSEventStreamCreateFlags(kFSEventStreamCreateFlagFileEvents | kFSEventStreamCreateFlagUseCFTypes | kFSEventStreamCreateFlagNoDefer)
+            guard let stream = FSEventStreamCreate(kCFAllocatorDefault, callback, &context, [path] as CFArray, FSEventStreamEventId(kFSEventStreamEventIdSinceNow), 0, createFlags) else { return false }
+            self.stream = stream
+            FSEventStreamSetDispatchQueue(stream, queue)
+            return FSEventStreamStart(stream)
+        }
+
+        func stop() {
+            guard let stream = stream else { return }
+            FSEventStreamStop(stream)
+            FSEventStreamInvalidate(stream)
+            FSEventStreamRelease(stream)
+            self.stream = nil
+        }
+
+        func handle(_ eventPath: String, flags: FSEventStreamEventFlags) {
+            func contains(_ flag: Int) -> Bool {
+                flags & FSEventStreamEventFlags(flag) != 0
+            }
+            if contains(kFSEventStreamEventFlagMustScanSubDirs) || contains(kFSEventStreamEventFlagUserDropped) || contains(kFSEventStreamEventFlagKernelDropped) {
+                handler(eventPath, .rescanRequired)
+                return
+            }
+            guard includesSubdirectories || (eventPath as NSString).deletingLastPathComponent == path else { return }
+            var kind: Change.Kind = []
+            if contains(kFSEventStreamEventFlagItemCreated) { kind.insert(.created) }
+            if contains(kFSEventStreamEventFlagItemRemoved) { kind.insert(.removed) }
+            if contains(kFSEventStreamEventFlagItemRenamed) { kind.insert(.renamed) }
+            if contains(kFSEventStreamEventFlagItemModified) { kind.insert(.modified) }
+            if contains(kFSEventStreamEventFlagItemInodeMetaMod) || contains(kFSEventStreamEventFlagItemXattrMod) || contains(kFSEventStreamEventFlagItemChangeOwner) || contains(kFSEventStreamEventFlagItemFinderInfoMod) {
+                kind.insert(.attributesModified)
+            }
+            guard !kind.isEmpty else { return }
+            handler(eventPath, kind)
+        }
+    }
+}
+#elseif canImport(Darwin)
+extension DirectoryWatcher {
+    /// Watches the directories of the tree with kqueue.
+    final class Backend {
+        let path: String
+        let includesSubdirectories: Bool
+        let queue: DispatchQueue
+        let handler: (String, Change.Kind) -> Void
+        var sources: [String: DispatchSourceFileSystemObject] = [:]
+
+        init(url: URL, includesSubdirectories: Bool, queue: DispatchQueue, handler: @escaping (String, Change.Kind) -> Void) {
+            path = url.path
+            self.includesSubdirectories = includesSubdirectories
+            self.queue = queue
+            self.handler = handler
+        }
+
+        func start() -> Bool {
+            watch(path)
+            return sources[path] != nil
+        }
+
+        func stop() {
+            sources.values.forEach { $0.cancel() }
+            sources.removeAll()
+        }
+
+        /// Watches the directory and, if subdirectories are included, its subdirectories that aren't watched yet.
+        func watch(_ directoryPath: String) {
+            if sources[directoryPath] == nil {
+                let fileDescriptor = open(directoryPath, O_EVTONLY)
+                guard fileDescriptor >= 0 else { return }
+                let source = DispatchSource.makeFileSystemObjectSource(fileDescriptor: fileDescriptor, eventMask: [.write, .delete, .rename, .attrib], queue: queue)
+                source.setEventHandler { [weak self] in
+                    self?.handle(directoryPath, event: source.data)
+                }
+                source.setCancelHandler {
+                    close(fileDescriptor)
+                }
+                sources[directoryPath] = source
+                source.resume()
+            }
+            guard includesSubdirectories, let contents = try? FileManager.default.contentsOfDirectory(atPath: directoryPath) else { return }
+            for name in contents {
+                let childPath = directoryPath + "/" + name
+                var isDirectory: ObjCBool = false
+                if sources[childPath] == nil, FileManager.default.fileExists(atPath: childPath, isDirectory: &isDirectory), isDirectory.boolValue {
+                    watch(childPath)
+                }
+            }
+        }
+
+        func handle(_ directoryPath: String, event: DispatchSource.FileSystemEvent) {
+            if event.contains(.delete) || event.contains(.rename) {
+                sources.removeValue(forKey: directoryPath)?.cancel()
+                handler(directoryPath, event.contains(.delete) ? .removed : .renamed)
+                return
+            }
+            if event.contains(.write) {
+                handler(directoryPath, .modified)
+                watch(directoryPath)
+            }
+            if event.contains(.attrib) {
+                handler(directoryPath, .attributesModified)
+            }
+        }
+    }
+}
+#else
+extension DirectoryWatcher {
+    /// Watches the directories of the tree with inotify.
+    final class Backend {
+        // The event masks of <sys/inotify.h>.
+        static let modifyMask: UInt32 = 0x0000_0002
+        static let attributesMask: UInt32 = 0x0000_0004
+        static let closeWriteMask: UInt32 = 0x0000_0008
+        static let movedFromMask: UInt32 = 0x0000_0040
+        static let movedToMask: UInt32 = 0x0000_0080
+        static let createMask: UInt32 = 0x0000_0100
+        static let deleteMask: UInt32 = 0x0000_0200
+        static let deleteSelfMask: UInt32 = 0x0000_0400
+        static let moveSelfMask: UInt32 = 0x0000_0800
+        static let overflowMask: UInt32 = 0x0000_4000
+        static let ignoredMask: UInt32 = 0x0000_8000
+        static let directoryMask: UInt32 = 0x4000_0000
+        static let watchMask: UInt32 = modifyMask | attributesMask | closeWriteMask | movedFromMask | movedToMask | createMask | deleteMask | deleteSelfMask | moveSelfMask
+
+        let path: String
+        let includesSubdirectories: Bool
+        let queue: DispatchQueue
+        let handler: (String, Change.Kind) -> Void
+        var fileDescriptor: Int32 = -1
+        var source: DispatchSourceRead?
+        var watchedPaths: [Int32: String] = [:]
+        var buffer = [UInt8](repeating: 0, count: 64 * 1024)
+
+        init(url: URL, includesSubdirectories: Bool, queue: DispatchQueue, handler: @escaping (String, Change.Kind) -> Void) {
+            path = url.path
+            self.includesSubdirectories = includesSubdirectories
+            self.queue = queue
+            self.handler = handler
+        }
+
+        func start() -> Bool {
+            fileDescriptor = inotify_init1(Int32(IN_NONBLOCK) | Int32(IN_CLOEXEC))
+            guard fileDescriptor >= 0 else { return false }
+            watch(path)
+            guard !watchedPaths.isEmpty else {
+                close(fileDescriptor)
+                return false
+            }
+            let fileDescriptor = fileDescriptor
+            let source = DispatchSource.makeReadSource(fileDescriptor: fileDescriptor, queue: queue)
+            source.setEventHandler { [weak self] in
+                self?.readEvents()
+            }
+            source.setCancelHandler {
+                close(fileDescriptor)
+            }
+            self.source = source
+            source.resume()
+            return true
+        }
+
+        func stop() {
+            source?.cancel()
+            source = nil
+            watchedPaths.removeAll()
+        }
+
+        /// Watches the directory and, if subdirectories are included, its subdirectories.
+        func watch(_ directoryPath: String) {
+            let descriptor = inotify_add_watch(fileDescriptor, directoryPath, Self.watchMask)
+            guard descriptor >= 0 else { return }
+            watchedPaths[descriptor] = directoryPath
+            guard includesSubdirectories, let directory = opendir(directoryPath) else { return }
+            defer { closedir(directory) }
+            while let entry = readdir(directory) {
+                let name = withUnsafePointer(to: &entry.pointee.d_name) {
+                    $0.withMemoryRebound(to: CChar.self, capacity: MemoryLayout.size(ofValue: entry.pointee.d_name)) { String(cString: $0) }
+                }
+                guard name != ".", name != ".." else { continue }
+                let childPath = directoryPath + "/" + name
+                if ParallelDirectoryWalker.Walk.itemType(entry.pointee.d_type, path: childPath) == .directory {
+                    watch(childPath)
+                }
+            }
+        }
+
+        func readEvents() {
+            while true {
+                let count = buffer.withUnsafeMutableBytes { read(fileDescriptor, $0.baseAddress, $0.count) }
+                guard count > 0 else { return }
+                buffer.withUnsafeBytes { bytes in
+                    var offset = 0
+                    // struct inotify_event: wd (Int32), mask, cookie, len (UInt32), name (len bytes, null padded).
+                    while offset + 16 <= count {
+                        let descriptor = bytes.loadUnaligned(fromByteOffset: offset, as: Int32.self)
+                        let mask = bytes.loadUnaligned(fromByteOffset: offset + 4, as: UInt32.self)
+                        let nameLength = Int(bytes.loadUnaligned(fromByteOffset: offset + 12, as: UInt32.self))
+                        let nameBytes = UnsafeRawBufferPointer(rebasing: bytes[(offset + 16)..<min(count, offset + 16 + nameLength)])
+                        let name = String(decoding: nameBytes.prefix(while: { $0 != 0 }), as: UTF8.self)
+                        handle(descriptor: descriptor, mask: mask, name: name)
+                        offset += 16 + nameLength
+                    }
+                }
+            }
+        }
+
+        func handle(descriptor: Int32, mask: UInt32, name: String) {
+            if mask & Self.overflowMask != 0 {
+                handler(path, .rescanRequired)
+                return
+            }
+            guard let directoryPath = watchedPaths[descriptor] else { return }
+            if mask & Self.ignoredMask != 0 {
+                watchedPaths[descriptor] = nil
+                return
+            }
+            if mask & (Self.deleteSelfMask | Self.moveSelfMask) != 0 {
+                if directoryPath == path {
+                    handler(path, mask & Self.deleteSelfMask != 0 ? .removed : .renamed)
+                }
+                return
+            }
+            let itemPath = name.isEmpty ? directoryPath : directoryPath + "/" + name
+            var kind: Change.Kind = []
+            if mask & Self.createMask != 0 { kind.insert(.created) }
+            if mask & Self.deleteMask != 0 { kind.insert(.removed) }
+            if mask & (Self.movedFromMask | Self.movedToMask) != 0 { kind.insert(.renamed) }
+            if mask & (Self.modifyMask | Self.closeWriteMask) != 0 { kind.insert(.modified) }
+            if mask & Self.attributesMask != 0 { kind.insert(.attributesModified) }
+            guard !kind.isEmpty else { return }
+            if includesSubdirectories, mask & Self.directoryMask != 0, mask & (Self.createMask | Self.movedToMask) != 0 {
+                watch(itemPath)
+            }
+            handler(itemPath, kind)
+        }
+    }
+}
+#endif
+
+public extension DirectorySnapshot {
+    /**
+     Returns the snapshot updated with the specified changes of a ``DirectoryWatcher``.
+
+     Only the changed items are checked again, and changed directories are scanned with ``rescan(verifyingFiles:)`` semantics. If the changes require a rescan of the directory, the whole snapshot is rescanned.
+
+     - Parameter changes: The changes of the directory.
+     - Throws: If the url of the snapshot isn't a directory anymore.
+     */
+    func applying(_ changes: [DirectoryWatcher.Change]) throws -> DirectorySnapshot {
+        let rootPath = url.path
+        let resolvedRootPath = url.resolvingSymlinksInPath().path
+        var changedPaths: Set<String> = []
+        for change in changes {
+            let changePath = change.url.path
+            var relativePath: String?
+            for root in [rootPath, resolvedRootPath] {
+                if changePath == root {
+                    relativePath = ""
+                } else if changePath.hasPrefix(root + "/") {
+                    relativePath = String(changePath.dropFirst(root.count + 1))
+                }
+                if relativePath != nil { break }
+            }
+            guard let relativePath = relativePath else { continue }
+            if relativePath.isEmpty || change.kind.contains(.rescanRequired) {
+                return try rescan()
+            }
+            changedPaths.insert(relativePath)
+        }
+        guard !changedPaths.isEmpty else { return self }
+
+        // The changed paths without the paths inside other changed directories, which are scanned with them, in the order of the items.
+        let scannedPaths = changedPaths.filter { path in
+            !path.indices.contains(where: { path[$0] == "/" && changedPaths.contains(String(path[..<$0])) })
+        }.sorted(by: ParallelDirectoryWalker.precedesInWalkOrder)
+        // The items are in walk order, so the subtree of each changed path is a contiguous range that is found with a binary search, and the rescanned subtrees are spliced in without sorting all items again.
+        var updatedItems: [Item] = []
+        updatedItems.reserveCapacity(items.count)
+        var copiedEnd = 0
+        for changedPath in scannedPaths {
+            guard includesHiddenFiles || !changedPath.split(separator: "/").contains(where: { $0.hasPrefix(".") }) else { continue }
+            let subtreeStart = items.partitionIndex(from: copiedEnd) { ParallelDirectoryWalker.precedesInWalkOrder($0.path, changedPath) }
+            let subtreeEnd = items.partitionIndex(from: subtreeStart) { $0.path == changedPath || Self.isPath($0.path, descendantOf: changedPath) }
+            updatedItems += items[copiedEnd..<subtreeStart]
+            copiedEnd = subtreeEnd
+            let previousSubtree = items[subtreeStart..<subtreeEnd].map { item in
+                Item(path: item.path == changedPath ? "" : String(item.path.dropFirst(changedPath.count + 1)), isDirectory: item.isDirectory, device: item.device, inode: item.inode, size: item.size, modificationTime: item.modificationTime, osHashValue: item.osHashValue)
+            }
+            let absolutePath = rootPath + "/" + changedPath
+            guard let info = Scanner.status(atPath: absolutePath) else { continue }
+            let scanner = Scanner(rootPath: absolutePath, includesHashes: includesHashes, includesHiddenFiles: includesHiddenFiles, verifyingFiles: true, previous: previousSubtree)
+            scanner.indexPrevious()
+            let previousIndex = scanner.previousIndexes[""]
+            let item = scanner.makeItem("", info: info, previousIndex: previousIndex)
+            if item.isDirectory {
+                scanner.scanDirectory(item, absolutePath: absolutePath, previousIndex: previousIndex)
+            } else {
+                scanner.items.append(item)
+            }
+            updatedItems += scanner.items.map { item in
+                Item(path: item.path.isEmpty ? changedPath : changedPath + "/" + item.path, isDirectory: item.isDirectory, device: item.device, inode: item.inode, size: item.size, modificationTime: item.modificationTime, osHashValue: item.osHashValue)
+            }
+        }
+        updatedItems += items[copiedEnd...]
+        return DirectorySnapshot(url: url, includesHashes: includesHashes, includesHiddenFiles: includesHiddenFiles, items: updatedItems)
+    }
+}
+
+extension DirectorySnapshot {
+    static func isPath(_ path: String, descendantOf directoryPath: String) -> Bool {
+        path.utf8.count > directoryPath.utf8.count && path.utf8.starts(with: directoryPath.utf8) && path.utf8[path.utf8.index(path.utf8.startIndex, offsetBy: directoryPath.utf8.count)] == UInt8(ascii: "/")
+    }
+}
+
+extension Array {
+    /// Returns the index of the first element from the start index that doesn't satisfy the predicate. The elements that satisfy it have to precede the others.
+    func partitionIndex(from start: Int, where predicate: (Element) -> Bool) -> Int {
+        var low = start
+        var high = count
+        while low < high {
+            let middle = low + (high - low) / 2
+            if predicate(self[middle]) {
+                low = middle + 1
+            } else {
+                high = middle
+            }
+        }
+        return low
+    }
+}
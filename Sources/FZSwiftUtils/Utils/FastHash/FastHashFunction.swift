@@ -0,0 +1,194 @@
+//
+//  FastHashFunction.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ A non-cryptographic hash function.
+
+ Fast hash functions are much faster than cryptographic hash functions like `SHA256` and are suited for cache keys, sharding and deduplication, but not for security purposes.
+
+ Like `CryptoKit.HashFunction`, data can either be hashed at once, or incrementally by calling ``update(bufferPointer:)`` for each chunk and ``finalize()`` at the end:
+
+ ```swift
+ let digest = XXH3.hash(data: data)
+
+ var hashFunction = XXH3(seed: 42)
+ hashFunction.update(data: firstChunk)
+ hashFunction.update(data: secondChunk)
+ let streamedDigest = hashFunction.finalize()
+ ```
+
+ The digests are the same as the ones of the reference implementations of the hash functions.
+ */
+public protocol FastHashFunction {
+    /// The type of the digest.
+    associatedtype Digest: Hashable
+
+    /**
+     Creates a hash function for incremental hashing with the specified seed.
+
+     - Parameter seed: The seed of the hash function.
+     */
+    init(seed: UInt64)
+
+    /// Adds the bytes to the hashed data.
+    mutating func update(bufferPointer: UnsafeRawBufferPointer)
+
+    /// Returns the digest of the hashed data.
+    func finalize() -> Digest
+
+    /**
+     Computes the digest of the specified bytes.
+
+     - Parameters:
+        - bufferPointer: The bytes to hash.
+        - seed: The seed of the hash function.
+     */
+    static func hash(bufferPointer: UnsafeRawBufferPointer, seed: UInt64) -> Digest
+}
+
+public extension FastHashFunction {
+    /// Creates a hash function for incremental hashing.
+    init() {
+        self.init(seed: 0)
+    }
+
+    /// Adds the data to the hashed data.
+    mutating func update(data: Data) {
+        data.withUnsafeBytes { update(bufferPointer: $0) }
+    }
+
+    /// Adds the UTF-8 representation of the string to the hashed data.
+    mutating func update<S: StringProtocol>(utf8 string: S) {
+        if string.utf8.withContiguousStorageIfAvailable({ update(bufferPointer: UnsafeRawBufferPointer($0)) }) == nil {
+            Array(string.utf8).withUnsafeBytes { update(bufferPointer: $0) }
+        }
+    }
+
+    /**
+     Computes the digest of the specified bytes.
+
+     - Parameter bufferPointer: The bytes to hash.
+     */
+    static func hash(bufferPointer: UnsafeRawBufferPointer) -> Digest {
+        hash(bufferPointer: bufferPointer, seed: 0)
+    }
+
+    /**
+     Computes the digest of the specified data.
+
+     - Parameters:
+        - data: The data to hash.
+        - seed: The seed of the hash function.
+     */
+    static func hash(data: Data, seed: UInt64 = 0) -> Digest {
+        data.withUnsafeBytes { hash(bufferPointer: $0, seed: seed) }
+    }
+
+    /**
+     Computes the digest of the UTF-8 representation of the specified string.
+
+     - Parameters:
+        - string: The string to hash.
+        - seed: The seed of the hash function.
+     */
+    static func hash<S: StringProtocol>(utf8 string: S, seed: UInt64 = 0) -> Digest {
+        if let digest = string.utf8.withContiguousStorageIfAvailable({ hash(bufferPointer: UnsafeRawBufferPointer($0), seed: seed) }) {
+            return digest
+        }
+        return Array(string.utf8).withUnsafeBytes { hash(bufferPointer: $0, seed: seed) }
+    }
+}
+
+/**
+ A hasher that combines values like `Hasher`, using a fast hash function with a 64-bit digest.
+
+ Unlike `Hasher`, which is randomly seeded for each process, the hash values are stable across processes and platforms, so they can be stored or used for sharding.
+
+ ```swift
+ var hasher = FastHasher<XXH3>()
+ hasher.combine(url.path)
+ hasher.combine(fileSize)
+ let hashValue = hasher.finalize()
+ ```
+ */
+public struct FastHasher<Function: FastHashFunction> where Function.Digest == UInt64 {
+    var function: Function
+
+    /**
+     Creates a hasher with the specified seed.
+
+     - Parameter seed: The seed of the hash function.
+     */
+    public init(seed: UInt64 = 0) {
+        function = Function(seed: seed)
+    }
+
+    /// Adds the bytes to the hasher.
+    public mutating func combine(bytes: UnsafeRawBufferPointer) {
+        function.update(bufferPointer: bytes)
+    }
+
+    /// Adds the little-endian bytes of the integer to the hasher.
+    public mutating func combine<T: FixedWidthInteger>(_ value: T) {
+        withUnsafeBytes(of: value.littleEndian) { function.update(bufferPointer: $0) }
+    }
+
+    /// Adds the Boolean value to the hasher.
+    public mutating func combine(_ value: Bool) {
+        combine(value ? 1 as UInt8 : 0)
+    }
+
+    /// Adds the bits of the floating-point value to the hasher.
+    public mutating func combine(_ value: Double) {
+        combine(value == 0 ? 0 : value.bitPattern)
+    }
+
+    /// Adds the UTF-8 representation of the string to the hasher, followed by its length so that consecutive strings can't collide.
+    public mutating func combine<S: StringProtocol>(_ string: S) {
+        function.update(utf8: string)
+        combine(UInt64(string.utf8.count))
+    }
+
+    /// Adds the data to the hasher, followed by its length so that consecutive data can't collide.
+    public mutating func combine(_ data: Data) {
+        function.update(data: data)
+        combine(UInt64(data.count))
+    }
+
+    /// Returns the 64-bit digest of the combined values.
+    public func finalize64() -> UInt64 {
+        function.finalize()
+    }
+
+    /// Returns the hash value of the combined values.
+    public func finalize() -> Int {
+        Int(truncatingIfNeeded: function.finalize())
+    }
+}
+
+extension UnsafeRawBufferPointer {
+    /// Reads the little-endian 64-bit integer at the specified offset.
+    @inline(__always)
+    func readLE64(_ offset: Int) -> UInt64 {
+        UInt64(littleEndian: loadUnaligned(fromByteOffset: offset, as: UInt64.self))
+    }
+
+    /// Reads the little-endian 32-bit integer at the specified offset.
+    @inline(__always)
+    func readLE32(_ offset: Int) -> UInt32 {
+        UInt32(littleEndian: loadUnaligned(fromByteOffset: offset, as: UInt32.self))
+    }
+}
+
+extension UInt64 {
+    @inline(__always)
+    func rotatedLeft(by count: UInt64) -> UInt64 {
+        (self &<< count) | (self &>> (64 &- count))
+    }
+}
@@ -0,0 +1,159 @@
+//
+//  WyHash.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ The wyhash hash function (version final4).
+
+ wyhash needs only a few 128-bit multiplications per 48 bytes, which makes it especially fast for short keys like file names and identifiers.
+
+ ```swift
+ WyHash.hash(utf8: "abc") // 0x989b4a209c1011c9
+ ```
+ */
+public struct WyHash: FastHashFunction {
+    public typealias Digest = UInt64
+
+    let initialSeed: UInt64
+    var seed: UInt64
+    var see1: UInt64
+    var see2: UInt64
+    var hasProcessedBlocks = false
+    /// The last 16 processed bytes, followed by the pending bytes that don't fill a complete block yet.
+    var buffer = SIMD64<UInt8>()
+    var pendingCount = 0
+    var totalLength = 0
+
+    public init(seed: UInt64) {
+        initialSeed = seed
+        self.seed = seed ^ Self.mix(seed ^ Self.secret0, Self.secret1)
+        see1 = self.seed
+        see2 = self.seed
+    }
+
+    public mutating func update(bufferPointer input: UnsafeRawBufferPointer) {
+        totalLength += input.count
+        var position = 0
+        if pendingCount > 0 {
+            position = min(Self.blockLength - pendingCount, input.count)
+            withUnsafeMutableBytes(of: &buffer) {
+                UnsafeMutableRawBufferPointer(rebasing: $0[(Self.historyLength + pendingCount)...]).copyMemory(from: UnsafeRawBufferPointer(rebasing: input[..<position]))
+            }
+            pendingCount += position
+            guard pendingCount == Self.blockLength else { return }
+            let block = buffer
+            withUnsafeBytes(of: block) { consumeBlock($0, at: Self.historyLength) }
+            withUnsafeMutableBytes(of: &buffer) {
+                $0.copyMemory(from: UnsafeRawBufferPointer(rebasing: $0[Self.blockLength...]))
+            }
+            pendingCount = 0
+        }
+        if input.count - position >= Self.blockLength {
+            repeat {
+                consumeBlock(input, at: position)
+                position += Self.blockLength
+            } while input.count - position >= Self.blockLength
+            withUnsafeMutableBytes(of: &buffer) {
+                $0.copyMemory(from: UnsafeRawBufferPointer(rebasing: input[(position - Self.historyLength) ..< position]))
+            }
+        }
+        pendingCount = input.count - position
+        withUnsafeMutableBytes(of: &buffer) {
+            UnsafeMutableRawBufferPointer(rebasing: $0[Self.historyLength...]).copyMemory(from: UnsafeRawBufferPointer(rebasing: input[position...]))
+        }
+    }
+
+    public func finalize() -> UInt64 {
+        withUnsafeBytes(of: buffer) { buffer in
+            guard totalLength > 16 else {
+                return Self.hash(bufferPointer: UnsafeRawBufferPointer(rebasing: buffer[Self.historyLength ..< Self.historyLength + pendingCount]), seed: initialSeed)
+            }
+            var seed = hasProcessedBlocks ? self.seed ^ see1 ^ see2 : self.seed
+            var position = Self.historyLength
+            var remaining = pendingCount
+            while remaining > 16 {
+                seed = Self.mix(buffer.readLE64(position) ^ Self.secret1, buffer.readLE64(position + 8) ^ seed)
+                position += 16
+                remaining -= 16
+            }
+            return Self.finish(buffer.readLE64(position + remaining - 16), buffer.readLE64(position + remaining - 8), seed, length: totalLength)
+        }
+    }
+
+    public static func hash(bufferPointer input: UnsafeRawBufferPointer, seed: UInt64) -> UInt64 {
+        let length = input.count
+        var seed = seed ^ mix(seed ^ secret0, secret1)
+        let a: UInt64
+        let b: UInt64
+        if length <= 16 {
+            if length >= 4 {
+                let quarter = (length >> 3) << 2
+                a = UInt64(input.readLE32(0)) &<< 32 | UInt64(input.readLE32(quarter))
+                b = UInt64(input.readLE32(length - 4)) &<< 32 | UInt64(input.readLE32(length - 4 - quarter))
+            } else if length > 0 {
+                a = UInt64(input[0]) &<< 16 | UInt64(input[length >> 1]) &<< 8 | UInt64(input[length - 1])
+                b = 0
+            } else {
+                a = 0
+                b = 0
+            }
+        } else {
+            var position = 0
+            var remaining = length
+            if remaining >= blockLength {
+                var see1 = seed
+                var see2 = seed
+                repeat {
+                    seed = mix(input.readLE64(position) ^ secret1, input.readLE64(position + 8) ^ seed)
+                    see1 = mix(input.readLE64(position + 16) ^ secret2, input.readLE64(position + 24) ^ see1)
+                    see2 = mix(input.readLE64(position + 32) ^ secret3, input.readLE64(position + 40) ^ see2)
+                    position += blockLength
+                    remaining -= blockLength
+                } while remaining >= blockLength
+                seed ^= see1 ^ see2
+            }
+            while remaining > 16 {
+                seed = mix(input.readLE64(position) ^ secret1, input.readLE64(position + 8) ^ seed)
+                position += 16
+                remaining -= 16
+            }
+            a = input.readLE64(position + remaining - 16)
+            b = input.readLE64(position + remaining - 8)
+        }
+        return finish(a, b, seed, length: length)
+    }
+}
+
+extension WyHash {
+    static let secret0: UInt64 = 0x2D35_8DCC_AA6C_78A5
+    static let secret1: UInt64 = 0x8BB8_4B93_962E_ACC9
+    static let secret2: UInt64 = 0x4B33_A62E_D433_D4A3
+    static let secret3: UInt64 = 0x4D5A_2DA5_1DE1_AA47
+    static let blockLength = 48
+    static let historyLength = 16
+
+    mutating func consumeBlock(_ input: UnsafeRawBufferPointer, at position: Int) {
+        seed = Self.mix(input.readLE64(position) ^ Self.secret1, input.readLE64(position + 8) ^ seed)
+        see1 = Self.mix(input.readLE64(position + 16) ^ Self.secret2, input.readLE64(position + 24) ^ see1)
+        see2 = Self.mix(input.readLE64(position + 32) ^ Self.secret3, input.readLE64(position + 40) ^ see2)
+        hasProcessedBlocks = true
+    }
+
+    /// Multiplies the values to 128 bits and folds the product to 64 bits.
+    @inline(__always)
+    static func mix(_ lhs: UInt64, _ rhs: UInt64) -> UInt64 {
+        let product = lhs.multipliedFullWidth(by: rhs)
+        return product.high ^ product.low
+    }
+
+    @inline(__always)
+    static func finish(_ a: UInt64, _ b: UInt64, _ seed: UInt64, length: Int) -> UInt64 {
+        let product = (a ^ secret1).multipliedFullWidth(by: b ^ seed)
+        return mix(product.low ^ secret0 ^ UInt64(length), product.high ^ secret1)
+    }
+}
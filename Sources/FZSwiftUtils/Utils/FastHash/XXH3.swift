@@ -0,0 +1,529 @@
+//
+//  XXH3.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ The 64-bit XXH3 hash function.
+
+ XXH3 is the fastest hash function of the xxHash family. Short inputs are hashed with a few multiplications and long inputs are processed in 64-byte stripes that the compiler vectorizes.
+
+ ```swift
+ XXH3.hash(utf8: "Hello") // 0x38e23bf5a2a77616
+ ```
+ */
+public struct XXH3: FastHashFunction {
+    public typealias Digest = UInt64
+
+    var state: XXH3State
+
+    public init(seed: UInt64) {
+        state = XXH3State(seed: seed)
+    }
+
+    public mutating func update(bufferPointer input: UnsafeRawBufferPointer) {
+        state.update(input)
+    }
+
+    public func finalize() -> UInt64 {
+        guard state.totalLength > XXH3State.midSizeMax else {
+            return state.buffer.withUnsafeBytes {
+                Self.hash(bufferPointer: UnsafeRawBufferPointer(rebasing: $0[..<state.bufferCount]), seed: state.seed)
+            }
+        }
+        let accumulators = state.finalAccumulators()
+        return state.secret.withUnsafeBytes {
+            XXH3State.mergeAccumulators(accumulators, $0, offset: XXH3State.secretMergeOffset, start: state.totalLength &* XXH64.prime1)
+        }
+    }
+
+    public static func hash(bufferPointer input: UnsafeRawBufferPointer, seed: UInt64) -> UInt64 {
+        let length = input.count
+        if length <= XXH3State.midSizeMax {
+            return XXH3State.defaultSecret.withUnsafeBytes { secret in
+                if length <= 16 {
+                    return XXH3State.hash0To16(input, secret, seed)
+                } else if length <= 128 {
+                    return XXH3State.hash17To128(input, secret, seed)
+                }
+                return XXH3State.hash129To240(input, secret, seed)
+            }
+        }
+        let secret = seed == 0 ? XXH3State.defaultSecret : XXH3State.customSecret(seed: seed)
+        return secret.withUnsafeBytes { secret in
+            var accumulators = XXH3State.initialAccumulators
+            XXH3State.hashLong(&accumulators, input, secret)
+            return XXH3State.mergeAccumulators(accumulators, secret, offset: XXH3State.secretMergeOffset, start: UInt64(length) &* XXH64.prime1)
+        }
+    }
+}
+
+/**
+ The 128-bit XXH3 hash function.
+
+ It has the same speed as ``XXH3``, but the larger digest makes collisions unlikely even for billions of values.
+
+ ```swift
+ let digest = XXH128.hash(utf8: "Hello")
+ digest.high64 // 0x1bfd09d1a433fb78
+ digest.low64 // 0x117b4c7b1583d16d
+ ```
+ */
+public struct XXH128: FastHashFunction {
+    /// A 128-bit digest.
+    public struct Digest: Hashable {
+        /// The low 64 bits of the digest.
+        public let low64: UInt64
+        /// The high 64 bits of the digest.
+        public let high64: UInt64
+
+        /// The bytes of the digest in the canonical big-endian order of xxHash.
+        public var bytes: [UInt8] {
+            withUnsafeBytes(of: (high64.bigEndian, low64.bigEndian)) { Array($0) }
+        }
+
+        /// The digest as a lowercase hexadecimal string.
+        public var hexString: String {
+            withUnsafeBytes(of: (high64.bigEndian, low64.bigEndian)) { HexEncoding.string(from: $0) }
+        }
+    }
+
+    var state: XXH3State
+
+    public init(seed: UInt64) {
+        state = XXH3State(seed: seed)
+    }
+
+    public mutating func update(bufferPointer input: UnsafeRawBufferPointer) {
+        state.update(input)
+    }
+
+    public func finalize() -> Digest {
+        guard state.totalLength > XXH3State.midSizeMax else {
+            return state.buffer.withUnsafeBytes {
+                Self.hash(bufferPointer: UnsafeRawBufferPointer(rebasing: $0[..<state.bufferCount]), seed: state.seed)
+            }
+        }
+        let accumulators = state.finalAccumulators()
+        return state.secret.withUnsafeBytes {
+            Self.mergeLong(accumulators, $0, length: state.totalLength)
+        }
+    }
+
+    public static func hash(bufferPointer input: UnsafeRawBufferPointer, seed: UInt64) -> Digest {
+        let length = input.count
+        if length <= XXH3State.midSizeMax {
+            return XXH3State.defaultSecret.withUnsafeBytes { secret in
+                if length <= 16 {
+                    return hash0To16(input, secret, seed)
+                } else if length <= 128 {
+                    return hash17To128(input, secret, seed)
+                }
+                return hash129To240(input, secret, seed)
+            }
+        }
+        let secret = seed == 0 ? XXH3State.defaultSecret : XXH3State.customSecret(seed: seed)
+        return secret.withUnsafeBytes { secret in
+            var accumulators = XXH3State.initialAccumulators
+            XXH3State.hashLong(&accumulators, input, secret)
+            return mergeLong(accumulators, secret, length: UInt64(length))
+        }
+    }
+}
+
+extension XXH128 {
+    static func mergeLong(_ accumulators: SIMD8<UInt64>, _ secret: UnsafeRawBufferPointer, length: UInt64) -> Digest {
+        let low = XXH3State.mergeAccumulators(accumulators, secret, offset: XXH3State.secretMergeOffset, start: length &* XXH64.prime1)
+        let high = XXH3State.mergeAccumulators(accumulators, secret, offset: secret.count - 64 - XXH3State.secretMergeOffset, start: ~(length &* XXH64.prime2))
+        return Digest(low64: low, high64: high)
+    }
+
+    static func hash0To16(_ input: UnsafeRawBufferPointer, _ secret: UnsafeRawBufferPointer, _ seed: UInt64) -> Digest {
+        let length = input.count
+        if length > 8 {
+            let bitflipLow = (secret.readLE64(32) ^ secret.readLE64(40)) &- seed
+            let bitflipHigh = (secret.readLE64(48) ^ secret.readLE64(56)) &+ seed
+            let inputLow = input.readLE64(0)
+            var inputHigh = input.readLE64(length - 8)
+            var (mulHigh, mulLow) = (inputLow ^ inputHigh ^ bitflipLow).multipliedFullWidth(by: XXH64.prime1)
+            mulLow &+= UInt64(length - 1) &<< 54
+            inputHigh ^= bitflipHigh
+            mulHigh &+= inputHigh &+ (inputHigh & 0xFFFF_FFFF) &* (UInt64(XXH3State.prime32_2) &- 1)
+            mulLow ^= mulHigh.byteSwapped
+            let product = mulLow.multipliedFullWidth(by: XXH64.prime2)
+            let high = product.high &+ mulHigh &* XXH64.prime2
+            return Digest(low64: XXH3State.avalanche(product.low), high64: XXH3State.avalanche(high))
+        }
+        if length >= 4 {
+            let seed = seed ^ (UInt64(UInt32(truncatingIfNeeded: seed).byteSwapped) &<< 32)
+            let combined = UInt64(input.readLE32(0)) &+ (UInt64(input.readLE32(length - 4)) &<< 32)
+            let bitflip = (secret.readLE64(16) ^ secret.readLE64(24)) &+ seed
+            var (high, low) = (combined ^ bitflip).multipliedFullWidth(by: XXH64.prime1 &+ (UInt64(length) &<< 2))
+            high &+= low &<< 1
+            low ^= high &>> 3
+            low ^= low &>> 35
+            low &*= XXH3State.mixPrime2
+            low ^= low &>> 28
+            return Digest(low64: low, high64: XXH3State.avalanche(high))
+        }
+        if length > 0 {
+            let combinedLow = UInt32(input[0]) &<< 16 | UInt32(input[length >> 1]) &<< 24 | UInt32(input[length - 1]) | UInt32(length) &<< 8
+            let swapped = combinedLow.byteSwapped
+            let combinedHigh = (swapped &<< 13) | (swapped &>> 19)
+            let bitflipLow = UInt64(secret.readLE32(0) ^ secret.readLE32(4)) &+ seed
+            let bitflipHigh = UInt64(secret.readLE32(8) ^ secret.readLE32(12)) &- seed
+            return Digest(low64: XXH64.avalanche(UInt64(combinedLow) ^ bitflipLow), high64: XXH64.avalanche(UInt64(combinedHigh) ^ bitflipHigh))
+        }
+        return Digest(low64: XXH64.avalanche(seed ^ secret.readLE64(64) ^ secret.readLE64(72)), high64: XXH64.avalanche(seed ^ secret.readLE64(80) ^ secret.readLE64(88)))
+    }
+
+    static func hash17To128(_ input: UnsafeRawBufferPointer, _ secret: UnsafeRawBufferPointer, _ seed: UInt64) -> Digest {
+        let length = input.count
+        var low = UInt64(length) &* XXH64.prime1
+        var high: UInt64 = 0
+        if length > 32 {
+            if length > 64 {
+                if length > 96 {
+                    mix32(&low, &high, input, 48, length - 64, secret, 96, seed)
+                }
+                mix32(&low, &high, input, 32, length - 48, secret, 64, seed)
+            }
+            mix32(&low, &high, input, 16, length - 32, secret, 32, seed)
+        }
+        mix32(&low, &high, input, 0, length - 16, secret, 0, seed)
+        return finalize(low, high, length: length, seed: seed)
+    }
+
+    static func hash129To240(_ input: UnsafeRawBufferPointer, _ secret: UnsafeRawBufferPointer, _ seed: UInt64) -> Digest {
+        let length = input.count
+        var low = UInt64(length) &* XXH64.prime1
+        var high: UInt64 = 0
+        for offset in stride(from: 32, to: 160, by: 32) {
+            mix32(&low, &high, input, offset - 32, offset - 16, secret, offset - 32, seed)
+        }
+        low = XXH3State.avalanche(low)
+        high = XXH3State.avalanche(high)
+        for offset in stride(from: 160, through: length, by: 32) {
+            mix32(&low, &high, input, offset - 32, offset - 16, secret, XXH3State.midSizeStartOffset + offset - 160, seed)
+        }
+        mix32(&low, &high, input, length - 16, length - 32, secret, XXH3State.minimumSecretSize - XXH3State.midSizeLastOffset - 16, 0 &- seed)
+        return finalize(low, high, length: length, seed: seed)
+    }
+
+    @inline(__always)
+    static func mix32(_ low: inout UInt64, _ high: inout UInt64, _ input: UnsafeRawBufferPointer, _ offset1: Int, _ offset2: Int, _ secret: UnsafeRawBufferPointer, _ secretOffset: Int, _ seed: UInt64) {
+        low &+= XXH3State.mix16(input, offset1, secret, secretOffset, seed)
+        low ^= input.readLE64(offset2) &+ input.readLE64(offset2 + 8)
+        high &+= XXH3State.mix16(input, offset2, secret, secretOffset + 16, seed)
+        high ^= input.readLE64(offset1) &+ input.readLE64(offset1 + 8)
+    }
+
+    @inline(__always)
+    static func finalize(_ low: UInt64, _ high: UInt64, length: Int, seed: UInt64) -> Digest {
+        let resultLow = low &+ high
+        let resultHigh = low &* XXH64.prime1 &+ high &* XXH64.prime4 &+ (UInt64(length) &- seed) &* XXH64.prime2
+        return Digest(low64: XXH3State.avalanche(resultLow), high64: 0 &- XXH3State.avalanche(resultHigh))
+    }
+}
+
+/// The streaming state and the shared primitives of ``XXH3`` and ``XXH128``.
+struct XXH3State {
+    let seed: UInt64
+    let secret: [UInt8]
+    var accumulators = XXH3State.initialAccumulators
+    /// The buffered input. Its last stripe is kept after processing it, as the final stripe may overlap with it.
+    var buffer = [UInt8](repeating: 0, count: XXH3State.bufferSize)
+    var bufferCount = 0
+    var stripesSoFar = 0
+    var totalLength: UInt64 = 0
+
+    init(seed: UInt64) {
+        self.seed = seed
+        secret = seed == 0 ? Self.defaultSecret : Self.customSecret(seed: seed)
+    }
+
+    mutating func update(_ input: UnsafeRawBufferPointer) {
+        let length = input.count
+        totalLength &+= UInt64(length)
+        if length <= Self.bufferSize - bufferCount {
+            buffer.withUnsafeMutableBytes {
+                UnsafeMutableRawBufferPointer(rebasing: $0[bufferCount...]).copyMemory(from: input)
+            }
+            bufferCount += length
+            return
+        }
+        var accumulators = accumulators
+        var stripesSoFar = stripesSoFar
+        var position = 0
+        let secret = secret
+        secret.withUnsafeBytes { secret in
+            if bufferCount > 0 {
+                position = Self.bufferSize - bufferCount
+                buffer.withUnsafeMutableBytes { buffer in
+                    UnsafeMutableRawBufferPointer(rebasing: buffer[bufferCount...]).copyMemory(from: UnsafeRawBufferPointer(rebasing: input[..<position]))
+                    _ = Self.consumeStripes(&accumulators, &stripesSoFar, UnsafeRawBufferPointer(buffer), 0, Self.bufferSize / Self.stripeLength, secret)
+                }
+                bufferCount = 0
+            }
+            if length - position > Self.bufferSize {
+                let stripes = (length - 1 - position) / Self.stripeLength
+                position = Self.consumeStripes(&accumulators, &stripesSoFar, input, position, stripes, secret)
+                buffer.withUnsafeMutableBytes {
+                    UnsafeMutableRawBufferPointer(rebasing: $0[(Self.bufferSize - Self.stripeLength)...]).copyMemory(from: UnsafeRawBufferPointer(rebasing: input[(position - Self.stripeLength) ..< position]))
+                }
+            }
+        }
+        self.accumulators = accumulators
+        self.stripesSoFar = stripesSoFar
+        bufferCount = length - position
+        buffer.withUnsafeMutableBytes {
+            $0.copyMemory(from: UnsafeRawBufferPointer(rebasing: input[position...]))
+        }
+    }
+
+    /// Returns the accumulators after processing the buffered input and the final stripe.
+    func finalAccumulators() -> SIMD8<UInt64> {
+        var accumulators = accumulators
+        var stripesSoFar = stripesSoFar
+        secret.withUnsafeBytes { secret in
+            buffer.withUnsafeBytes { buffer in
+                if bufferCount >= Self.stripeLength {
+                    let stripes = (bufferCount - 1) / Self.stripeLength
+                    _ = Self.consumeStripes(&accumulators, &stripesSoFar, buffer, 0, stripes, secret)
+                    Self.accumulate512(&accumulators, buffer, bufferCount - Self.stripeLength, secret, secret.count - Self.stripeLength - Self.secretLastAccumulateStart)
+                } else {
+                    var lastStripe = [UInt8](repeating: 0, count: Self.stripeLength)
+                    let catchup = Self.stripeLength - bufferCount
+                    lastStripe.replaceSubrange(0 ..< catchup, with: buffer[(Self.bufferSize - catchup)...])
+                    lastStripe.replaceSubrange(catchup..., with: buffer[..<bufferCount])
+                    lastStripe.withUnsafeBytes {
+                        Self.accumulate512(&accumulators, $0, 0, secret, secret.count - Self.stripeLength - Self.secretLastAccumulateStart)
+                    }
+                }
+            }
+        }
+        return accumulators
+    }
+}
+
+extension XXH3State {
+    static let bufferSize = 256
+    static let stripeLength = 64
+    static let secretConsumeRate = 8
+    static let secretMergeOffset = 11
+    static let secretLastAccumulateStart = 7
+    static let minimumSecretSize = 136
+    static let midSizeMax = 240
+    static let midSizeStartOffset = 3
+    static let midSizeLastOffset = 17
+
+    static let prime32_1: UInt32 = 0x9E37_79B1
+    static let prime32_2: UInt32 = 0x85EB_CA77
+    static let prime32_3: UInt32 = 0xC2B2_AE3D
+    static let mixPrime1: UInt64 = 0x1656_6791_9E37_79F9
+    static let mixPrime2: UInt64 = 0x9FB2_1C65_1E98_DF25
+
+    static let initialAccumulators = SIMD8<UInt64>(UInt64(prime32_3), XXH64.prime1, XXH64.prime2, XXH64.prime3, XXH64.prime4, UInt64(prime32_2), XXH64.prime5, UInt64(prime32_1))
+
+    /// The default secret of XXH3.
+    static let defaultSecret: [UInt8] = [
+        0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+        0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+        0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+        0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+        0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+        0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+        0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+        0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+        0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+        0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+        0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+        0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+    ]
+
+    /// Returns the secret that is derived from the default secret for the specified seed.
+    static func customSecret(seed: UInt64) -> [UInt8] {
+        [UInt8](unsafeUninitializedCapacity: defaultSecret.count) { buffer, initializedCount in
+            defaultSecret.withUnsafeBytes { secret in
+                let destination = UnsafeMutableRawBufferPointer(buffer)
+                for offset in stride(from: 0, to: secret.count, by: 16) {
+                    destination.storeBytes(of: (secret.readLE64(offset) &+ seed).littleEndian, toByteOffset: offset, as: UInt64.self)
+                    destination.storeBytes(of: (secret.readLE64(offset + 8) &- seed).littleEndian, toByteOffset: offset + 8, as: UInt64.self)
+                }
+            }
+            initializedCount = defaultSecret.count
+        }
+    }
+
+    @inline(__always)
+    static func avalanche(_ hash: UInt64) -> UInt64 {
+        var hash = hash
+        hash ^= hash &>> 37
+        hash &*= mixPrime1
+        hash ^= hash &>> 32
+        return hash
+    }
+
+    @inline(__always)
+    static func rrmxmx(_ hash: UInt64, _ length: UInt64) -> UInt64 {
+        var hash = hash
+        hash ^= hash.rotatedLeft(by: 49) ^ hash.rotatedLeft(by: 24)
+        hash &*= mixPrime2
+        hash ^= (hash &>> 35) &+ length
+        hash &*= mixPrime2
+        return hash ^ (hash &>> 28)
+    }
+
+    /// Multiplies the values to 128 bits and folds the product to 64 bits.
+    @inline(__always)
+    static func fold(_ lhs: UInt64, _ rhs: UInt64) -> UInt64 {
+        let product = lhs.multipliedFullWidth(by: rhs)
+        return product.high ^ product.low
+    }
+
+    @inline(__always)
+    static func mix16(_ input: UnsafeRawBufferPointer, _ offset: Int, _ secret: UnsafeRawBufferPointer, _ secretOffset: Int, _ seed: UInt64) -> UInt64 {
+        fold(input.readLE64(offset) ^ (secret.readLE64(secretOffset) &+ seed), input.readLE64(offset + 8) ^ (secret.readLE64(secretOffset + 8) &- seed))
+    }
+
+    static func hash0To16(_ input: UnsafeRawBufferPointer, _ secret: UnsafeRawBufferPointer, _ seed: UInt64) -> UInt64 {
+        let length = input.count
+        if length > 8 {
+            let bitflip1 = (secret.readLE64(24) ^ secret.readLE64(32)) &+ seed
+            let bitflip2 = (secret.readLE64(40) ^ secret.readLE64(48)) &- seed
+            let low = input.readLE64(0) ^ bitflip1
+            let high = input.readLE64(length - 8) ^ bitflip2
+            return avalanche(UInt64(length) &+ low.byteSwapped &+ high &+ fold(low, high))
+        }
+        if length >= 4 {
+            let seed = seed ^ (UInt64(UInt32(truncatingIfNeeded: seed).byteSwapped) &<< 32)
+            let combined = UInt64(input.readLE32(length - 4)) &+ (UInt64(input.readLE32(0)) &<< 32)
+            let bitflip = (secret.readLE64(8) ^ secret.readLE64(16)) &- seed
+            return rrmxmx(combined ^ bitflip, UInt64(length))
+        }
+        if length > 0 {
+            let combined = UInt32(input[0]) &<< 16 | UInt32(input[length >> 1]) &<< 24 | UInt32(input[length - 1]) | UInt32(length) &<< 8
+            let bitflip = UInt64(secret.readLE32(0) ^ secret.readLE32(4)) &+ seed
+            return XXH64.avalanche(UInt64(combined) ^ bitflip)
+        }
+        return XXH64.avalanche(seed ^ secret.readLE64(56) ^ secret.readLE64(64))
+    }
+
+    static func hash17To128(_ input: UnsafeRawBufferPointer, _ secret: UnsafeRawBufferPointer, _ seed: UInt64) -> UInt64 {
+        let length = input.count
+        var accumulator = UInt64(length) &* XXH64.prime1
+        if length > 32 {
+            if length > 64 {
+                if length > 96 {
+                    accumulator &+= mix16(input, 48, secret, 96, seed) &+ mix16(input, length - 64, secret, 112, seed)
+                }
+                accumulator &+= mix16(input, 32, secret, 64, seed) &+ mix16(input, length - 48, secret, 80, seed)
+            }
+            accumulator &+= mix16(input, 16, secret, 32, seed) &+ mix16(input, length - 32, secret, 48, seed)
+        }
+        accumulator &+= mix16(input, 0, secret, 0, seed) &+ mix16(input, length - 16, secret, 16, seed)
+        return avalanche(accumulator)
+    }
+
+    static func hash129To240(_ input: UnsafeRawBufferPointer, _ secret: UnsafeRawBufferPointer, _ seed: UInt64) -> UInt64 {
+        let length = input.count
+        var accumulator = UInt64(length) &* XXH64.prime1
+        for round in 0 ..< 8 {
+            accumulator &+= mix16(input, 16 * round, secret, 16 * round, seed)
+        }
+        accumulator = avalanche(accumulator)
+        var accumulatorEnd = mix16(input, length - 16, secret, minimumSecretSize - midSizeLastOffset, seed)
+        for round in 8 ..< length / 16 {
+            accumulatorEnd &+= mix16(input, 16 * round, secret, 16 * (round - 8) + midSizeStartOffset, seed)
+        }
+        return avalanche(accumulator &+ accumulatorEnd)
+    }
+
+    /// Accumulates the 64-byte stripe at the specified offset.
+    @inline(__always)
+    static func accumulate512(_ accumulators: inout SIMD8<UInt64>, _ input: UnsafeRawBufferPointer, _ offset: Int, _ secret: UnsafeRawBufferPointer, _ secretOffset: Int) {
+        let data = input.readLE64x8(offset)
+        let key = data ^ secret.readLE64x8(secretOffset)
+        let swapped = SIMD8<UInt64>(data[1], data[0], data[3], data[2], data[5], data[4], data[7], data[6])
+        accumulators &+= swapped &+ (key & 0xFFFF_FFFF) &* (key &>> 32)
+    }
+
+    @inline(__always)
+    static func scramble(_ accumulators: inout SIMD8<UInt64>, _ secret: UnsafeRawBufferPointer) {
+        accumulators ^= accumulators &>> 47
+        accumulators ^= secret.readLE64x8(secret.count - stripeLength)
+        accumulators &*= UInt64(prime32_1)
+    }
+
+    /**
+     Accumulates the specified number of stripes and scrambles the accumulators after each block.
+
+     - Returns: The offset after the consumed stripes.
+     */
+    static func consumeStripes(_ accumulators: inout SIMD8<UInt64>, _ stripesSoFar: inout Int, _ input: UnsafeRawBufferPointer, _ offset: Int, _ stripes: Int, _ secret: UnsafeRawBufferPointer) -> Int {
+        let stripesPerBlock = (secret.count - stripeLength) / secretConsumeRate
+        var offset = offset
+        var stripes = stripes
+        while stripes >= stripesPerBlock - stripesSoFar {
+            let blockStripes = stripesPerBlock - stripesSoFar
+            for stripe in 0 ..< blockStripes {
+                accumulate512(&accumulators, input, offset + stripe * stripeLength, secret, (stripesSoFar + stripe) * secretConsumeRate)
+            }
+            scramble(&accumulators, secret)
+            offset += blockStripes * stripeLength
+            stripes -= blockStripes
+            stripesSoFar = 0
+        }
+        for stripe in 0 ..< stripes {
+            accumulate512(&accumulators, input, offset + stripe * stripeLength, secret, (stripesSoFar + stripe) * secretConsumeRate)
+        }
+        stripesSoFar += stripes
+        return offset + stripes * stripeLength
+    }
+
+    /// Accumulates all stripes of an input that is longer than 240 bytes.
+    static func hashLong(_ accumulators: inout SIMD8<UInt64>, _ input: UnsafeRawBufferPointer, _ secret: UnsafeRawBufferPointer) {
+        let stripesPerBlock = (secret.count - stripeLength) / secretConsumeRate
+        let blockLength = stripeLength * stripesPerBlock
+        let blocks = (input.count - 1) / blockLength
+        for block in 0 ..< blocks {
+            for stripe in 0 ..< stripesPerBlock {
+                accumulate512(&accumulators, input, block * blockLength + stripe * stripeLength, secret, stripe * secretConsumeRate)
+            }
+            scramble(&accumulators, secret)
+        }
+        let stripes = ((input.count - 1) - blockLength * blocks) / stripeLength
+        for stripe in 0 ..< stripes {
+            accumulate512(&accumulators, input, blocks * blockLength + stripe * stripeLength, secret, stripe * secretConsumeRate)
+        }
+        accumulate512(&accumulators, input, input.count - stripeLength, secret, secret.count - stripeLength - secretLastAccumulateStart)
+    }
+
+    static func mergeAccumulators(_ accumulators: SIMD8<UInt64>, _ secret: UnsafeRawBufferPointer, offset: Int, start: UInt64) -> UInt64 {
+        var result = start
+        for index in 0 ..< 4 {
+            result &+= fold(accumulators[2 * index] ^ secret.readLE64(offset + 16 * index), accumulators[2 * index + 1] ^ secret.readLE64(offset + 16 * index + 8))
+        }
+        return avalanche(result)
+    }
+}
+
+extension UnsafeRawBufferPointer {
+    /// Reads the eight little-endian 64-bit integers at the specified offset.
+    @inline(__always)
+    func readLE64x8(_ offset: Int) -> SIMD8<UInt64> {
+        #if _endian(big)
+        var value = loadUnaligned(fromByteOffset: offset, as: SIMD8<UInt64>.self)
+        for index in value.indices {
+            value[index] = value[index].byteSwapped
+        }
+        return value
+        #else
+        return loadUnaligned(fromByteOffset: offset, as: SIMD8<UInt64>.self)
+        #endif
+    }
+}
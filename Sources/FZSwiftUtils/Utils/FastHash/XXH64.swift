@@ -0,0 +1,176 @@
+//
+//  XXH64.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ The xxHash64 hash function.
+
+ xxHash64 processes 32 bytes per round and is fast on all 64-bit platforms. ``XXH3`` is faster for short and long inputs.
+
+ ```swift
+ XXH64.hash(utf8: "Hello") // 0x0a75a91375b27d44
+ ```
+ */
+public struct XXH64: FastHashFunction {
+    public typealias Digest = UInt64
+
+    var v1: UInt64
+    var v2: UInt64
+    var v3: UInt64
+    var v4: UInt64
+    let seed: UInt64
+    /// The bytes that don't fill a complete stripe yet.
+    var buffer = SIMD32<UInt8>()
+    var bufferCount = 0
+    var totalLength: UInt64 = 0
+
+    public init(seed: UInt64) {
+        self.seed = seed
+        v1 = seed &+ Self.prime1 &+ Self.prime2
+        v2 = seed &+ Self.prime2
+        v3 = seed
+        v4 = seed &- Self.prime1
+    }
+
+    public mutating func update(bufferPointer input: UnsafeRawBufferPointer) {
+        totalLength &+= UInt64(input.count)
+        var position = 0
+        if bufferCount + input.count < 32 {
+            withUnsafeMutableBytes(of: &buffer) {
+                UnsafeMutableRawBufferPointer(rebasing: $0[bufferCount...]).copyMemory(from: input)
+            }
+            bufferCount += input.count
+            return
+        }
+        if bufferCount > 0 {
+            position = 32 - bufferCount
+            withUnsafeMutableBytes(of: &buffer) {
+                UnsafeMutableRawBufferPointer(rebasing: $0[bufferCount...]).copyMemory(from: UnsafeRawBufferPointer(rebasing: input[..<position]))
+            }
+            let stripe = buffer
+            withUnsafeBytes(of: stripe) { consumeStripe($0, at: 0) }
+            bufferCount = 0
+        }
+        while position + 32 <= input.count {
+            consumeStripe(input, at: position)
+            position += 32
+        }
+        if position < input.count {
+            bufferCount = input.count - position
+            withUnsafeMutableBytes(of: &buffer) {
+                $0.copyMemory(from: UnsafeRawBufferPointer(rebasing: input[position...]))
+            }
+        }
+    }
+
+    public func finalize() -> UInt64 {
+        var hash: UInt64
+        if totalLength >= 32 {
+            hash = Self.mergedAccumulators(v1, v2, v3, v4)
+        } else {
+            hash = seed &+ Self.prime5
+        }
+        hash &+= totalLength
+        return withUnsafeBytes(of: buffer) {
+            Self.finalize(hash, UnsafeRawBufferPointer(rebasing: $0[..<bufferCount]))
+        }
+    }
+
+    public static func hash(bufferPointer input: UnsafeRawBufferPointer, seed: UInt64) -> UInt64 {
+        var hash: UInt64
+        var position = 0
+        if input.count >= 32 {
+            var v1 = seed &+ prime1 &+ prime2
+            var v2 = seed &+ prime2
+            var v3 = seed
+            var v4 = seed &- prime1
+            while position + 32 <= input.count {
+                v1 = round(v1, input.readLE64(position))
+                v2 = round(v2, input.readLE64(position + 8))
+                v3 = round(v3, input.readLE64(position + 16))
+                v4 = round(v4, input.readLE64(position + 24))
+                position += 32
+            }
+            hash = mergedAccumulators(v1, v2, v3, v4)
+        } else {
+            hash = seed &+ prime5
+        }
+        hash &+= UInt64(input.count)
+        return finalize(hash, UnsafeRawBufferPointer(rebasing: input[position...]))
+    }
+}
+
+extension XXH64 {
+    static let prime1: UInt64 = 0x9E37_79B1_85EB_CA87
+    static let prime2: UInt64 = 0xC2B2_AE3D_27D4_EB4F
+    static let prime3: UInt64 = 0x1656_67B1_9E37_79F9
+    static let prime4: UInt64 = 0x85EB_CA77_C2B2_AE63
+    static let prime5: UInt64 = 0x27D4_EB2F_1656_67C5
+
+    mutating func consumeStripe(_ input: UnsafeRawBufferPointer, at position: Int) {
+        v1 = Self.round(v1, input.readLE64(position))
+        v2 = Self.round(v2, input.readLE64(position + 8))
+        v3 = Self.round(v3, input.readLE64(position + 16))
+        v4 = Self.round(v4, input.readLE64(position + 24))
+    }
+
+    @inline(__always)
+    static func round(_ accumulator: UInt64, _ input: UInt64) -> UInt64 {
+        (accumulator &+ input &* prime2).rotatedLeft(by: 31) &* prime1
+    }
+
+    @inline(__always)
+    static func mergeRound(_ accumulator: UInt64, _ value: UInt64) -> UInt64 {
+        (accumulator ^ round(0, value)) &* prime1 &+ prime4
+    }
+
+    static func mergedAccumulators(_ v1: UInt64, _ v2: UInt64, _ v3: UInt64, _ v4: UInt64) -> UInt64 {
+        var hash = v1.rotatedLeft(by: 1) &+ v2.rotatedLeft(by: 7) &+ v3.rotatedLeft(by: 12) &+ v4.rotatedLeft(by: 18)
+        hash = mergeRound(hash, v1)
+        hash = mergeRound(hash, v2)
+        hash = mergeRound(hash, v3)
+        return mergeRound(hash, v4)
+    }
+
+    /// Mixes the remaining less than 32 bytes into the hash.
+    static func finalize(_ hash: UInt64, _ input: UnsafeRawBufferPointer) -> UInt64 {
+        var hash = hash
+        var position = 0
+        var remaining = input.count
+        while remaining >= 8 {
+            hash ^= round(0, input.readLE64(position))
+            hash = hash.rotatedLeft(by: 27) &* prime1 &+ prime4
+            position += 8
+            remaining -= 8
+        }
+        if remaining >= 4 {
+            hash ^= UInt64(input.readLE32(position)) &* prime1
+            hash = hash.rotatedLeft(by: 23) &* prime2 &+ prime3
+            position += 4
+            remaining -= 4
+        }
+        while remaining > 0 {
+            hash ^= UInt64(input[position]) &* prime5
+            hash = hash.rotatedLeft(by: 11) &* prime1
+            position += 1
+            remaining -= 1
+        }
+        return avalanche(hash)
+    }
+
+    @inline(__always)
+    static func avalanche(_ hash: UInt64) -> UInt64 {
+        var hash = hash
+        hash ^= hash >> 33
+        hash &*= prime2
+        hash ^= hash >> 29
+        hash &*= prime3
+        hash ^= hash >> 32
+        return hash
+    }
+}
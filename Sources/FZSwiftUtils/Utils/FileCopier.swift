@@ -0,0 +1,484 @@
+//
+//  FileCopier.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+#if canImport(Darwin)
+import Darwin
+#elseif canImport(Glibc)
+import Glibc
+#endif
+
+/**
+ Copies a file or directory tree and reports the progress.
+
+ The copier first tries to clone the item, which shares the data blocks on file systems that support it (APFS), and copies the files of a directory tree concurrently otherwise. On Linux the data is copied with `copy_file_range`, which lets the kernel reflink or copy the data without passing it through user space. It falls back to copying the data in chunks.
+
+ ```swift
+ let copier = FileCopier(source: sourceURL, destination: destinationURL)
+ copier.progress.publish()
+ try await copier.copy()
+ ```
+
+ Besides the data, the copier copies the permissions, modification and access dates of every item. On Darwin it also copies the extended attributes, access control lists, resource forks and, where permitted, the ownership through `copyfile`. On Linux the extended attributes are copied, except those of namespaces the process isn't allowed to write. FIFOs are recreated, and the copy fails with `ENOTSUP` for sockets and devices.
+
+ The copy can be paused, resumed and cancelled, either by the copier or by its ``progress``. If the copy fails or is cancelled, the items it created are removed. Items that already existed at the destination are never removed.
+
+ A copier copies once.
+ */
+public final class FileCopier: Pausable {
+    /// The url of the file or directory to copy.
+    public let sourceURL: URL
+
+    /// The url the item is copied to. The copy fails if an item exists at the url.
+    public let destinationURL: URL
+
+    /// The progress of the copy. Its unit count is the number of copied bytes.
+    public let progress: Progress
+
+    /// The maximum number of files that are copied at the same time.
+    public var maxConcurrentFileCopies: Int = 4
+
+    /// The size of the chunks in which the data of a file is copied. The copy can be paused or cancelled after each chunk.
+    public var chunkSize: DataSize = .megabytes(1)
+
+    /// A Boolean value indicating whether the copier tries to clone the item before copying it.
+    public var clonesItems = true
+
+    /// The quality of service of the copy when it's started with the `async` ``copy()``.
+    public var qualityOfService: DispatchQoS.QoSClass = .utility
+
+    let condition = NSCondition()
+    var _isPaused = false
+    var isCancelled = false
+    var pauseDate: Date?
+    var pausedDuration: TimeInterval = 0
+    var error: Error?
+
+    let progressLock = NSLock()
+    var startDate = Date()
+    var lastProgressUpdate = Date.distantPast
+    var completedBytes: Int64 = 0
+
+    /**
+     Creates a copier for the specified item.
+
+     - Parameters:
+        - source: The url of the file or directory to copy.
+        - destination: The url the item is copied to.
+     */
+    public init(source: URL, destination: URL) {
+        sourceURL = source
+        destinationURL = destination
+        progress = Progress(totalUnitCount: 0)
+        progress.kind = .file
+        progress.fileOperationKind = .copying
+        progress.fileURL = destination
+        progress.isCancellable = true
+        progress.isPausable = true
+        progress.cancellationHandler = { [weak self] in
+            self?.cancel()
+        }
+        progress.pausingHandler = { [weak self] in
+            self?.pause()
+        }
+        progress.resumingHandler = { [weak self] in
+            self?.resume()
+        }
+    }
+
+    /**
+     Copies the item.
+
+     - Throws: `CancellationError` if the copy is cancelled, or an error if an item couldn't be copied.
+     */
+    public func copy() throws {
+        startDate = Date()
+        var info = stat()
+        guard lstat(sourceURL.path, &info) == 0 else { throw NSError.posix(errno) }
+        try checkpoint()
+        if clonesItems, clone() {
+            progress.totalUnitCount = info.isRegularFile ? Int64(info.st_size) : 1
+            progress.completedUnitCount = progress.totalUnitCount
+            return
+        }
+        // The destination isn't checked in advance, as an item could be created there before copying. Creating the destination fails instead if an item exists, and each step only removes what it created.
+        if info.isDirectory {
+            try copyDirectory(info)
+        } else if info.isRegularFile {
+            progress.totalUnitCount = Int64(info.st_size)
+            do {
+                try copyFile(at: sourceURL.path, to: destinationURL.path, info: info, buffer: nil)
+            } catch {
+                throw self.error ?? error
+            }
+        } else if info.isSymbolicLink {
+            try copySymbolicLink(at: sourceURL.path, to: destinationURL.path)
+        } else {
+            try copySpecialFile(at: sourceURL.path, to: destinationURL.path, info: info)
+        }
+        updateProgress(force: true)
+    }
+
+    /**
+     Copies the item on a background queue.
+
+     Cancelling the task cancels the copy.
+
+     - Throws: `CancellationError` if the copy is cancelled, or an error if an item couldn't be copied.
+     */
+    public func copy() async throws {
+        try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
+                DispatchQueue.global(qos: self.qualityOfService).async {
+                    do {
+                        try self.copy()
+                        continuation.resume()
+                    } catch {
+                        continuation.resume(throwing: error)
+                    }
+                }
+            }
+        } onCancel: {
+            self.cancel()
+        }
+    }
+
+    /// Cancels the copy.
+    public func cancel() {
+        condition.lock()
+        let wasCancelled = isCancelled
+        isCancelled = true
+        condition.broadcast()
+        condition.unlock()
+        if !wasCancelled, !progress.isCancelled {
+            progress.cancel()
+        }
+    }
+
+    /// Pauses the copy. The files that are being copied are paused after their current chunk.
+    public func pause() {
+        condition.lock()
+        let wasPaused = _isPaused
+        if !wasPaused {
+            _isPaused = true
+            pauseDate = Date()
+        }
+        condition.unlock()
+        if !wasPaused, !progress.isPaused {
+            progress.pause()
+        }
+    }
+
+    /// Resumes the copy.
+    public func resume() {
+        condition.lock()
+        let wasPaused = _isPaused
+        if wasPaused {
+            _isPaused = false
+            pausedDuration += Date().timeIntervalSince(pauseDate ?? Date())
+            pauseDate = nil
+        }
+        condition.broadcast()
+        condition.unlock()
+        if wasPaused, progress.isPaused {
+            progress.resume()
+        }
+    }
+
+    /// A Boolean value indicating whether the copy is paused.
+    public var isPaused: Bool {
+        condition.lock()
+        defer { condition.unlock() }
+        return _isPaused
+    }
+}
+
+extension FileCopier {
+    /// Clones the item and returns `true` if it succeeded.
+    func clone() -> Bool {
+        #if canImport(Darwin)
+        return sourceURL.withUnsafeFileSystemRepresentation { source in
+            destinationURL.withUnsafeFileSystemRepresentation { destination in
+                guard let source = source, let destination = destination else { return false }
+                return clonefile(source, destination, 0) == 0
+            }
+        }
+        #else
+        return false
+        #endif
+    }
+
+    func copyDirectory(_ info: stat) throws {
+        var rootPath = sourceURL.standardizedFileURL.path
+        if rootPath.count > 1, rootPath.hasSuffix("/") {
+            rootPath.removeLast()
+        }
+        let destinationPath = destinationURL.path
+        let entries = ParallelDirectoryWalker(url: sourceURL, options: [.includeSubdirectoryDescendants, .includeHiddenFiles, .includePackageDescendants]).sortedEntries()
+        func destination(for entry: ParallelDirectoryWalker.Entry) -> String {
+            destinationPath + entry.path.dropFirst(rootPath.count)
+        }
+
+        // Directories are created writable and get their permissions after their contents are copied.
+        var directories: [(source: String, destination: String, info: stat)] = [(sourceURL.path, destinationPath, info)]
+        guard mkdir(destinationPath, S_IRWXU) == 0 else { throw NSError.posix(errno) }
+        do {
+            try copyDirectoryContents(entries, directories: &directories, destination: destination)
+        } catch {
+            try? FileManager.default.removeItem(atPath: destinationPath)
+            throw self.error ?? error
+        }
+    }
+
+    func copyDirectoryContents(_ entries: [ParallelDirectoryWalker.Entry], directories: inout [(source: String, destination: String, info: stat)], destination: (ParallelDirectoryWalker.Entry) -> String) throws {
+        var files: [(source: String, destination: String)] = []
+        for entry in entries {
+            try checkpoint()
+            switch entry.type {
+            case .directory:
+                var info = stat()
+                guard lstat(entry.path, &info) == 0 else { throw NSError.posix(errno) }
+                let path = destination(entry)
+                guard mkdir(path, S_IRWXU) == 0 else { throw NSError.posix(errno) }
+                directories.append((entry.path, path, info))
+            case .regularFile:
+                files.append((entry.path, destination(entry)))
+            case .symbolicLink:
+                try copySymbolicLink(at: entry.path, to: destination(entry))
+            case .other:
+                var info = stat()
+                guard lstat(entry.path, &info) == 0 else { throw NSError.posix(errno) }
+                try copySpecialFile(at: entry.path, to: destination(entry), info: info)
+            }
+        }
+
+        var infos = [stat](repeating: stat(), count: files.count)
+        infos.withUnsafeMutableBufferPointer { infos in
+            DispatchQueue.concurrentPerform(iterations: files.count) { index in
+                if lstat(files[index].source, &infos[index]) != 0 {
+                    infos[index].st_size = 0
+                }
+            }
+        }
+        progress.totalUnitCount = infos.reduce(0) { $0 + Int64($1.st_size) }
+
+        let lock = NSLock()
+        var nextIndex = 0
+        DispatchQueue.concurrentPerform(iterations: max(1, min(maxConcurrentFileCopies, files.count))) { _ in
+            let buffer = UnsafeMutableRawBufferPointer.allocate(byteCount: max(1, chunkSize.bytes), alignment: 16)
+            defer { buffer.deallocate() }
+            while true {
+                lock.lock()
+                let index = nextIndex
+                nextIndex += 1
+                lock.unlock()
+                guard index < files.count else { return }
+                do {
+                    try copyFile(at: files[index].source, to: files[index].destination, info: infos[index], buffer: buffer)
+                } catch {
+                    stop(with: error)
+                    return
+                }
+            }
+        }
+        try checkpoint()
+
+        for directory in directories.reversed() {
+            try copyMetadata(at: directory.source, to: directory.destination, info: directory.info)
+        }
+    }
+
+    /// Copies the metadata of the directory or special file at the path.
+    func copyMetadata(at source: String, to destination: String, info: stat) throws {
+        #if canImport(Darwin)
+        // `COPYFILE_METADATA` includes the permissions and dates. They are only set separately if the file system doesn't support copying the metadata.
+        if copyfile(source, destination, nil, copyfile_flags_t(COPYFILE_METADATA)) == 0 { return }
+        guard errno == ENOTSUP else { throw NSError.posix(errno) }
+        #else
+        Self.copyExtendedAttributes(at: source, to: destination)
+        #endif
+        guard chmod(destination, info.st_mode & 0o7777) == 0 else { throw NSError.posix(errno) }
+        var times = [info.accessTimespec, info.modificationTimespec]
+        guard utimensat(AT_FDCWD, destination, &times, 0) == 0 else { throw NSError.posix(errno) }
+    }
+
+    #if !canImport(Darwin)
+    /// Copies the extended attributes that the process is allowed to write.
+    static func copyExtendedAttributes(at source: String, to destination: String) {
+        guard let attributes = try? URL(fileURLWithPath: source).extendedAttributes.readAll() else { return }
+        let destination = URL(fileURLWithPath: destination).extendedAttributes
+        for (key, data) in attributes.data {
+            try? destination.writeAll([key: data])
+        }
+    }
+    #endif
+
+    /// Recreates a FIFO. Sockets and devices can't be copied.
+    func copySpecialFile(at source: String, to destination: String, info: stat) throws {
+        guard info.st_mode & S_IFMT == S_IFIFO else { throw NSError.posix(ENOTSUP) }
+        guard mkfifo(destination, S_IRUSR | S_IWUSR) == 0 else { throw NSError.posix(errno) }
+        do {
+            try copyMetadata(at: source, to: destination, info: info)
+        } catch {
+            unlink(destination)
+            throw error
+        }
+    }
+
+    /// Copies the data and metadata of the file. The file is removed if it can't be copied completely.
+    func copyFile(at source: String, to destination: String, info: stat, buffer: UnsafeMutableRawBufferPointer?) throws {
+        let input = open(source, O_RDONLY | O_CLOEXEC)
+        guard input >= 0 else { throw NSError.posix(errno) }
+        defer { close(input) }
+        let output = open(destination, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, S_IRUSR | S_IWUSR)
+        guard output >= 0 else { throw NSError.posix(errno) }
+        defer { close(output) }
+        do {
+            try copyData(from: input, to: output, buffer: buffer)
+            try copyMetadata(from: input, to: output, source: source, destination: destination, info: info)
+        } catch {
+            unlink(destination)
+            throw error
+        }
+    }
+
+    func copyData(from input: Int32, to output: Int32, buffer: UnsafeMutableRawBufferPointer?) throws {
+        let chunkSize = max(1, chunkSize.bytes)
+        #if os(Linux)
+        var usesCopyFileRange = true
+        var copiedBytes = 0
+        while usesCopyFileRange {
+            try checkpoint()
+            let count = copy_file_range(input, nil, output, nil, chunkSize, 0)
+            if count > 0 {
+                copiedBytes += count
+                addCompletedBytes(count)
+            } else if count == 0 {
+                break
+            } else if copiedBytes == 0, [EXDEV, ENOSYS, EINVAL, EOPNOTSUPP].contains(errno) {
+                usesCopyFileRange = false
+            } else {
+                throw NSError.posix(errno)
+            }
+        }
+        if !usesCopyFileRange {
+            try copyChunks(from: input, to: output, chunkSize: chunkSize, buffer: buffer)
+        }
+        #else
+        try copyChunks(from: input, to: output, chunkSize: chunkSize, buffer: buffer)
+        #endif
+    }
+
+    /// Copies the metadata of the open file.
+    func copyMetadata(from input: Int32, to output: Int32, source: String, destination: String, info: stat) throws {
+        #if canImport(Darwin)
+        if fcopyfile(input, output, nil, copyfile_flags_t(COPYFILE_METADATA)) == 0 { return }
+        guard errno == ENOTSUP else { throw NSError.posix(errno) }
+        #else
+        Self.copyExtendedAttributes(at: source, to: destination)
+        #endif
+        guard fchmod(output, info.st_mode & 0o7777) == 0 else { throw NSError.posix(errno) }
+        var times = [info.accessTimespec, info.modificationTimespec]
+        guard futimens(output, &times) == 0 else { throw NSError.posix(errno) }
+    }
+
+    func copyChunks(from input: Int32, to output: Int32, chunkSize: Int, buffer: UnsafeMutableRawBufferPointer?) throws {
+        let ownedBuffer = buffer == nil ? UnsafeMutableRawBufferPointer.allocate(byteCount: chunkSize, alignment: 16) : nil
+        defer { ownedBuffer?.deallocate() }
+        guard let buffer = buffer ?? ownedBuffer else { return }
+        while true {
+            try checkpoint()
+            let count = read(input, buffer.baseAddress, min(chunkSize, buffer.count))
+            guard count >= 0 else { throw NSError.posix(errno) }
+            guard count > 0 else { return }
+            var written = 0
+            while written < count {
+                let result = write(output, buffer.baseAddress! + written, count - written)
+                guard result >= 0 else { throw NSError.posix(errno) }
+                written += result
+            }
+            addCompletedBytes(count)
+        }
+    }
+
+    func copySymbolicLink(at source: String, to destination: String) throws {
+        var target = [CChar](repeating: 0, count: Int(PATH_MAX) + 1)
+        let length = readlink(source, &target, target.count - 1)
+        guard length >= 0 else { throw NSError.posix(errno) }
+        target[length] = 0
+        guard symlink(target, destination) == 0 else { throw NSError.posix(errno) }
+    }
+
+    /// Waits while the copy is paused and throws if it's cancelled or failed.
+    func checkpoint() throws {
+        condition.lock()
+        defer { condition.unlock() }
+        while _isPaused, !isCancelled, error == nil {
+            condition.wait()
+        }
+        if isCancelled || error != nil {
+            throw CancellationError()
+        }
+    }
+
+    /// Stops the copy after a file failed to copy.
+    func stop(with error: Error) {
+        condition.lock()
+        if self.error == nil, !(error is CancellationError) {
+            self.error = error
+        }
+        condition.broadcast()
+        condition.unlock()
+    }
+
+    func addCompletedBytes(_ count: Int) {
+        progressLock.lock()
+        completedBytes += Int64(count)
+        progressLock.unlock()
+        updateProgress(force: false)
+    }
+
+    /// Updates the completed unit count, throughput and estimated time remaining of the progress, at most ten times per second.
+    func updateProgress(force: Bool) {
+        let now = Date()
+        progressLock.lock()
+        guard force || now.timeIntervalSince(lastProgressUpdate) >= 0.1 else {
+            progressLock.unlock()
+            return
+        }
+        lastProgressUpdate = now
+        let completedBytes = completedBytes
+        progressLock.unlock()
+        condition.lock()
+        let elapsedTime = now.timeIntervalSince(startDate) - pausedDuration
+        condition.unlock()
+        progress.completedUnitCount = completedBytes
+        progress.updateEstimatedTimeRemaining(timeElapsed: elapsedTime)
+    }
+}
+
+extension stat {
+    var isSymbolicLink: Bool {
+        st_mode & S_IFMT == S_IFLNK
+    }
+
+    var accessTimespec: timespec {
+        #if canImport(Darwin)
+        return st_atimespec
+        #else
+        return st_atim
+        #endif
+    }
+
+    var modificationTimespec: timespec {
+        #if canImport(Darwin)
+        return st_mtimespec
+        #else
+        return st_mtim
+        #endif
+    }
+}
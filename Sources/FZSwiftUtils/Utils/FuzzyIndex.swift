@@ -0,0 +1,395 @@
+//
+//  FuzzyIndex.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ An index for fuzzy searching large collections of strings.
+
+ The index maps the trigrams of the words of each string to the strings containing them. A search only scores the strings that share enough trigrams with the query, instead of every string of the collection:
+
+ ```swift
+ let index = FuzzyIndex(["Harry Potter and the Chamber of Secrets", "The Lord of the Rings", "Pride and Prejudice"])
+ let results = index.search("chambr of secrts")
+ results.first?.key // 0
+ results.first?.match.string // "Chamber of Secrets"
+ ```
+
+ The strings are compared case-insensitively. Each result is scored by the edit distance between the query and the most similar part of the string, so the query can also match inside a word, like `amber` in `Chamber`.
+
+ Queries without a word of at least three characters can't be matched by trigrams inside words. They only match the strings containing a word that starts with the query.
+ */
+public struct FuzzyIndex<Key: Hashable> {
+    /// The keys of the entries, or `nil` for removed entries.
+    var keys: [Key?] = []
+    /// The strings of the entries, or `nil` for removed entries.
+    var strings: [String?] = []
+    var ids: [Key: Int32] = [:]
+    /// The ids of the entries containing each trigram in ascending order, sharded by trigram.
+    var postings: [[UInt64: [Int32]]] = Array(repeating: [:], count: FuzzyIndex.shardCount)
+    var removedCount = 0
+
+    static var shardCount: Int { 64 }
+
+    /// Creates an empty index.
+    public init() {}
+
+    /**
+     Creates an index of the specified records.
+
+     The trigrams of the strings are extracted and indexed concurrently. If a key appears more than once, the last string is used.
+
+     - Parameter records: The keys and strings to index.
+     */
+    public init<S: Sequence>(_ records: S) where S.Element == (key: Key, string: String) {
+        var records = Array(records)
+        var positions: [Key: Int] = [:]
+        for (position, record) in records.enumerated() {
+            positions[record.key] = position
+        }
+        if positions.count < records.count {
+            records = records.enumerated().filter { positions[$0.element.key] == $0.offset }.map(\.element)
+        }
+        self.init(uniqueRecords: records)
+    }
+
+    /// Creates an index of records with unique keys.
+    init(uniqueRecords records: [(key: Key, string: String)]) {
+        keys = records.map(\.key)
+        strings = records.map(\.string)
+        ids.reserveCapacity(records.count)
+        for (id, record) in records.enumerated() {
+            ids[record.key] = Int32(id)
+        }
+
+        // The trigrams of each chunk of strings are partitioned by shard while they are extracted, so that each shard only reads its own trigrams.
+        let chunkSize = 1024
+        let chunkCount = (records.count + chunkSize - 1) / chunkSize
+        var partitions = [[[(trigram: UInt64, id: Int32)]]](repeating: [], count: chunkCount)
+        partitions.withUnsafeMutableBufferPointer { partitions in
+            DispatchQueue.concurrentPerform(iterations: chunkCount) { chunk in
+                var shards = [[(trigram: UInt64, id: Int32)]](repeating: [], count: Self.shardCount)
+                for id in chunk * chunkSize ..< Swift.min(records.count, (chunk + 1) * chunkSize) {
+                    for trigram in Self.trigrams(of: records[id].string) {
+                        shards[Self.shard(of: trigram)].append((trigram, Int32(id)))
+                    }
+                }
+                partitions[chunk] = shards
+            }
+        }
+        // Each shard collects its trigrams in the order of the chunks, so that the posting lists are sorted.
+        postings.withUnsafeMutableBufferPointer { postings in
+            DispatchQueue.concurrentPerform(iterations: Self.shardCount) { shard in
+                var shardPostings: [UInt64: [Int32]] = [:]
+                for partition in partitions {
+                    for (trigram, id) in partition[shard] {
+                        shardPostings[trigram, default: []].append(id)
+                    }
+                }
+                postings[shard] = shardPostings
+            }
+        }
+    }
+
+    /// The number of strings in the index.
+    public var count: Int {
+        ids.count
+    }
+
+    /// A Boolean value indicating whether the index is empty.
+    public var isEmpty: Bool {
+        ids.isEmpty
+    }
+
+    /// Returns the string for the specified key.
+    public subscript(key: Key) -> String? {
+        guard let id = ids[key] else { return nil }
+        return strings[Int(id)]
+    }
+
+    /**
+     Adds the specified string to the index, replacing the string for the key if it already exists.
+
+     - Parameters:
+        - string: The string to index.
+        - key: The key of the string.
+     */
+    public mutating func insert(_ string: String, forKey key: Key) {
+        removeValue(forKey: key)
+        let id = Int32(strings.count)
+        keys.append(key)
+        strings.append(string)
+        ids[key] = id
+        for trigram in Self.trigrams(of: string) {
+            postings[Self.shard(of: trigram)][trigram, default: []].append(id)
+        }
+    }
+
+    /**
+     Removes the string for the specified key from the index.
+
+     - Parameter key: The key of the string to remove.
+     - Returns: The removed string, or `nil` if the key isn't in the index.
+     */
+    @discardableResult
+    public mutating func removeValue(forKey key: Key) -> String? {
+        guard let id = ids.removeValue(forKey: key).map({ Int($0) }) else { return nil }
+        let string = strings[id]
+        strings[id] = nil
+        keys[id] = nil
+        removedCount += 1
+        if removedCount > 1024, removedCount > ids.count {
+            compact()
+        }
+        return string
+    }
+
+    /// Removes all strings from the index.
+    public mutating func removeAll() {
+        self = FuzzyIndex()
+    }
+
+    /**
+     Searches the index for the strings that are most similar to the specified query.
+
+     The strings are ranked by the edit distance between the query and their most similar part. The match of each result is that part of the string, and its score is `100` for an exact match and decreases with each edit.
+
+     - Parameters:
+        - query: The string to search for.
+        - limit: The maximum number of results.
+        - maximumEditDistance: The maximum number of edits between the query and a matching string. The default value allows one edit for every five characters of the query, and no edits for queries without a word of at least three characters.
+     - Returns: The keys and matches of the most similar strings, ordered by their similarity.
+     */
+    public func search(_ query: String, limit: Int = 10, maximumEditDistance: Int? = nil) -> [(key: Key, match: StringMatch)] {
+        let pattern = query.unicodeScalars.map(Self.normalized)
+        // The query can start and end inside a word of a string, so the padded trigrams at its start and end aren't required.
+        var queryTrigrams = Self.trigrams(of: pattern, padsStart: false, padsEnd: false)
+        var defaultEditDistance = Swift.max(1, pattern.count / 5)
+        if queryTrigrams.isEmpty {
+            // Short queries are matched at the start of words, where the padded trigrams are complete.
+            queryTrigrams = Self.trigrams(of: pattern, padsEnd: false)
+            defaultEditDistance = 0
+        }
+        guard limit > 0, !queryTrigrams.isEmpty else { return [] }
+        let maximumEditDistance = maximumEditDistance ?? defaultEditDistance
+
+        // Every edit changes at most three trigrams of the query.
+        let lists = queryTrigrams.map { postings[Self.shard(of: $0)][$0] ?? [] }.sorted { $0.count < $1.count }
+        let threshold = Swift.max(1, lists.count - 3 * maximumEditDistance)
+        let candidates = Self.candidates(in: lists, threshold: threshold)
+
+        var results: [(id: Int, distance: Int, range: Range<String.Index>)] = []
+        var text: [UInt32] = []
+        var indices: [String.Index] = []
+        for id in candidates {
+            guard let string = strings[id] else { continue }
+            text.removeAll(keepingCapacity: true)
+            indices.removeAll(keepingCapacity: true)
+            let scalars = string.unicodeScalars
+            for index in scalars.indices {
+                text.append(Self.normalized(scalars[index]))
+                indices.append(index)
+            }
+            indices.append(scalars.endIndex)
+            guard let match = Self.bestMatch(of: pattern, in: text), match.distance <= maximumEditDistance else { continue }
+            results.append((id, match.distance, indices[match.range.lowerBound] ..< indices[match.range.upperBound]))
+        }
+
+        results.sort { $0.distance != $1.distance ? $0.distance < $1.distance : strings[$0.id]!.utf8.count < strings[$1.id]!.utf8.count }
+        return results.prefix(limit).map { result in
+            let string = strings[result.id]!
+            let score = Swift.max(0, 100 - result.distance * 100 / pattern.count)
+            return (keys[result.id]!, StringMatch(string: String(Substring(string.unicodeScalars[result.range])), range: result.range, score: score))
+        }
+    }
+
+    /// Rebuilds the index without the removed strings.
+    mutating func compact() {
+        self = FuzzyIndex(uniqueRecords: zip(keys, strings).compactMap { key, string in
+            guard let key = key, let string = string else { return nil }
+            return (key: key, string: string)
+        })
+    }
+}
+
+public extension FuzzyIndex where Key == Int {
+    /**
+     Creates an index of the specified strings, using their positions as keys.
+
+     - Parameter strings: The strings to index.
+     */
+    init(_ strings: [String]) {
+        self.init(strings.enumerated().map { (key: $0.offset, string: $0.element) })
+    }
+}
+
+extension FuzzyIndex: Sendable where Key: Sendable {}
+
+extension FuzzyIndex {
+    /**
+     Returns the ids that are contained in at least `threshold` of the sorted posting lists.
+
+     An id contained in `threshold` lists has to be contained in one of the `lists.count - threshold + 1` shortest lists. Only these lists are merged, the longer lists are searched for the merged ids.
+     */
+    static func candidates(in lists: [[Int32]], threshold: Int) -> [Int] {
+        let mergedCount = lists.count - threshold + 1
+        var merged = lists[..<mergedCount].flatMap { $0 }
+        merged.sort()
+
+        var candidates: [(id: Int32, count: Int)] = []
+        var index = 0
+        while index < merged.count {
+            let id = merged[index]
+            var end = index + 1
+            while end < merged.count, merged[end] == id {
+                end += 1
+            }
+            candidates.append((id, end - index))
+            index = end
+        }
+
+        for list in lists[mergedCount...] {
+            var lowerBound = 0
+            for candidate in candidates.indices {
+                lowerBound = list.lowerBound(of: candidates[candidate].id, from: lowerBound)
+                if lowerBound < list.count, list[lowerBound] == candidates[candidate].id {
+                    candidates[candidate].count += 1
+                }
+            }
+        }
+        return candidates.filter { $0.count >= threshold }.map { Int($0.id) }
+    }
+
+    /**
+     Returns the smallest edit distance between the pattern and any part of the text, and the range of that part.
+
+     The distance is computed with Sellers' variant of the Levenshtein algorithm, where the match can start and end anywhere in the text.
+     */
+    static func bestMatch(of pattern: [UInt32], in text: [UInt32]) -> (distance: Int, range: Range<Int>)? {
+        guard !pattern.isEmpty, !text.isEmpty else { return nil }
+        let rows = pattern.count + 1
+        var previous = Array(0 ..< rows)
+        var current = [Int](repeating: 0, count: rows)
+        var previousStarts = [Int](repeating: 0, count: rows)
+        var currentStarts = [Int](repeating: 0, count: rows)
+        var best: (distance: Int, range: Range<Int>) = (pattern.count, 0 ..< 0)
+
+        for (position, character) in text.enumerated() {
+            current[0] = 0
+            currentStarts[0] = position + 1
+            for row in 1 ..< rows {
+                let substitution = previous[row - 1] + (pattern[row - 1] == character ? 0 : 1)
+                let deletion = previous[row] + 1
+                let insertion = current[row - 1] + 1
+                if substitution <= deletion, substitution <= insertion {
+                    current[row] = substitution
+                    currentStarts[row] = previousStarts[row - 1]
+                } else if deletion <= insertion {
+                    current[row] = deletion
+                    currentStarts[row] = previousStarts[row]
+                } else {
+                    current[row] = insertion
+                    currentStarts[row] = currentStarts[row - 1]
+                }
+            }
+            if current[rows - 1] < best.distance {
+                best = (current[rows - 1], currentStarts[rows - 1] ..< position + 1)
+            }
+            swap(&previous, &current)
+            swap(&previousStarts, &currentStarts)
+        }
+        return best.range.isEmpty ? nil : best
+    }
+
+    /// Returns the unique trigrams of the words of the string.
+    static func trigrams(of string: String) -> [UInt64] {
+        trigrams(of: string.unicodeScalars.map(normalized))
+    }
+
+    /**
+     Returns the unique trigrams of the words of the normalized scalars, each word is padded with two spaces at the start and one at the end.
+
+     - Parameters:
+        - scalars: The normalized scalars.
+        - padsStart: A Boolean value indicating whether the trigrams with the padding at the start of the first word are included.
+        - padsEnd: A Boolean value indicating whether the trigram with the padding at the end of the last word is included.
+     */
+    static func trigrams(of scalars: [UInt32], padsStart: Bool = true, padsEnd: Bool = true) -> [UInt64] {
+        var trigrams: Set<UInt64> = []
+        var first: UInt64 = 0x20
+        var second: UInt64 = 0x20
+        var isInWord = false
+        var isFirstWord = true
+        var wordLength = 0
+        for scalar in scalars {
+            if isWordCharacter(scalar) {
+                let third = UInt64(scalar)
+                if padsStart || !isFirstWord || wordLength >= 2 {
+                    trigrams.insert(first << 42 | second << 21 | third)
+                }
+                first = second
+                second = third
+                isInWord = true
+                wordLength += 1
+            } else if isInWord {
+                if padsStart || !isFirstWord || wordLength >= 2 {
+                    trigrams.insert(first << 42 | second << 21 | 0x20)
+                }
+                first = 0x20
+                second = 0x20
+                isInWord = false
+                isFirstWord = false
+                wordLength = 0
+            }
+        }
+        if isInWord, padsEnd, padsStart || !isFirstWord || wordLength >= 2 {
+            trigrams.insert(first << 42 | second << 21 | 0x20)
+        }
+        return Array(trigrams)
+    }
+
+    @inline(__always)
+    static func shard(of trigram: UInt64) -> Int {
+        Int(truncatingIfNeeded: (trigram &* 0x9E37_79B9_7F4A_7C15) >> 58)
+    }
+
+    /// Returns the lowercased value of the scalar.
+    @inline(__always)
+    static func normalized(_ scalar: Unicode.Scalar) -> UInt32 {
+        let value = scalar.value
+        if value < 0x80 {
+            return value &- 0x41 < 26 ? value | 0x20 : value
+        }
+        return scalar.properties.lowercaseMapping.unicodeScalars.first?.value ?? value
+    }
+
+    @inline(__always)
+    static func isWordCharacter(_ value: UInt32) -> Bool {
+        if value < 0x80 {
+            return (value | 0x20) &- 0x61 < 26 || value &- 0x30 < 10
+        }
+        guard let scalar = Unicode.Scalar(value) else { return false }
+        return scalar.properties.isAlphabetic || scalar.properties.numericType != nil
+    }
+}
+
+private extension Array where Element == Int32 {
+    /// Returns the index of the first element that isn't less than the value, searching from the specified index.
+    func lowerBound(of value: Int32, from index: Int) -> Int {
+        var low = index
+        var high = count
+        while low < high {
+            let mid = (low + high) / 2
+            if self[mid] < value {
+                low = mid + 1
+            } else {
+                high = mid
+            }
+        }
+        return low
+    }
+}
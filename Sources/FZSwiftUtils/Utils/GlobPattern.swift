@@ -0,0 +1,356 @@
+//
+//  GlobPattern.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ A compiled glob pattern for matching file paths.
+
+ The pattern is compiled once and matched against the bytes of a path, without creating strings for the path or its components.
+
+ - `*` matches any characters except `/`.
+ - `**` matches any characters including `/`. `**/` matches zero or more directories.
+ - `?` matches a single character except `/`.
+ - `[abc]`, `[a-z]` match a character of the set, `[!abc]` and `[^abc]` a character that isn't part of the set.
+ - `\` matches the following character literally.
+ - A leading `!` negates the pattern.
+
+ Patterns and paths are compared in their precomposed Unicode form, so a pattern matches the decomposed paths that some file systems return as well.
+
+ A pattern without `/` is matched against the name of the item, e.g. `*.jpg`. A pattern starting with `/` is matched against the whole path. Any other pattern is matched against the end of the path, e.g. `cache/*.db` matches `/Users/Florian/cache/index.db`.
+
+ ```swift
+ let pattern = GlobPattern("**/cache/**")
+ pattern.matches("/Users/Florian/Library/cache/images/1.png") // true
+ ```
+ */
+public struct GlobPattern: Hashable, CustomStringConvertible, ExpressibleByStringLiteral {
+    /// The pattern.
+    public let pattern: String
+
+    /// A Boolean value indicating whether the pattern matches case sensitive.
+    public let isCaseSensitive: Bool
+
+    /// A Boolean value indicating whether the pattern is negated and matches the paths that don't match it.
+    public let isNegated: Bool
+
+    let tokens: [Token]
+    /// A Boolean value indicating whether the pattern is matched against the name of the item instead of its path.
+    let matchesName: Bool
+
+    /**
+     Creates a pattern.
+
+     - Parameters:
+        - pattern: The glob pattern.
+        - caseSensitive: A Boolean value indicating whether the pattern matches case sensitive. Matching case insensitive folds ASCII letters.
+     */
+    public init(_ pattern: String, caseSensitive: Bool = true) {
+        self.pattern = pattern
+        isCaseSensitive = caseSensitive
+        var scalars = Array(pattern.precomposedStringWithCanonicalMapping.unicodeScalars)
+        isNegated = scalars.first == "!"
+        if isNegated {
+            scalars.removeFirst()
+        }
+        matchesName = !scalars.contains("/")
+        var tokens = Self.compile(scalars, caseSensitive: caseSensitive)
+        if !matchesName, scalars.first != "/", tokens.first != .globstar, tokens.first != .globstarSlash {
+            tokens.insert(.globstarSlash, at: 0)
+        }
+        self.tokens = tokens
+    }
+
+    public init(stringLiteral value: String) {
+        self.init(value)
+    }
+
+    public var description: String {
+        pattern
+    }
+
+    /// Returns a Boolean value indicating whether the path matches the pattern.
+    public func matches(_ path: String) -> Bool {
+        var path = path
+        return path.withUTF8 { matches(bytes: $0) }
+    }
+
+    /// Returns a Boolean value indicating whether the path of the file url matches the pattern.
+    public func matches(_ url: URL) -> Bool {
+        url.withPathBytes { matches(bytes: $0) }
+    }
+
+    /// Returns a Boolean value indicating whether the UTF-8 bytes of the path match the pattern.
+    public func matches(bytes path: UnsafeBufferPointer<UInt8>) -> Bool {
+        path.withPrecomposedBytes { matchesIgnoringNegation($0) != isNegated }
+    }
+
+    func matchesIgnoringNegation(_ path: UnsafeBufferPointer<UInt8>) -> Bool {
+        var path = path.trimmingTrailingSlashes()
+        if matchesName, let separator = path.lastIndex(of: UInt8(ascii: "/")) {
+            path = UnsafeBufferPointer(rebasing: path[(separator + 1)...])
+        }
+        let count = tokens.count + 1
+        // The pattern is matched by simulating its automaton, so the time is linear in the length of the path for every pattern.
+        return withUnsafeTemporaryAllocation(of: Bool.self, capacity: count * 2) { states in
+            var current = UnsafeMutableBufferPointer(rebasing: states[0..<count])
+            var next = UnsafeMutableBufferPointer(rebasing: states[count...])
+            current.initialize(repeating: false)
+            next.initialize(repeating: false)
+            enter(0, in: current)
+            var index = 0
+            while index < path.count {
+                let scalar = Self.decodeScalar(path, at: &index)
+                let folded = isCaseSensitive ? scalar : Self.lowercased(scalar)
+                var isActive = false
+                for state in 0..<tokens.count where current[state] {
+                    switch tokens[state] {
+                    case let .scalar(value):
+                        if folded == value { enter(state + 1, in: next); isActive = true }
+                    case .any:
+                        if scalar != 0x2F { enter(state + 1, in: next); isActive = true }
+                    case let .set(characterClass):
+                        if scalar != 0x2F, characterClass.contains(scalar, caseSensitive: isCaseSensitive) { enter(state + 1, in: next); isActive = true }
+                    case .star:
+                        if scalar != 0x2F { enter(state, in: next); isActive = true }
+                    case .globstar:
+                        enter(state, in: next)
+                        isActive = true
+                    case .globstarSlash:
+                        next[state] = true
+                        if scalar == 0x2F { enter(state + 1, in: next) }
+                        isActive = true
+                    }
+                }
+                guard isActive else { return false }
+                swap(&current, &next)
+                next.update(repeating: false)
+            }
+            return current[tokens.count]
+        }
+    }
+
+    /// Activates the state and the states that follow it without consuming a character.
+    func enter(_ state: Int, in states: UnsafeMutableBufferPointer<Bool>) {
+        var state = state
+        while true {
+            states[state] = true
+            guard state < tokens.count else { return }
+            switch tokens[state] {
+            case .star, .globstar, .globstarSlash:
+                state += 1
+            default:
+                return
+            }
+        }
+    }
+}
+
+public extension Collection where Element == GlobPattern {
+    /**
+     Returns a Boolean value indicating whether the path of the file url matches the patterns.
+
+     The path matches if it matches any of the patterns that aren't negated, or if all patterns are negated, and it matches none of the negated patterns.
+     */
+    func matches(_ url: URL) -> Bool {
+        url.withPathBytes { matches(bytes: $0) }
+    }
+
+    /**
+     Returns a Boolean value indicating whether the path matches the patterns.
+
+     The path matches if it matches any of the patterns that aren't negated, or if all patterns are negated, and it matches none of the negated patterns.
+     */
+    func matches(_ path: String) -> Bool {
+        var path = path
+        return path.withUTF8 { matches(bytes: $0) }
+    }
+
+    /// Returns a Boolean value indicating whether the UTF-8 bytes of the path match the patterns.
+    func matches(bytes path: UnsafeBufferPointer<UInt8>) -> Bool {
+        path.withPrecomposedBytes { matchesPrecomposed($0) }
+    }
+
+    internal func matchesPrecomposed(_ path: UnsafeBufferPointer<UInt8>) -> Bool {
+        var isIncluded = true
+        for pattern in self where !pattern.isNegated {
+            isIncluded = pattern.matchesIgnoringNegation(path)
+            if isIncluded { break }
+        }
+        guard isIncluded else { return false }
+        return !contains(where: { $0.isNegated && $0.matchesIgnoringNegation(path) })
+    }
+}
+
+extension GlobPattern {
+    enum Token: Hashable {
+        case scalar(UInt32)
+        case any
+        case set(CharacterClass)
+        case star
+        case globstar
+        /// `**/`
+        case globstarSlash
+    }
+
+    struct CharacterClass: Hashable {
+        var ranges: [ClosedRange<UInt32>] = []
+        var isNegated = false
+
+        func contains(_ scalar: UInt32, caseSensitive: Bool) -> Bool {
+            var contains = ranges.contains(where: { $0.contains(scalar) })
+            if !contains, !caseSensitive {
+                let lowercased = GlobPattern.lowercased(scalar)
+                let uppercased = GlobPattern.uppercased(scalar)
+                contains = ranges.contains(where: { $0.contains(lowercased) || $0.contains(uppercased) })
+            }
+            return contains != isNegated
+        }
+    }
+
+    static func compile(_ scalars: [Unicode.Scalar], caseSensitive: Bool) -> [Token] {
+        var tokens: [Token] = []
+        var index = 0
+        func literal(_ scalar: Unicode.Scalar) -> Token {
+            .scalar(caseSensitive ? scalar.value : lowercased(scalar.value))
+        }
+        while index < scalars.count {
+            let scalar = scalars[index]
+            index += 1
+            switch scalar {
+            case "\\":
+                if index < scalars.count {
+                    tokens.append(literal(scalars[index]))
+                    index += 1
+                } else {
+                    tokens.append(literal(scalar))
+                }
+            case "?":
+                tokens.append(.any)
+            case "*":
+                if index < scalars.count, scalars[index] == "*" {
+                    while index < scalars.count, scalars[index] == "*" {
+                        index += 1
+                    }
+                    if index < scalars.count, scalars[index] == "/" {
+                        index += 1
+                        tokens.append(.globstarSlash)
+                    } else if tokens.last != .globstar {
+                        tokens.append(.globstar)
+                    }
+                } else if tokens.last != .star {
+                    tokens.append(.star)
+                }
+            case "[":
+                if let (characterClass, end) = compileClass(scalars, from: index) {
+                    tokens.append(.set(characterClass))
+                    index = end
+                } else {
+                    tokens.append(literal(scalar))
+                }
+            default:
+                tokens.append(literal(scalar))
+            }
+        }
+        return tokens
+    }
+
+    /// Compiles the character class starting after `[` and returns it with the index after the closing `]`, or `nil` if the class isn't closed.
+    static func compileClass(_ scalars: [Unicode.Scalar], from start: Int) -> (CharacterClass, Int)? {
+        var characterClass = CharacterClass()
+        var index = start
+        if index < scalars.count, scalars[index] == "!" || scalars[index] == "^" {
+            characterClass.isNegated = true
+            index += 1
+        }
+        let firstIndex = index
+        while index < scalars.count {
+            var lower = scalars[index]
+            if lower == "]", index > firstIndex {
+                return (characterClass, index + 1)
+            }
+            if lower == "\\", index + 1 < scalars.count {
+                index += 1
+                lower = scalars[index]
+            }
+            index += 1
+            if index + 1 < scalars.count, scalars[index] == "-", scalars[index + 1] != "]" {
+                let upper = scalars[index + 1]
+                index += 2
+                characterClass.ranges.append(min(lower.value, upper.value)...max(lower.value, upper.value))
+            } else {
+                characterClass.ranges.append(lower.value...lower.value)
+            }
+        }
+        return nil
+    }
+
+    /// Decodes the UTF-8 encoded scalar at the index. Invalid bytes are returned as they are.
+    static func decodeScalar(_ bytes: UnsafeBufferPointer<UInt8>, at index: inout Int) -> UInt32 {
+        let lead = UInt32(bytes[index])
+        let length: Int
+        switch lead {
+        case 0xC0..<0xE0: length = 2
+        case 0xE0..<0xF0: length = 3
+        case 0xF0..<0xF8: length = 4
+        default: length = 1
+        }
+        guard length > 1, index + length <= bytes.count else {
+            index += 1
+            return lead
+        }
+        var scalar = lead & (0xFF >> (length + 1))
+        for offset in 1..<length {
+            let byte = UInt32(bytes[index + offset])
+            guard byte & 0xC0 == 0x80 else {
+                index += 1
+                return lead
+            }
+            scalar = scalar << 6 | byte & 0x3F
+        }
+        index += length
+        return scalar
+    }
+
+    static func lowercased(_ scalar: UInt32) -> UInt32 {
+        (0x41...0x5A).contains(scalar) ? scalar + 0x20 : scalar
+    }
+
+    static func uppercased(_ scalar: UInt32) -> UInt32 {
+        (0x61...0x7A).contains(scalar) ? scalar - 0x20 : scalar
+    }
+}
+
+extension UnsafeBufferPointer where Element == UInt8 {
+    func trimmingTrailingSlashes() -> UnsafeBufferPointer<UInt8> {
+        var end = count
+        while end > 1, self[end - 1] == UInt8(ascii: "/") {
+            end -= 1
+        }
+        return UnsafeBufferPointer(rebasing: self[0..<end])
+    }
+
+    /// Calls the handler with the bytes in precomposed form. Paths of ASCII characters are passed unchanged.
+    func withPrecomposedBytes<Result>(_ body: (UnsafeBufferPointer<UInt8>) -> Result) -> Result {
+        guard contains(where: { $0 >= 0x80 }) else { return body(self) }
+        var string = String(decoding: self, as: UTF8.self).precomposedStringWithCanonicalMapping
+        return string.withUTF8(body)
+    }
+}
+
+extension URL {
+    /// Calls the handler with the bytes of the file system representation of the path.
+    func withPathBytes<Result>(_ body: (UnsafeBufferPointer<UInt8>) -> Result) -> Result {
+        withUnsafeFileSystemRepresentation { path in
+            guard let path = path else { return body(UnsafeBufferPointer(start: nil, count: 0)) }
+            let length = strlen(path)
+            return path.withMemoryRebound(to: UInt8.self, capacity: length + 1) {
+                body(UnsafeBufferPointer(start: $0, count: length))
+            }
+        }
+    }
+}
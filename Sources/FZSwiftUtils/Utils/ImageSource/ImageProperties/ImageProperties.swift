@@ -186,6 +186,9 @@ extension ImageProperties {
     static var encoder: JSONEncoder {
         .init(dateEncodingStrategy: .formatted("yyyy:MM:dd HH:mm:ss"))
     }
+
+    /// The decoder for decoding image properties directly from the property dictionaries of image sources.
+    static let dictionaryDecoder = DictionaryDecoder(decoder)
 }
 
 public extension ImageProperties {
@@ -52,7 +52,7 @@ public class ImageSource {
      */
     public func properties() -> ImageProperties? {
         let rawValue = CGImageSourceCopyProperties(cgImageSource, nil) as? [String: Any] ?? [:]
-        return rawValue.toModel(ImageProperties.self, decoder: ImageProperties.decoder)
+        return rawValue.toModel(ImageProperties.self, decoder: ImageProperties.dictionaryDecoder)
     }
 
     /**
@@ -60,7 +60,7 @@ public class ImageSource {
      */
     public func properties(at index: Int) -> ImageProperties? {
         let rawValue = CGImageSourceCopyPropertiesAtIndex(cgImageSource, index, nil) as? [String: Any] ?? [:]
-        return rawValue.toModel(ImageProperties.self, decoder: ImageProperties.decoder)
+        return rawValue.toModel(ImageProperties.self, decoder: ImageProperties.dictionaryDecoder)
     }
 
     /**
@@ -0,0 +1,267 @@
+//
+//  LineIndex.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ An index of the line starts of a string that answers line queries in `O(log n)`.
+
+ The index records the UTF-16 offset of every line start in a single pass over the string. Line numbers and line ranges are then found by a binary search instead of scanning the string from its beginning.
+
+ ```swift
+ let string: NSMutableString = "First\nSecond\r\nThird"
+ var lineIndex = LineIndex(string)
+ lineIndex.lineNumber(at: 8) // 2
+ lineIndex.range(ofLine: 3) // {14, 5}
+
+ lineIndex.replaceCharacters(in: NSRange(location: 0, length: 0), with: "Zero\n", in: string)
+ lineIndex.lineCount // 4
+ ```
+
+ After editing the string, update the index with ``replaceCharacters(in:with:in:)`` or ``replaceCharacters(in:replacementLength:in:)``. Only the edited lines are scanned again.
+
+ Lines are separated like by `NSString`'s `getLineStart(_:end:contentsEnd:for:)`: by `LF`, `CR`, `CRLF`, `NEL`, and the Unicode line and paragraph separators.
+ */
+public struct LineIndex: Hashable {
+    /// The UTF-16 offsets of the line starts.
+    var lineStarts: [Int] = [0]
+    /// The UTF-16 length of the terminator of each line, `0` for the last line.
+    var terminatorLengths: [UInt8] = [0]
+
+    /// The UTF-16 length of the indexed string.
+    public private(set) var length: Int = 0
+
+    /// Creates a line index for the specified string.
+    public init(_ string: NSString) {
+        length = string.length
+        terminatorLengths.removeAll()
+        Self.enumerateLineEnds(in: string, from: 0) { terminatorStart, lineStart in
+            terminatorLengths.append(UInt8(lineStart - terminatorStart))
+            lineStarts.append(lineStart)
+            return true
+        }
+        terminatorLengths.append(0)
+    }
+
+    /// Creates a line index for the specified string.
+    public init(_ string: String) {
+        self.init(string as NSString)
+    }
+
+    /// The number of lines.
+    public var lineCount: Int {
+        lineStarts.count
+    }
+
+    /**
+     Returns the number of the line at the specified location (1-based).
+
+     - Parameter location: The UTF-16 location.
+     - Complexity: `O(log n)`, where `n` is the number of lines.
+     */
+    public func lineNumber(at location: Int) -> Int {
+        lineIndex(at: location) + 1
+    }
+
+    /**
+     Returns the line numbers of the lines that intersect the specified range (1-based).
+
+     - Parameter range: The UTF-16 range.
+     - Complexity: `O(log n)`, where `n` is the number of lines.
+     */
+    public func lineNumbers(in range: NSRange) -> ClosedRange<Int> {
+        let upperLocation = range.length > 0 ? range.upperBound - 1 : range.location
+        return lineNumber(at: range.location) ... lineNumber(at: upperLocation)
+    }
+
+    /**
+     Returns the range of the specified line, including its line terminator.
+
+     - Parameter line: The line number (1-based).
+     - Complexity: `O(1)`.
+     */
+    public func range(ofLine line: Int) -> NSRange {
+        precondition(line >= 1 && line <= lineCount, "Line number out of range.")
+        let start = lineStarts[line - 1]
+        let end = line < lineCount ? lineStarts[line] : length
+        return NSRange(location: start, length: end - start)
+    }
+
+    /**
+     Returns the range of the specified line, excluding its line terminator.
+
+     - Parameter line: The line number (1-based).
+     - Complexity: `O(1)`.
+     */
+    public func contentsRange(ofLine line: Int) -> NSRange {
+        let range = range(ofLine: line)
+        return NSRange(location: range.location, length: range.length - Int(terminatorLengths[line - 1]))
+    }
+
+    /**
+     Returns the range of the line containing the specified location, including its line terminator.
+
+     - Parameter location: The UTF-16 location.
+     - Complexity: `O(log n)`, where `n` is the number of lines.
+     */
+    public func lineRange(at location: Int) -> NSRange {
+        range(ofLine: lineNumber(at: location))
+    }
+
+    /**
+     Returns the location of the first character of the line containing the specified location.
+
+     - Parameter location: The UTF-16 location.
+     - Complexity: `O(log n)`, where `n` is the number of lines.
+     */
+    public func lineStart(at location: Int) -> Int {
+        lineStarts[lineIndex(at: location)]
+    }
+
+    /**
+     Replaces the characters in the specified range of the string and updates the index.
+
+     - Parameters:
+        - range: The range of the characters to replace.
+        - replacement: The replacement string.
+        - string: The indexed string.
+     */
+    public mutating func replaceCharacters(in range: NSRange, with replacement: String, in string: NSMutableString) {
+        let replacementLength = (replacement as NSString).length
+        string.replaceCharacters(in: range, with: replacement)
+        replaceCharacters(in: range, replacementLength: replacementLength, in: string)
+    }
+
+    /**
+     Updates the index after characters of the string have been replaced.
+
+     Only the lines touched by the edit are scanned again, the line starts after the edit are shifted.
+
+     - Parameters:
+        - range: The range of the replaced characters in the string before the edit.
+        - replacementLength: The UTF-16 length of the replacement string.
+        - string: The string after the edit.
+     */
+    public mutating func replaceCharacters(in range: NSRange, replacementLength: Int, in string: NSString) {
+        let delta = replacementLength - range.length
+        let editEnd = range.location + replacementLength
+        var firstLine = lineIndex(at: range.location)
+        if firstLine > 0, lineStarts[firstLine] == range.location {
+            // A CR at the end of the previous line can join with an inserted LF.
+            firstLine -= 1
+        }
+
+        var newStarts: [Int] = []
+        var newTerminatorLengths: [UInt8] = []
+        var lastUnchangedStart: Int?
+        Self.enumerateLineEnds(in: string, from: lineStarts[firstLine]) { terminatorStart, lineStart in
+            newTerminatorLengths.append(UInt8(lineStart - terminatorStart))
+            newStarts.append(lineStart)
+            if terminatorStart >= editEnd {
+                // The following line starts are unaffected by the edit.
+                lastUnchangedStart = lineStart - delta
+                return false
+            }
+            return true
+        }
+
+        if let lastUnchangedStart = lastUnchangedStart, let index = lineStarts.firstIndex(of: lastUnchangedStart, after: firstLine) {
+            newStarts += lineStarts[(index + 1)...].map { $0 + delta }
+            newTerminatorLengths += terminatorLengths[index...]
+        } else {
+            if let lineStart = newStarts.last, lastUnchangedStart != nil {
+                Self.enumerateLineEnds(in: string, from: lineStart) { terminatorStart, lineStart in
+                    newTerminatorLengths.append(UInt8(lineStart - terminatorStart))
+                    newStarts.append(lineStart)
+                    return true
+                }
+            }
+            newTerminatorLengths.append(0)
+        }
+
+        lineStarts.replaceSubrange((firstLine + 1)..., with: newStarts)
+        terminatorLengths.replaceSubrange(firstLine..., with: newTerminatorLengths)
+        length += delta
+    }
+}
+
+extension LineIndex {
+    /// Returns the zero-based index of the line containing the location.
+    func lineIndex(at location: Int) -> Int {
+        var low = 0
+        var high = lineStarts.count
+        while low < high {
+            let mid = (low + high) / 2
+            if lineStarts[mid] <= location {
+                low = mid + 1
+            } else {
+                high = mid
+            }
+        }
+        return Swift.max(0, low - 1)
+    }
+
+    /**
+     Enumerates the line terminators of the string starting at the specified location.
+
+     The handler is called with the location of each terminator and the location of the line start following it, and returns whether the enumeration should continue.
+     */
+    static func enumerateLineEnds(in string: NSString, from location: Int, _ handler: (_ terminatorStart: Int, _ lineStart: Int) -> Bool) {
+        let length = string.length
+        let chunkSize = 4096
+        var buffer = [unichar](repeating: 0, count: chunkSize)
+        var chunkStart = location
+        var pendingCarriageReturn: Int?
+        while chunkStart < length {
+            let chunkLength = Swift.min(chunkSize, length - chunkStart)
+            buffer.withUnsafeMutableBufferPointer {
+                string.getCharacters($0.baseAddress!, range: NSRange(location: chunkStart, length: chunkLength))
+            }
+            for offset in 0 ..< chunkLength {
+                let character = buffer[offset]
+                let position = chunkStart + offset
+                if let carriageReturn = pendingCarriageReturn {
+                    pendingCarriageReturn = nil
+                    if character == 0x000A {
+                        guard handler(carriageReturn, position + 1) else { return }
+                        continue
+                    }
+                    guard handler(carriageReturn, carriageReturn + 1) else { return }
+                }
+                switch character {
+                case 0x000D:
+                    pendingCarriageReturn = position
+                case 0x000A, 0x0085, 0x2028, 0x2029:
+                    guard handler(position, position + 1) else { return }
+                default:
+                    break
+                }
+            }
+            chunkStart += chunkLength
+        }
+        if let carriageReturn = pendingCarriageReturn {
+            _ = handler(carriageReturn, carriageReturn + 1)
+        }
+    }
+}
+
+private extension Array where Element == Int {
+    /// Returns the index of the value in the sorted array, searching after the specified index.
+    func firstIndex(of value: Int, after index: Int) -> Int? {
+        var low = index + 1
+        var high = count
+        while low < high {
+            let mid = (low + high) / 2
+            if self[mid] < value {
+                low = mid + 1
+            } else {
+                high = mid
+            }
+        }
+        return low < count && self[low] == value ? low : nil
+    }
+}
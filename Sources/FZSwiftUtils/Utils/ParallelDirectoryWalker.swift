@@ -0,0 +1,403 @@
+//
+//  ParallelDirectoryWalker.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+#if canImport(Darwin)
+import Darwin
+#elseif canImport(Glibc)
+import Glibc
+#endif
+
+/**
+ Walks a directory tree by reading several directories concurrently.
+
+ `FileManager.DirectoryEnumerator` reads one directory after another, so walking large trees, especially on network volumes, is bound by the latency of each directory read. The walker reads the directories on a pool of workers. Each worker processes the subdirectories it finds itself and steals directories from the other workers when it runs out of work.
+
+ The directories are read with `opendir` and `readdir`, and the type of each item is taken from the directory entry, so no item is stat'ed unless the file system doesn't report the type.
+
+ The walker is an unordered `AsyncSequence` of the urls:
+
+ ```swift
+ let walker = ParallelDirectoryWalker(url: directoryURL, options: [.includeSubdirectoryDescendants]) { $0.isRegularFile && $0.name.hasSuffix(".swift") }
+ for await url in walker {
+     print(url)
+ }
+ ```
+
+ Use ``sortedURLs()`` to get the urls in a deterministic order.
+ */
+public struct ParallelDirectoryWalker: AsyncSequence {
+    public typealias Element = URL
+
+    /// An item of the walked directory tree.
+    public struct Entry {
+        /// The type of an item.
+        public enum ItemType: Hashable {
+            /// Directory.
+            case directory
+            /// Regular file.
+            case regularFile
+            /// Symbolic link.
+            case symbolicLink
+            /// Other item, like a socket or device.
+            case other
+        }
+
+        /// The path of the item.
+        public let path: String
+
+        /// The type of the item.
+        public let type: ItemType
+
+        /// The level of the item in the walked directory tree, starting at `1` for the items of the directory.
+        public let level: Int
+
+        /// The name of the item.
+        public var name: String {
+            (path as NSString).lastPathComponent
+        }
+
+        /// The url of the item.
+        public var url: URL {
+            URL(fileURLWithPath: path, isDirectory: type == .directory)
+        }
+
+        /// A Boolean value indicating whether the item is a directory.
+        public var isDirectory: Bool {
+            type == .directory
+        }
+
+        /// A Boolean value indicating whether the item is a regular file.
+        public var isRegularFile: Bool {
+            type == .regularFile
+        }
+    }
+
+    /// The url of the walked directory.
+    public let url: URL
+
+    /// The options for walking the directory.
+    public let options: Set<URL.DirectoryEnumerationOption>
+
+    /// The maximum number of directories that are read concurrently.
+    public var maxConcurrentDirectoryReads: Int = ProcessInfo.processInfo.activeProcessorCount
+
+    /// The quality of service of the workers.
+    public var qualityOfService: DispatchQoS.QoSClass = .userInitiated
+
+    let predicate: ((Entry) -> Bool)?
+    let shouldDescend: ((Entry) -> Bool)?
+
+    /**
+     Creates a walker for the specified directory.
+
+     The options behave as for `URL.iterate(predicate:options:resourceKeys:)`: Without `includeSubdirectoryDescendants` or `maxDepth` only the items of the directory are returned, hidden items are skipped unless `includeHiddenFiles` is specified and the contents of packages are skipped unless `includePackageDescendants` is specified. Items are hidden if their name starts with a period.
+
+     The predicates are evaluated on the workers before the urls of the items are created. They must be safe to be called concurrently.
+
+     - Parameters:
+        - url: The url of the directory to walk.
+        - options: The options for walking the directory.
+        - shouldDescend: The predicate for the subdirectories to walk, or `nil` to walk all subdirectories.
+        - predicate: The predicate for the items to return, or `nil` to return all items.
+     */
+    public init(url: URL, options: Set<URL.DirectoryEnumerationOption> = [], shouldDescend: ((Entry) -> Bool)? = nil, predicate: ((Entry) -> Bool)? = nil) {
+        self.url = url
+        self.options = options
+        self.shouldDescend = shouldDescend
+        self.predicate = predicate
+    }
+
+    public func makeAsyncIterator() -> AsyncStream<URL>.Iterator {
+        AsyncStream<URL> { continuation in
+            let walk = Walk(walker: self) { entry, _ in
+                continuation.yield(entry.url)
+            }
+            continuation.onTermination = { _ in
+                walk.cancel()
+            }
+            DispatchQueue.global(qos: qualityOfService).async {
+                walk.run()
+                continuation.finish()
+            }
+        }.makeAsyncIterator()
+    }
+
+    /**
+     Returns the entries of the walked directory tree.
+
+     The entries are sorted in depth-first order, with the items of each directory sorted by the bytes of their names, so the result is the same on every walk of an unchanged tree.
+     */
+    public func sortedEntries() -> [Entry] {
+        let buffers = (0..<max(1, maxConcurrentDirectoryReads)).map { _ in EntryBuffer() }
+        let walk = Walk(walker: self) { entry, worker in
+            buffers[worker].entries.append(entry)
+        }
+        walk.run()
+        var entries = buffers.flatMap { $0.entries }
+        entries.sort { Self.precedesInWalkOrder($0.path, $1.path) }
+        return entries
+    }
+
+    /**
+     Returns the urls of the walked directory tree.
+
+     The urls are sorted in depth-first order, with the items of each directory sorted by the bytes of their names, so the result is the same on every walk of an unchanged tree.
+     */
+    public func sortedURLs() -> [URL] {
+        sortedEntries().map { $0.url }
+    }
+
+    /// Compares the paths by their bytes with the path separator ordered first, so each directory precedes its items and the items precede the next sibling of the directory.
+    static func precedesInWalkOrder(_ lhs: String, _ rhs: String) -> Bool {
+        var lhsIterator = lhs.utf8.makeIterator()
+        var rhsIterator = rhs.utf8.makeIterator()
+        while true {
+            switch (lhsIterator.next(), rhsIterator.next()) {
+            case let (lhsByte?, rhsByte?):
+                guard lhsByte != rhsByte else { continue }
+                if lhsByte == UInt8(ascii: "/") { return true }
+                if rhsByte == UInt8(ascii: "/") { return false }
+                return lhsByte < rhsByte
+            case (nil, _?):
+                return true
+            default:
+                return false
+            }
+        }
+    }
+}
+
+public extension URL {
+    /**
+     Returns a walker that reads the directory tree concurrently.
+
+     - Parameters:
+        - options: The options for walking the directory.
+        - predicate: The predicate for the items to return, or `nil` to return all items.
+     */
+    func walkConcurrently(options: Set<DirectoryEnumerationOption> = [], predicate: ((ParallelDirectoryWalker.Entry) -> Bool)? = nil) -> ParallelDirectoryWalker {
+        ParallelDirectoryWalker(url: self, options: options, predicate: predicate)
+    }
+}
+
+extension ParallelDirectoryWalker {
+    final class EntryBuffer {
+        var entries: [Entry] = []
+    }
+
+    struct Job {
+        let path: String
+        let level: Int
+    }
+
+    /// The directories of a worker. The worker takes the most recently added directory, other workers steal the oldest one.
+    final class JobQueue {
+        let lock = NSLock()
+        var jobs: [Job] = []
+        var head = 0
+
+        func push(_ job: Job) {
+            lock.lock()
+            jobs.append(job)
+            lock.unlock()
+        }
+
+        func popLast() -> Job? {
+            lock.lock()
+            defer { lock.unlock() }
+            guard jobs.count > head else { return nil }
+            let job = jobs.removeLast()
+            if jobs.count == head {
+                jobs.removeAll(keepingCapacity: true)
+                head = 0
+            }
+            return job
+        }
+
+        func popFirst() -> Job? {
+            lock.lock()
+            defer { lock.unlock() }
+            guard jobs.count > head else { return nil }
+            let job = jobs[head]
+            head += 1
+            if head == jobs.count {
+                jobs.removeAll(keepingCapacity: true)
+                head = 0
+            } else if head > 64, head * 2 > jobs.count {
+                jobs.removeFirst(head)
+                head = 0
+            }
+            return job
+        }
+    }
+
+    final class Walk {
+        let rootPath: String
+        let maxLevel: Int
+        let includeHiddenFiles: Bool
+        let includePackageDescendants: Bool
+        let predicate: ((Entry) -> Bool)?
+        let shouldDescend: ((Entry) -> Bool)?
+        let emit: (Entry, Int) -> Void
+        let queues: [JobQueue]
+        let condition = NSCondition()
+        /// The number of queued and processed directories, guarded by `condition`.
+        var pending = 0
+        /// The number of waiting workers, guarded by `condition`.
+        var idleWorkers = 0
+        /// Guarded by `condition`.
+        var isCancelled = false
+
+        init(walker: ParallelDirectoryWalker, emit: @escaping (Entry, Int) -> Void) {
+            var rootPath = walker.url.standardizedFileURL.path
+            if rootPath.count > 1, rootPath.hasSuffix("/") {
+                rootPath.removeLast()
+            }
+            self.rootPath = rootPath
+            let maxDepth = walker.options.compactMap { $0.depth }.first
+            maxLevel = maxDepth ?? (walker.options.contains(.includeSubdirectoryDescendants) ? .max : 1)
+            includeHiddenFiles = walker.options.contains(.includeHiddenFiles)
+            includePackageDescendants = walker.options.contains(.includePackageDescendants)
+            predicate = walker.predicate
+            shouldDescend = walker.shouldDescend
+            self.emit = emit
+            queues = (0..<max(1, walker.maxConcurrentDirectoryReads)).map { _ in JobQueue() }
+        }
+
+        func cancel() {
+            condition.lock()
+            isCancelled = true
+            condition.broadcast()
+            condition.unlock()
+        }
+
+        var cancelled: Bool {
+            condition.lock()
+            defer { condition.unlock() }
+            return isCancelled
+        }
+
+        /// Walks the directory tree and returns when all directories are read or the walk is cancelled.
+        func run() {
+            guard maxLevel > 0 else { return }
+            pending = 1
+            queues[0].push(Job(path: rootPath, level: 0))
+            DispatchQueue.concurrentPerform(iterations: queues.count) { worker in
+                work(worker)
+            }
+        }
+
+        func work(_ worker: Int) {
+            while true {
+                if let job = queues[worker].popLast() ?? steal(for: worker) {
+                    process(job, worker: worker)
+                    finish()
+                    continue
+                }
+                condition.lock()
+                var job: Job?
+                while job == nil {
+                    if pending == 0 || isCancelled {
+                        condition.unlock()
+                        return
+                    }
+                    job = steal(for: worker)
+                    if job == nil {
+                        idleWorkers += 1
+                        condition.wait()
+                        idleWorkers -= 1
+                    }
+                }
+                condition.unlock()
+                process(job!, worker: worker)
+                finish()
+            }
+        }
+
+        func steal(for worker: Int) -> Job? {
+            for offset in 1..<max(2, queues.count) {
+                if let job = queues[(worker + offset) % queues.count].popFirst() {
+                    return job
+                }
+            }
+            return nil
+        }
+
+        func schedule(_ job: Job, worker: Int) {
+            condition.lock()
+            // Counted before it's pushed, as another worker can steal and finish the job right away.
+            pending += 1
+            queues[worker].push(job)
+            if idleWorkers > 0 {
+                condition.signal()
+            }
+            condition.unlock()
+        }
+
+        func finish() {
+            condition.lock()
+            pending -= 1
+            if pending == 0 {
+                condition.broadcast()
+            }
+            condition.unlock()
+        }
+
+        func process(_ job: Job, worker: Int) {
+            guard !cancelled, let directory = opendir(job.path) else { return }
+            defer { closedir(directory) }
+            let level = job.level + 1
+            let parentPath = job.path == "/" ? "" : job.path
+            while let item = readdir(directory) {
+                let isHidden = item.pointee.d_name.0 == CChar(UInt8(ascii: "."))
+                guard !isHidden || includeHiddenFiles else { continue }
+                let name = withUnsafePointer(to: &item.pointee.d_name) {
+                    $0.withMemoryRebound(to: CChar.self, capacity: MemoryLayout.size(ofValue: item.pointee.d_name)) { String(cString: $0) }
+                }
+                guard name != ".", name != ".." else { continue }
+                let path = parentPath + "/" + name
+                let entry = Entry(path: path, type: Self.itemType(item.pointee.d_type, path: path), level: level)
+                if predicate?(entry) ?? true {
+                    emit(entry, worker)
+                }
+                if entry.type == .directory, level < maxLevel, shouldDescend?(entry) ?? true, includePackageDescendants || !isPackage(entry) {
+                    schedule(Job(path: path, level: level), worker: worker)
+                }
+            }
+        }
+
+        static func itemType(_ type: UInt8, path: String) -> Entry.ItemType {
+            switch Int32(type) {
+            case Int32(DT_DIR): return .directory
+            case Int32(DT_REG): return .regularFile
+            case Int32(DT_LNK): return .symbolicLink
+            case Int32(DT_UNKNOWN):
+                // Some file systems don't report the type in the directory entry.
+                var info = stat()
+                guard lstat(path, &info) == 0 else { return .other }
+                switch info.st_mode & S_IFMT {
+                case S_IFDIR: return .directory
+                case S_IFREG: return .regularFile
+                case S_IFLNK: return .symbolicLink
+                default: return .other
+                }
+            default: return .other
+            }
+        }
+
+        /// Packages are directories with an extension that the system treats as a single file.
+        func isPackage(_ entry: Entry) -> Bool {
+            #if canImport(Darwin)
+            guard entry.name.contains(".") else { return false }
+            return (try? entry.url.resourceValues(forKeys: [.isPackageKey]))?.isPackage == true
+            #else
+            return false
+            #endif
+        }
+    }
+}
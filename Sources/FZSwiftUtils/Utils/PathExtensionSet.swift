@@ -0,0 +1,81 @@
+//
+//  PathExtensionSet.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ A set of path extensions that matches case insensitive.
+
+ Checking whether the extension of an url is part of an array lowercases the extension and compares it to every element. The set reads the extension from the bytes of the path and looks it up by its hash. Extensions of up to eight ASCII characters are packed into an integer, so no string is created for them.
+ */
+struct PathExtensionSet {
+    /// The lowercased extensions of up to eight ASCII characters, packed into integers.
+    var packedExtensions: Set<UInt64> = []
+    /// The lowercased other extensions.
+    var extensions: Set<String> = []
+
+    init<S: Sequence>(_ extensions: S) where S.Element == String {
+        for pathExtension in extensions {
+            var pathExtension = pathExtension.precomposedStringWithCanonicalMapping.lowercased()
+            if pathExtension.hasPrefix(".") {
+                pathExtension.removeFirst()
+            }
+            if let packed = Self.pack(pathExtension.utf8) {
+                packedExtensions.insert(packed)
+            } else {
+                self.extensions.insert(pathExtension)
+            }
+        }
+    }
+
+    var isEmpty: Bool {
+        packedExtensions.isEmpty && extensions.isEmpty
+    }
+
+    /// Returns a Boolean value indicating whether the extension of the file url is part of the set.
+    func contains(_ url: URL) -> Bool {
+        url.withPathBytes { contains(pathBytes: $0) }
+    }
+
+    /// Returns a Boolean value indicating whether the extension of the path is part of the set.
+    func contains(pathBytes path: UnsafeBufferPointer<UInt8>) -> Bool {
+        path.withPrecomposedBytes { containsPrecomposed($0) }
+    }
+
+    func containsPrecomposed(_ path: UnsafeBufferPointer<UInt8>) -> Bool {
+        let path = path.trimmingTrailingSlashes()
+        var start = path.count
+        while start > 0 {
+            let byte = path[start - 1]
+            if byte == UInt8(ascii: "/") { return false }
+            if byte == UInt8(ascii: ".") { break }
+            start -= 1
+        }
+        // Items without a dot and names starting with a dot don't have an extension.
+        guard start > 1, path[start - 2] != UInt8(ascii: "/") else { return false }
+        let pathExtension = UnsafeBufferPointer(rebasing: path[start...])
+        guard !pathExtension.isEmpty else { return false }
+        if let packed = Self.pack(pathExtension) {
+            return packedExtensions.contains(packed)
+        }
+        return !extensions.isEmpty && extensions.contains(String(decoding: pathExtension, as: UTF8.self).lowercased())
+    }
+
+    /// Packs the lowercased ASCII bytes into an integer, or returns `nil` if there are more than eight bytes or non ASCII bytes.
+    static func pack<C: Collection>(_ bytes: C) -> UInt64? where C.Element == UInt8 {
+        guard bytes.count <= 8 else { return nil }
+        var packed: UInt64 = 0
+        var shift: UInt64 = 0
+        for byte in bytes {
+            guard byte < 0x80 else { return nil }
+            let lowercased = (0x41...0x5A).contains(byte) ? byte + 0x20 : byte
+            packed |= UInt64(lowercased) << shift
+            shift += 8
+        }
+        return packed
+    }
+}
@@ -0,0 +1,43 @@
+//
+//  SeededRandomNumberGenerator.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ A random number generator that generates the same sequence of numbers for the same seed.
+
+ Use it for reproducible random values, e.g. in fixtures and benchmarks. The generator uses the SplitMix64 algorithm and isn't suitable for cryptographic purposes.
+
+ ```swift
+ var generator = SeededRandomNumberGenerator(seed: 42)
+ let identifiers = String.random(count: 1000, length: 12, generator: &generator)
+ let value = Int.random(in: 0 ..< 100, using: &generator)
+ ```
+ */
+public struct SeededRandomNumberGenerator: RandomNumberGenerator {
+    /// The seed of the generator.
+    public let seed: UInt64
+    var state: UInt64
+
+    /**
+     Creates a random number generator with the specified seed.
+
+     - Parameter seed: The seed of the generator.
+     */
+    public init(seed: UInt64) {
+        self.seed = seed
+        state = seed
+    }
+
+    public mutating func next() -> UInt64 {
+        state &+= 0x9E37_79B9_7F4A_7C15
+        var value = state
+        value = (value ^ (value &>> 30)) &* 0xBF58_476D_1CE4_E5B9
+        value = (value ^ (value &>> 27)) &* 0x94D0_49BB_1331_11EB
+        return value ^ (value &>> 31)
+    }
+}
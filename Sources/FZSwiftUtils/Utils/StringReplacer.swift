@@ -0,0 +1,233 @@
+//
+//  StringReplacer.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ Replaces occurrences of multiple target strings in a single pass.
+
+ The replacer compiles its reversed targets once into an Aho–Corasick automaton over UTF-8 bytes and can be reused for any number of strings. Each string is scanned once from right to left, which finds the longest target that starts at each position independently of the number of targets.
+
+ When targets overlap, the match that starts first is replaced, and of the matches that start at the same position the longest. Replaced text is never matched again:
+
+ ```swift
+ let replacer = StringReplacer(["cat": "dog", "category": "group", "dog": "cat"])
+ replacer.replacingOccurrences(in: "A cat in a category with a dog") // "A dog in a group with a cat"
+ ```
+
+ Targets are matched by their exact UTF-8 representation. Strings that are canonically equivalent but differently normalized don't match, and targets can match a part of a grapheme cluster.
+ */
+public struct StringReplacer {
+    /// The target strings and their replacements.
+    public let replacements: [(target: String, replacement: String)]
+
+    /// The transitions of the automaton of the reversed targets, `256` per state.
+    let transitions: [Int32]
+    /// The length of the longest reversed target that is a suffix of the state's prefix, or `0`.
+    let matchLengths: [Int32]
+    /// The index of the replacement for the longest reversed target that is a suffix of the state's prefix, or `-1`.
+    let matchReplacements: [Int32]
+    let replacementBytes: [[UInt8]]
+
+    /**
+     Creates a replacer that replaces the keys of the specified dictionary with their values.
+
+     - Parameter replacements: A dictionary mapping target strings to their replacement strings.
+     */
+    public init<Target: StringProtocol, Replacement: StringProtocol>(_ replacements: [Target: Replacement]) {
+        self.init(replacements.map { (target: String($0.key), replacement: String($0.value)) })
+    }
+
+    /**
+     Creates a replacer that replaces all specified target strings with the replacement string.
+
+     - Parameters:
+        - targets: The target strings.
+        - replacement: The replacement string.
+     */
+    public init<Target: StringProtocol, Replacement: StringProtocol>(replacing targets: [Target], with replacement: Replacement) {
+        let replacement = String(replacement)
+        self.init(targets.map { (target: String($0), replacement: replacement) })
+    }
+
+    /**
+     Creates a replacer with the specified target strings and their replacements.
+
+     If a target appears more than once, the last replacement is used. Empty targets are ignored.
+
+     - Parameter replacements: The target strings and their replacement strings.
+     */
+    public init(_ replacements: [(target: String, replacement: String)]) {
+        self.replacements = replacements
+        var transitions = [Int32](repeating: -1, count: 256)
+        var depths: [Int32] = [0]
+        var matchLengths: [Int32] = [0]
+        var matchReplacements: [Int32] = [-1]
+        var replacementBytes: [[UInt8]] = []
+        replacementBytes.reserveCapacity(replacements.count)
+
+        for (target, replacement) in replacements where !target.isEmpty {
+            var state = 0
+            for byte in target.utf8.reversed() {
+                let index = state * 256 + Int(byte)
+                if transitions[index] < 0 {
+                    transitions[index] = Int32(depths.count)
+                    transitions.append(contentsOf: repeatElement(-1, count: 256))
+                    depths.append(depths[state] + 1)
+                    matchLengths.append(0)
+                    matchReplacements.append(-1)
+                }
+                state = Int(transitions[index])
+            }
+            matchLengths[state] = depths[state]
+            matchReplacements[state] = Int32(replacementBytes.count)
+            replacementBytes.append(Array(replacement.utf8))
+        }
+
+        // Computes the failure links in breadth-first order and resolves them into direct transitions.
+        var failures = [Int32](repeating: 0, count: depths.count)
+        var queue: [Int] = []
+        queue.reserveCapacity(depths.count)
+        for byte in 0 ..< 256 {
+            let next = transitions[byte]
+            if next < 0 {
+                transitions[byte] = 0
+            } else {
+                queue.append(Int(next))
+            }
+        }
+        var head = 0
+        while head < queue.count {
+            let state = queue[head]
+            head += 1
+            let failure = Int(failures[state])
+            if matchLengths[state] == 0 {
+                matchLengths[state] = matchLengths[failure]
+                matchReplacements[state] = matchReplacements[failure]
+            }
+            for byte in 0 ..< 256 {
+                let index = state * 256 + byte
+                let next = transitions[index]
+                let failureNext = transitions[failure * 256 + byte]
+                if next < 0 {
+                    transitions[index] = failureNext
+                } else {
+                    failures[Int(next)] = failureNext
+                    queue.append(Int(next))
+                }
+            }
+        }
+
+        self.transitions = transitions
+        self.matchLengths = matchLengths
+        self.matchReplacements = matchReplacements
+        self.replacementBytes = replacementBytes
+    }
+
+    /**
+     Returns a new string in which all occurrences of the targets in the specified string are replaced.
+
+     - Parameter string: The string.
+     - Returns: The string with the replaced occurrences.
+     - Complexity: `O(n)`, where `n` is the length of the string in bytes.
+     */
+    public func replacingOccurrences<S: StringProtocol>(in string: S) -> String {
+        guard !replacementBytes.isEmpty else { return String(string) }
+        if let result = string.utf8.withContiguousStorageIfAvailable({ replacingOccurrences(in: $0) }) {
+            return result ?? String(string)
+        }
+        return Array(string.utf8).withUnsafeBufferPointer { replacingOccurrences(in: $0) } ?? String(string)
+    }
+
+    /**
+     Returns the ranges of the occurrences of the targets in the specified string.
+
+     - Parameter string: The string.
+     - Returns: The ranges of the occurrences that would be replaced.
+     */
+    public func ranges(in string: String) -> [Range<String.Index>] {
+        var string = string
+        let matches = string.withUTF8 { allMatches(in: $0) }
+        let utf8 = string.utf8
+        var ranges: [Range<String.Index>] = []
+        var index = utf8.startIndex
+        var offset = 0
+        for match in matches {
+            index = utf8.index(index, offsetBy: match.start - offset)
+            let end = utf8.index(index, offsetBy: match.end - match.start)
+            ranges.append(index ..< end)
+            index = end
+            offset = match.end
+        }
+        return ranges
+    }
+
+    /**
+     Returns a Boolean value indicating whether the specified string contains any of the targets.
+
+     - Parameter string: The string.
+     */
+    public func containsMatch<S: StringProtocol>(in string: S) -> Bool {
+        guard !replacementBytes.isEmpty else { return false }
+        var state = 0
+        for byte in string.utf8.reversed() {
+            state = Int(transitions[state &* 256 &+ Int(byte)])
+            if matchLengths[state] > 0 {
+                return true
+            }
+        }
+        return false
+    }
+}
+
+extension StringReplacer: @unchecked Sendable {}
+
+extension StringReplacer {
+    /// Returns `nil` if the bytes don't contain any target.
+    func replacingOccurrences(in bytes: UnsafeBufferPointer<UInt8>) -> String? {
+        let matches = allMatches(in: bytes)
+        guard !matches.isEmpty else { return nil }
+        var position = 0
+        var result: [UInt8] = []
+        result.reserveCapacity(bytes.count)
+        for match in matches {
+            result.append(contentsOf: UnsafeBufferPointer(rebasing: bytes[position ..< match.start]))
+            result.append(contentsOf: replacementBytes[match.replacement])
+            position = match.end
+        }
+        result.append(contentsOf: UnsafeBufferPointer(rebasing: bytes[position...]))
+        return String(decoding: result, as: UTF8.self)
+    }
+
+    /// Returns the leftmost-longest matches that don't overlap.
+    func allMatches(in bytes: UnsafeBufferPointer<UInt8>) -> [(start: Int, end: Int, replacement: Int)] {
+        // The state after reading the bytes from the end back to each position. Its longest reversed target is the longest target that starts at the position.
+        var states = [Int32](repeating: 0, count: bytes.count)
+        transitions.withUnsafeBufferPointer { transitions in
+            var state = 0
+            var index = bytes.count
+            while index > 0 {
+                index -= 1
+                state = Int(transitions[state &* 256 &+ Int(bytes[index])])
+                states[index] = Int32(state)
+            }
+        }
+        var matches: [(start: Int, end: Int, replacement: Int)] = []
+        var index = 0
+        while index < bytes.count {
+            let state = Int(states[index])
+            let length = Int(matchLengths[state])
+            if length > 0 {
+                matches.append((index, index + length, Int(matchReplacements[state])))
+                index += length
+            } else {
+                index += 1
+            }
+        }
+        return matches
+    }
+}
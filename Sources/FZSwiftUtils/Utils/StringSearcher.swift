@@ -0,0 +1,328 @@
+//
+//  StringSearcher.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+import Foundation
+
+/**
+ Finds all occurrences of a literal string.
+
+ The searcher scans the UTF-8 bytes of a string 16 bytes at a time and compares each position with the first and last byte of the search string. Only positions that pass this filter are compared completely. If the complete comparisons take more time than scanning the string, for example when searching `aaab` in `aaaa…`, the searcher continues with a Knuth–Morris–Pratt search, so searching stays linear and doesn't bridge to `NSString`.
+
+ ```swift
+ let searcher = StringSearcher("aa")
+ searcher.ranges(in: "aaaa").count // 2
+ searcher.ranges(in: "aaaa", overlapping: true).count // 3
+ ```
+
+ The matches are found as UTF-8 offsets and only converted to `Range<String.Index>` or `NSRange` when they are accessed via ``Matches``.
+
+ Strings are compared by their exact UTF-8 representation like a search with `NSString.CompareOptions.literal`. If `caseInsensitive` is `true`, ASCII letters are compared case-insensitively; all other characters have to match exactly. Use `range(of:options:)` with `caseInsensitive` for a Unicode-aware case-insensitive search.
+ */
+public struct StringSearcher {
+    /// The string to search for.
+    public let searchString: String
+
+    /// A Boolean value indicating whether ASCII letters are compared case-insensitively.
+    public let caseInsensitive: Bool
+
+    /// The bytes of the search string, with lowercased ASCII letters if the search is case-insensitive.
+    let pattern: [UInt8]
+
+    /**
+     Creates a searcher for the specified string.
+
+     - Parameters:
+        - searchString: The string to search for.
+        - caseInsensitive: A Boolean value indicating whether ASCII letters are compared case-insensitively.
+     */
+    public init(_ searchString: String, caseInsensitive: Bool = false) {
+        self.searchString = searchString
+        self.caseInsensitive = caseInsensitive
+        pattern = caseInsensitive ? searchString.utf8.map(Self.lowercased) : Array(searchString.utf8)
+    }
+
+    /**
+     Returns the occurrences of the search string in the specified string.
+
+     - Parameters:
+        - string: The string to search.
+        - overlapping: A Boolean value indicating whether occurrences can overlap. If `false`, the search continues after the end of each occurrence.
+     - Complexity: `O(n + m)`, where `n` is the length of the string and `m` the length of the search string in bytes.
+     */
+    public func matches<S: StringProtocol>(in string: S, overlapping: Bool = false) -> Matches {
+        let string = Substring(string)
+        var offsets: [Int] = []
+        Self.withUTF8(of: string) { bytes in
+            search(in: bytes, overlapping: overlapping) {
+                offsets.append($0)
+                return true
+            }
+        }
+        return Matches(string: string, offsets: offsets, length: pattern.count)
+    }
+
+    /**
+     Returns the ranges of the occurrences of the search string in the specified string.
+
+     - Parameters:
+        - string: The string to search.
+        - overlapping: A Boolean value indicating whether occurrences can overlap.
+     */
+    public func ranges<S: StringProtocol>(in string: S, overlapping: Bool = false) -> [Range<String.Index>] {
+        Array(matches(in: string, overlapping: overlapping))
+    }
+
+    /**
+     Returns the range of the first occurrence of the search string in the specified string.
+
+     - Parameter string: The string to search.
+     */
+    public func firstRange<S: StringProtocol>(in string: S) -> Range<String.Index>? {
+        let string = Substring(string)
+        var offset: Int?
+        Self.withUTF8(of: string) { bytes in
+            search(in: bytes, overlapping: false) {
+                offset = $0
+                return false
+            }
+        }
+        guard let offset = offset else { return nil }
+        let start = string.utf8.index(string.startIndex, offsetBy: offset)
+        return start ..< string.utf8.index(start, offsetBy: pattern.count)
+    }
+
+    /**
+     Returns a Boolean value indicating whether the specified string contains the search string.
+
+     - Parameter string: The string to search.
+     */
+    public func isContained<S: StringProtocol>(in string: S) -> Bool {
+        var found = false
+        Self.withUTF8(of: Substring(string)) { bytes in
+            search(in: bytes, overlapping: false) { _ in
+                found = true
+                return false
+            }
+        }
+        return found
+    }
+
+    /**
+     Returns the number of occurrences of the search string in the specified string.
+
+     - Parameters:
+        - string: The string to search.
+        - overlapping: A Boolean value indicating whether occurrences can overlap.
+     */
+    public func count<S: StringProtocol>(in string: S, overlapping: Bool = false) -> Int {
+        var count = 0
+        Self.withUTF8(of: Substring(string)) { bytes in
+            search(in: bytes, overlapping: overlapping) { _ in
+                count += 1
+                return true
+            }
+        }
+        return count
+    }
+
+    /// The occurrences of a search string in a string.
+    public struct Matches: Sequence {
+        /// The searched string.
+        public let string: Substring
+        /// The UTF-8 offsets of the occurrences.
+        let offsets: [Int]
+        /// The UTF-8 length of the search string.
+        let length: Int
+
+        /// The number of occurrences.
+        public var count: Int {
+            offsets.count
+        }
+
+        /// A Boolean value indicating whether there are no occurrences.
+        public var isEmpty: Bool {
+            offsets.isEmpty
+        }
+
+        /// The ranges of the occurrences in the searched string as `NSRange`.
+        public var nsRanges: [NSRange] {
+            guard !offsets.isEmpty else { return [] }
+            var ranges: [NSRange] = []
+            ranges.reserveCapacity(offsets.count)
+            StringSearcher.withUTF8(of: string) { bytes in
+                var offset = 0
+                var location = 0
+                for start in offsets {
+                    location += Self.utf16Count(of: bytes, from: offset, to: start)
+                    offset = start
+                    ranges.append(NSRange(location: location, length: Self.utf16Count(of: bytes, from: start, to: start + length)))
+                }
+            }
+            return ranges
+        }
+
+        public func makeIterator() -> Iterator {
+            Iterator(matches: self)
+        }
+
+        /// An iterator over the ranges of the occurrences.
+        public struct Iterator: IteratorProtocol {
+            let matches: Matches
+            var index = 0
+            var offset = 0
+            var stringIndex: String.Index
+
+            init(matches: Matches) {
+                self.matches = matches
+                stringIndex = matches.string.startIndex
+            }
+
+            public mutating func next() -> Range<String.Index>? {
+                guard index < matches.offsets.count else { return nil }
+                let utf8 = matches.string.utf8
+                let start = matches.offsets[index]
+                let lowerBound = utf8.index(stringIndex, offsetBy: start - offset)
+                let upperBound = utf8.index(lowerBound, offsetBy: matches.length)
+                index += 1
+                offset = start
+                stringIndex = lowerBound
+                return lowerBound ..< upperBound
+            }
+        }
+
+        static func utf16Count(of bytes: UnsafeBufferPointer<UInt8>, from start: Int, to end: Int) -> Int {
+            var count = 0
+            for index in start ..< end {
+                let byte = bytes[index]
+                if byte & 0xC0 != 0x80 {
+                    count += byte >= 0xF0 ? 2 : 1
+                }
+            }
+            return count
+        }
+    }
+}
+
+extension StringSearcher: Sendable {}
+extension StringSearcher.Matches: Sendable {}
+
+extension StringSearcher {
+    /**
+     Calls the handler with the offset of each occurrence in the bytes.
+
+     Candidate positions are found by comparing 16 positions at once with the first and last byte of the pattern and then compared completely. Once the complete comparisons exceed the length of the bytes, the rest is searched with ``searchLinearly(in:from:overlapping:_:)``. The handler returns whether the search should continue.
+     */
+    func search(in bytes: UnsafeBufferPointer<UInt8>, overlapping: Bool, _ handler: (Int) -> Bool) {
+        let patternLength = pattern.count
+        guard patternLength > 0, patternLength <= bytes.count, let base = bytes.baseAddress else { return }
+        let lastStart = bytes.count - patternLength
+        pattern.withUnsafeBufferPointer { pattern in
+            // Letters are matched case-insensitively by setting the lowercase bit before comparing.
+            let firstFold: UInt8 = caseInsensitive && Self.isASCIILetter(pattern[0]) ? 0x20 : 0
+            let lastFold: UInt8 = caseInsensitive && Self.isASCIILetter(pattern[patternLength - 1]) ? 0x20 : 0
+            let firstByte = pattern[0]
+            let lastByte = pattern[patternLength - 1]
+
+            func isMatch(at position: Int) -> Bool {
+                if !caseInsensitive {
+                    return memcmp(base + position, pattern.baseAddress!, patternLength) == 0
+                }
+                for index in 0 ..< patternLength where Self.lowercased(base[position + index]) != pattern[index] {
+                    return false
+                }
+                return true
+            }
+
+            var minimumStart = 0
+            var comparedBytes = 0
+            /// Verifies a candidate and returns `false` if the search should stop.
+            func check(_ position: Int) -> Bool {
+                guard position >= minimumStart else { return true }
+                guard comparedBytes <= bytes.count else {
+                    searchLinearly(in: bytes, from: position, overlapping: overlapping, handler)
+                    return false
+                }
+                comparedBytes += patternLength
+                guard isMatch(at: position) else { return true }
+                minimumStart = overlapping ? position + 1 : position + patternLength
+                return handler(position)
+            }
+
+            var position = 0
+            let firstVector = SIMD16<UInt8>(repeating: firstByte)
+            let lastVector = SIMD16<UInt8>(repeating: lastByte)
+            let firstFoldVector = SIMD16<UInt8>(repeating: firstFold)
+            let lastFoldVector = SIMD16<UInt8>(repeating: lastFold)
+            while position + 15 <= lastStart {
+                let first = UnsafeRawPointer(base + position).loadUnaligned(as: SIMD16<UInt8>.self) | firstFoldVector
+                let last = UnsafeRawPointer(base + position + patternLength - 1).loadUnaligned(as: SIMD16<UInt8>.self) | lastFoldVector
+                let candidates = (first .== firstVector) .& (last .== lastVector)
+                if any(candidates) {
+                    for index in 0 ..< 16 where candidates[index] {
+                        guard check(position + index) else { return }
+                    }
+                }
+                position = Swift.max(position + 16, minimumStart)
+            }
+            while position <= lastStart {
+                if base[position] | firstFold == firstByte, base[position + patternLength - 1] | lastFold == lastByte {
+                    guard check(position) else { return }
+                }
+                position += 1
+            }
+        }
+    }
+
+    /// Calls the handler with the offset of each occurrence that starts at or after the specified offset, using a Knuth–Morris–Pratt search that reads each byte once.
+    func searchLinearly(in bytes: UnsafeBufferPointer<UInt8>, from start: Int, overlapping: Bool, _ handler: (Int) -> Bool) {
+        let patternLength = pattern.count
+        // The length of the longest proper prefix of the pattern that is also a suffix of `pattern[...index]`.
+        var prefixLengths = [Int](repeating: 0, count: patternLength)
+        var length = 0
+        for index in 1 ..< Swift.max(patternLength, 1) {
+            while length > 0, pattern[index] != pattern[length] {
+                length = prefixLengths[length - 1]
+            }
+            if pattern[index] == pattern[length] {
+                length += 1
+            }
+            prefixLengths[index] = length
+        }
+        length = 0
+        for index in start ..< bytes.count {
+            let byte = caseInsensitive ? Self.lowercased(bytes[index]) : bytes[index]
+            while length > 0, byte != pattern[length] {
+                length = prefixLengths[length - 1]
+            }
+            if byte == pattern[length] {
+                length += 1
+            }
+            if length == patternLength {
+                guard handler(index - patternLength + 1) else { return }
+                length = overlapping ? prefixLengths[length - 1] : 0
+            }
+        }
+    }
+
+    @inline(__always)
+    static func isASCIILetter(_ byte: UInt8) -> Bool {
+        (byte | 0x20) &- 0x61 < 26
+    }
+
+    @inline(__always)
+    static func lowercased(_ byte: UInt8) -> UInt8 {
+        byte &- 0x41 < 26 ? byte | 0x20 : byte
+    }
+
+    /// Calls the body with the contiguous UTF-8 bytes of the string.
+    static func withUTF8<R>(of string: Substring, _ body: (UnsafeBufferPointer<UInt8>) -> R) -> R {
+        if let result = string.utf8.withContiguousStorageIfAvailable(body) {
+            return result
+        }
+        return Array(string.utf8).withUnsafeBufferPointer(body)
+    }
+}
@@ -0,0 +1,71 @@
+//
+//  DictionaryCoderTests.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+@testable import FZSwiftUtils
+import XCTest
+
+final class DictionaryCoderTests: XCTestCase {
+    struct Item: Codable, Equatable {
+        var itemName: String
+        var itemValues: [String: Int]
+        var itemCount: Int64
+        var isEnabled: Bool
+        var ratio: Double
+    }
+
+    func testMatchesJSONRoundTrip() throws {
+        let item = Item(itemName: "Name", itemValues: ["firstValue": 1, "secondValue": 2], itemCount: 9_007_199_254_740_993, isEnabled: true, ratio: 0.5)
+        let jsonEncoder = JSONEncoder()
+        jsonEncoder.keyEncodingStrategy = .convertToSnakeCase
+        let jsonDictionary = try JSONSerialization.jsonObject(with: jsonEncoder.encode(item)) as! NSDictionary
+        let dictionary = try DictionaryEncoder(jsonEncoder).encode(item)
+        XCTAssertEqual(dictionary as NSDictionary, jsonDictionary)
+        XCTAssertEqual((dictionary["item_values"] as? [String: Int])?.keys.sorted(), ["firstValue", "secondValue"])
+
+        let jsonDecoder = JSONDecoder()
+        jsonDecoder.keyDecodingStrategy = .convertFromSnakeCase
+        XCTAssertEqual(try DictionaryDecoder(jsonDecoder).decode(Item.self, from: dictionary), item)
+    }
+
+    func testNumbersAreStoredAsNSNumber() throws {
+        struct Size: Codable {
+            var width: Int
+            var height: UInt8
+            var scale: Float
+        }
+        let dictionary = Size(width: 3, height: 4, scale: 0.1).toDictionary()
+        XCTAssertEqual(dictionary["width"] as? Double, 3)
+        XCTAssertEqual(dictionary["height"] as? Double, 4)
+        XCTAssertEqual(dictionary["scale"] as? Double, 0.1)
+        XCTAssertEqual(dictionary["width"] as? NSNumber, NSNumber(value: 3))
+    }
+
+    func testNonConformingFloats() throws {
+        XCTAssertThrowsError(try DictionaryEncoder().encode(["ratio": Double.infinity]))
+        let encoder = DictionaryEncoder(nonConformingFloatEncodingStrategy: .convertToString(positiveInfinity: "inf", negativeInfinity: "-inf", nan: "nan"))
+        let dictionary = try encoder.encode(["ratio": -Double.infinity])
+        XCTAssertEqual(dictionary["ratio"] as? String, "-inf")
+
+        XCTAssertThrowsError(try DictionaryDecoder().decode([String: Double].self, from: dictionary))
+        let decoder = DictionaryDecoder(nonConformingFloatDecodingStrategy: .convertFromString(positiveInfinity: "inf", negativeInfinity: "-inf", nan: "nan"))
+        XCTAssertEqual(try decoder.decode([String: Double].self, from: dictionary), ["ratio": -Double.infinity])
+    }
+
+    func testNumbersAndBooleans() throws {
+        let decoder = DictionaryDecoder()
+        XCTAssertEqual(try decoder.decode([String: Int64].self, from: ["value": NSNumber(value: Int64(9_007_199_254_740_993))]), ["value": 9_007_199_254_740_993])
+        XCTAssertEqual(try decoder.decode([String: UInt64].self, from: ["value": NSNumber(value: UInt64.max)]), ["value": UInt64.max])
+        XCTAssertEqual(try decoder.decode([String: Int].self, from: ["value": NSNumber(value: 3.0)]), ["value": 3])
+        XCTAssertThrowsError(try decoder.decode([String: Int8].self, from: ["value": NSNumber(value: 300)]))
+        XCTAssertThrowsError(try decoder.decode([String: Int].self, from: ["value": NSNumber(value: 3.5)]))
+
+        XCTAssertEqual(try decoder.decode([String: Bool].self, from: ["value": NSNumber(value: true)]), ["value": true])
+        XCTAssertEqual(try decoder.decode([String: Bool].self, from: ["value": false]), ["value": false])
+        XCTAssertThrowsError(try decoder.decode([String: Bool].self, from: ["value": NSNumber(value: 1)]))
+        XCTAssertThrowsError(try decoder.decode([String: Int].self, from: ["value": true]))
+    }
+}
@@ -0,0 +1,52 @@
+//
+//  DirectoryEnumeratorTests.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+@testable import FZSwiftUtils
+import XCTest
+
+final class DirectoryEnumeratorTests: XCTestCase {
+    var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent("DirectoryEnumeratorTests-\(UUID().uuidString)", isDirectory: true)
+        try FileManager.default.createDirectory(at: directory.appendingPathComponent("folder/subfolder"), withIntermediateDirectories: true)
+        for (path, size) in [("a.txt", 1), ("b.jpg", 2), ("folder/c.txt", 3), ("folder/subfolder/d.txt", 4)] {
+            try Data(repeating: 0, count: size).write(to: directory.appendingPathComponent(path))
+        }
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    func names(_ sequence: URL.URLSequence) -> [String] {
+        sequence.map(\.lastPathComponent).sorted()
+    }
+
+    func testFiltersPrefetchTheirKeys() {
+        XCTAssertEqual(names(directory.iterateFiles(options: [.includeSubdirectoryDescendants])), ["a.txt", "b.jpg", "c.txt", "d.txt"])
+        XCTAssertEqual(names(directory.iterateDirectories(options: [.includeSubdirectoryDescendants])), ["folder", "subfolder"])
+        XCTAssertEqual(names(directory.iterateFiles(extensions: ["txt"], options: [.includeSubdirectoryDescendants, .maxDepth(1)])), ["a.txt", "c.txt"])
+        XCTAssertEqual(names(directory.iterateFiles(by: .extensions("jpg"))), ["b.jpg"])
+
+        let iterator = directory.iterateFiles(options: []).makeIterator()
+        XCTAssertEqual(iterator.resourceKeys, [.isRegularFileKey])
+        XCTAssertNotNil(iterator.next())
+    }
+
+    func testResourceValuesArePrefetched() throws {
+        let sequence = directory.iterate(options: [.includeSubdirectoryDescendants], resourceKeys: [.fileSizeKey]).prefetching([.isDirectoryKey])
+        var sizes: [String: Int] = [:]
+        for (url, resourceValues) in sequence.withResourceValues {
+            let isDirectory = try XCTUnwrap(resourceValues.isDirectory)
+            if !isDirectory {
+                sizes[url.lastPathComponent] = resourceValues.fileSize
+            }
+        }
+        XCTAssertEqual(sizes, ["a.txt": 1, "b.jpg": 2, "c.txt": 3, "d.txt": 4])
+    }
+}
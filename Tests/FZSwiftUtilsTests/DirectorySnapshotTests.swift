@@ -0,0 +1,81 @@
+//
+//  DirectorySnapshotTests.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+@testable import FZSwiftUtils
+import XCTest
+
+final class DirectorySnapshotTests: XCTestCase {
+    var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent("DirectorySnapshotTests-\(UUID().uuidString)", isDirectory: true)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    func testDiffReportsMovesAndRemovedHardLinks() throws {
+        let fileURL = directory.appendingPathComponent("a")
+        let linkURL = directory.appendingPathComponent("b")
+        let movedURL = directory.appendingPathComponent("c")
+        try Data("a".utf8).write(to: fileURL)
+        try FileManager.default.linkItem(at: fileURL, to: linkURL)
+        try Data("c".utf8).write(to: movedURL)
+        let snapshot = try DirectorySnapshot(url: directory)
+
+        try FileManager.default.removeItem(at: fileURL)
+        try FileManager.default.removeItem(at: linkURL)
+        let renamedURL = directory.appendingPathComponent("d")
+        try FileManager.default.moveItem(at: movedURL, to: renamedURL)
+        let changes = try snapshot.rescan().diff(from: snapshot)
+
+        XCTAssertEqual(changes.removed.map(\.lastPathComponent).sorted(), ["a", "b"])
+        XCTAssertEqual(changes.moved.map { [$0.source.lastPathComponent, $0.destination.lastPathComponent] }, [["c", "d"]])
+        XCTAssertTrue(changes.added.isEmpty)
+    }
+
+    func testApplyingChangesSplicesRescannedSubtrees() throws {
+        let folderURL = directory.appendingPathComponent("b", isDirectory: true)
+        try FileManager.default.createDirectory(at: folderURL.appendingPathComponent("c"), withIntermediateDirectories: true)
+        for name in ["a", "b-c", "b/c/d", "b/e", "z"] {
+            try Data(name.utf8).write(to: directory.appendingPathComponent(name))
+        }
+        let snapshot = try DirectorySnapshot(url: directory)
+
+        try FileManager.default.removeItem(at: folderURL.appendingPathComponent("c"))
+        try Data("f".utf8).write(to: folderURL.appendingPathComponent("f"))
+        try Data("y".utf8).write(to: directory.appendingPathComponent("y"))
+        let changes = [DirectoryWatcher.Change(url: folderURL, kind: .modified), DirectoryWatcher.Change(url: folderURL.appendingPathComponent("c"), kind: .removed), DirectoryWatcher.Change(url: directory.appendingPathComponent("y"), kind: .created)]
+        let updatedSnapshot = try snapshot.applying(changes)
+
+        XCTAssertEqual(updatedSnapshot.items.map(\.path), ["", "a", "b", "b/e", "b/f", "b-c", "y", "z"])
+        XCTAssertEqual(updatedSnapshot.items.map(\.path), try snapshot.rescan().items.map(\.path))
+    }
+
+    func testWrittenSnapshotReadsBack() throws {
+        try Data("a".utf8).write(to: directory.appendingPathComponent("a"))
+        let snapshot = try DirectorySnapshot(url: directory, includesHashes: true)
+        let fileURL = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: fileURL) }
+        try snapshot.write(to: fileURL)
+        let readSnapshot = try DirectorySnapshot(contentsOf: fileURL)
+        XCTAssertEqual(readSnapshot.items, snapshot.items)
+        XCTAssertTrue(readSnapshot.diff(from: snapshot).isEmpty)
+    }
+
+    func testCorruptedItemCountThrows() {
+        var data = Data("FZDS".utf8)
+        DirectorySnapshot.append(DirectorySnapshot.version, to: &data)
+        DirectorySnapshot.append(UInt64.max / 2, to: &data)
+        DirectorySnapshot.append(UInt32(0), to: &data)
+        DirectorySnapshot.append(UInt32(0), to: &data)
+        DirectorySnapshot.append(UInt64(0), to: &data)
+        XCTAssertThrowsError(try data.withUnsafeBytes { try DirectorySnapshot.decode($0) })
+    }
+}
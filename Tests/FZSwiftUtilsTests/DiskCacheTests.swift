@@ -0,0 +1,77 @@
+//
+//  DiskCacheTests.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+@testable import FZSwiftUtils
+import XCTest
+
+final class DiskCacheTests: XCTestCase {
+    var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent("DiskCacheTests-\(UUID().uuidString)", isDirectory: true)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    func testRestoresValuesFromJournal() throws {
+        do {
+            let cache = try DiskCache(directory: directory, sizeLimit: .megabytes(1))
+            try cache.setData(Data("a".utf8), forKey: "a")
+            try cache.setData(Data("bb".utf8), forKey: "b")
+            cache.removeData(forKey: "a")
+        }
+        let cache = try DiskCache(directory: directory, sizeLimit: .megabytes(1))
+        XCTAssertEqual(cache.keys, ["b"])
+        XCTAssertEqual(cache.totalSize.bytes, 2)
+        XCTAssertEqual(cache.data(forKey: "b"), Data("bb".utf8))
+    }
+
+    func testTruncatedJournalRecordIsRemoved() throws {
+        do {
+            let cache = try DiskCache(directory: directory, sizeLimit: .megabytes(1))
+            try cache.setData(Data("a".utf8), forKey: "a")
+        }
+        // A set record that was interrupted after its key length.
+        let journalURL = directory.appendingPathComponent("journal")
+        let handle = try FileHandle(forWritingTo: journalURL)
+        handle.seekToEndOfFile()
+        handle.write(Data([DiskCache.Operation.set.rawValue, 0x10, 0x00]))
+        handle.closeFile()
+
+        do {
+            let cache = try DiskCache(directory: directory, sizeLimit: .megabytes(1))
+            XCTAssertEqual(cache.keys, ["a"])
+            try cache.setData(Data("bb".utf8), forKey: "b")
+        }
+        let cache = try DiskCache(directory: directory, sizeLimit: .megabytes(1))
+        XCTAssertEqual(Set(cache.keys), ["a", "b"])
+        XCTAssertEqual(cache.data(forKey: "b"), Data("bb".utf8))
+    }
+
+    func testEvictsLeastRecentlyUsedData() throws {
+        let cache = try DiskCache(directory: directory, sizeLimit: .bytes(4))
+        try cache.setData(Data("aa".utf8), forKey: "a")
+        try cache.setData(Data("bb".utf8), forKey: "b")
+        _ = cache.data(forKey: "a")
+        try cache.setData(Data("cc".utf8), forKey: "c")
+        XCTAssertEqual(cache.keys, ["c", "a"])
+        XCTAssertNil(cache.data(forKey: "b"))
+    }
+
+    func testRemoveUnreferencedFilesKeepsJournal() throws {
+        let cache = try DiskCache(directory: directory, sizeLimit: .megabytes(1))
+        try cache.setData(Data("a".utf8), forKey: "a")
+        let unreferencedURL = directory.appendingPathComponent("unreferenced")
+        try Data("x".utf8).write(to: unreferencedURL)
+        cache.removeUnreferencedFiles()
+        XCTAssertFalse(FileManager.default.fileExists(atPath: unreferencedURL.path))
+        XCTAssertTrue(FileManager.default.fileExists(atPath: directory.appendingPathComponent("journal").path))
+        XCTAssertEqual(cache.data(forKey: "a"), Data("a".utf8))
+    }
+}
@@ -0,0 +1,70 @@
+//
+//  ExtendedAttributesTests.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+@testable import FZSwiftUtils
+import XCTest
+#if canImport(Glibc)
+import Glibc
+#endif
+
+final class ExtendedAttributesTests: XCTestCase {
+    var fileURL: URL!
+
+    override func setUpWithError() throws {
+        fileURL = FileManager.default.temporaryDirectory.appendingPathComponent("ExtendedAttributesTests-\(UUID().uuidString)")
+        try Data("file".utf8).write(to: fileURL)
+        do {
+            try fileURL.extendedAttributes.writeAll(["test": Data()])
+        } catch let error as NSError where error.code == Int(ENOTSUP) {
+            throw XCTSkip("The file system doesn't support extended attributes.")
+        }
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: fileURL)
+    }
+
+    func testCodableRoundTrip() throws {
+        let attributes = fileURL.extendedAttributes
+        try attributes.setExtendedAttribute(["a", "b"], for: "json")
+        XCTAssertEqual(attributes.extendedAttribute(for: "json"), ["a", "b"])
+
+        attributes.codableEncoding = .binaryPropertyList
+        try attributes.setExtendedAttribute(["a", "b"], for: "plist")
+        try attributes.setExtendedAttribute("value", for: "string")
+        try attributes.setExtendedAttribute(42, for: "number")
+        XCTAssertEqual(attributes.extendedAttribute(for: "plist"), ["a", "b"])
+        XCTAssertEqual(attributes.extendedAttribute(for: "string"), "value")
+        XCTAssertEqual(attributes.extendedAttribute(for: "number"), 42)
+
+        try attributes.removeExtendedAttribute("json")
+        XCTAssertFalse(attributes.hasExtendedAttribute("json"))
+        XCTAssertEqual(try attributes.listExtendedAttributes().sorted(), ["number", "plist", "string", "test"])
+    }
+
+    func testBinaryPropertyListsAreStoredBare() throws {
+        let attributes = fileURL.extendedAttributes
+        attributes.codableEncoding = .binaryPropertyList
+        try attributes.setExtendedAttribute(["https://example.com"], for: "whereFroms")
+        let data = try XCTUnwrap(attributes.readAll()["whereFroms"])
+        XCTAssertEqual(try PropertyListSerialization.propertyList(from: data, format: nil) as? [String], ["https://example.com"])
+
+        // Attributes written by macOS contain the bare property list.
+        let macOSData = try PropertyListSerialization.data(fromPropertyList: "value", format: .binary, options: 0)
+        try attributes.writeAll(["macOS": macOSData])
+        XCTAssertEqual(attributes.extendedAttribute(for: "macOS"), "value")
+    }
+
+    func testReadAllAndLargeValues() throws {
+        let largeData = Data((0 ..< 3000).map { UInt8($0 % 251) })
+        try fileURL.extendedAttributes.writeAll(["small": Data("small".utf8), "large": largeData])
+        let values = try fileURL.extendedAttributes.readAll()
+        XCTAssertEqual(values["small"], Data("small".utf8))
+        XCTAssertEqual(values["large"], largeData)
+        XCTAssertEqual(values.keys.sorted(), ["large", "small", "test"])
+    }
+}
@@ -0,0 +1,180 @@
+//
+//  FastHashTests.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+@testable import FZSwiftUtils
+import XCTest
+
+final class FastHashTests: XCTestCase {
+    static let prime32: UInt64 = 2_654_435_761
+
+    /// The input of the xxHash sanity checks, generated from the xxHash primes.
+    static let sanityBuffer: [UInt8] = {
+        var generator = prime32
+        return (0 ..< 2367).map { _ in
+            defer { generator = generator &* 11_400_714_785_074_694_797 }
+            return UInt8(generator >> 56)
+        }
+    }()
+
+    /// Hashes the input in chunks of different sizes and returns the digest.
+    func streamedDigest<Function: FastHashFunction>(_ type: Function.Type, length: Int, seed: UInt64) -> Function.Digest {
+        var function = Function(seed: seed)
+        var offset = 0
+        var chunkSize = 1
+        while offset < length {
+            let end = Swift.min(offset + chunkSize, length)
+            Self.sanityBuffer.withUnsafeBytes { function.update(bufferPointer: UnsafeRawBufferPointer(rebasing: $0[offset ..< end])) }
+            offset = end
+            chunkSize = chunkSize * 3 + 1
+        }
+        return function.finalize()
+    }
+
+    func digest<Function: FastHashFunction>(_ type: Function.Type, length: Int, seed: UInt64) -> Function.Digest {
+        Self.sanityBuffer.withUnsafeBytes { Function.hash(bufferPointer: UnsafeRawBufferPointer(rebasing: $0[0 ..< length]), seed: seed) }
+    }
+
+    func testXXH64() {
+        let prime32 = Self.prime32
+        let vectors: [(length: Int, seed: UInt64, digest: UInt64)] = [
+            (0, 0, 0xEF46_DB37_51D8_E999),
+            (0, prime32, 0xAC75_FDA2_929B_17EF),
+            (1, 0, 0xE934_A84A_DB05_2768),
+            (1, prime32, 0x5014_6076_43A9_B4C3),
+            (3, 0, 0xFF7E_1959_CB50_794A),
+            (3, prime32, 0xAA85_84E8_3660_F7D1),
+            (4, 0, 0x9136_A0DC_A574_57EE),
+            (4, prime32, 0xCAAB_286B_D8E9_FDB5),
+            (8, 0, 0xCDBC_F538_E71D_1348),
+            (8, prime32, 0xFE0C_047A_5353_CDAC),
+            (9, 0, 0x554B_1AE9_91ED_A6B6),
+            (9, prime32, 0x7908_2652_48F6_D73F),
+            (16, 0, 0x98C9_0B57_FDFC_B55C),
+            (16, prime32, 0xC900_AD2D_536B_607E),
+            (17, 0, 0x0D39_A2D0_51A3_0C2C),
+            (17, prime32, 0x495C_D68A_647C_7A22),
+            (128, 0, 0x90CA_0214_57D9_6DC5),
+            (128, prime32, 0xED93_40A2_02BC_D1CF),
+            (129, 0, 0x41C2_8013_2D69_7ABA),
+            (129, prime32, 0x1668_B874_8993_5FF5),
+            (240, 0, 0xB818_38D4_83BA_EE53),
+            (240, prime32, 0xA4B3_F965_B6FE_67F8),
+            (241, 0, 0x95D7_6C8B_4D8F_C4D6),
+            (241, prime32, 0x19D5_AD5F_4BD6_CB9F),
+            (1024, 0, 0x4775_BF7C_ACE4_D177),
+            (1024, prime32, 0x238C_F929_6898_B465),
+            (2367, 0, 0xA824_18DD_EC0E_A581),
+            (2367, prime32, 0xA36A_93C1_8052_673A)
+        ]
+        for vector in vectors {
+            XCTAssertEqual(digest(XXH64.self, length: vector.length, seed: vector.seed), vector.digest, "\(vector)")
+            XCTAssertEqual(streamedDigest(XXH64.self, length: vector.length, seed: vector.seed), vector.digest, "\(vector)")
+        }
+    }
+
+    func testXXH3() {
+        let prime32 = Self.prime32
+        let vectors: [(length: Int, seed: UInt64, digest: UInt64)] = [
+            (0, 0, 0x2D06_8005_38D3_94C2),
+            (0, prime32, 0xF702_CA38_14DE_2125),
+            (1, 0, 0xC44B_DFF4_074E_ECDB),
+            (1, prime32, 0xB53D_5557_E7F7_6F8D),
+            (3, 0, 0x5424_7382_A8D6_B94D),
+            (3, prime32, 0xF173_D14D_AD53_A5DC),
+            (4, 0, 0xE5DC_74BC_5184_8A51),
+            (4, prime32, 0x6977_C7C3_AD94_21B9),
+            (8, 0, 0x24CC_C9AC_AA9F_65E4),
+            (8, prime32, 0x3600_73B0_548D_BD24),
+            (9, 0, 0x14D5_001C_15DD_3F2B),
+            (9, prime32, 0xCE39_4E48_812A_A7E3),
+            (16, 0, 0x981B_17D3_6C74_98C9),
+            (16, prime32, 0xB40F_1F6C_DB15_69CC),
+            (17, 0, 0x796F_5ACD_3A60_F862),
+            (17, prime32, 0xAF8C_B0BC_2C23_0DAF),
+            (128, 0, 0xFCFF_2412_6754_D861),
+            (128, prime32, 0xA3CA_6044_7DE9_81D1),
+            (129, 0, 0x98F1_B0A6_79A2_CA29),
+            (129, prime32, 0xC861_FFC4_9C2B_F14F),
+            (240, 0, 0x81C3_C2B6_7F56_8CCF),
+            (240, prime32, 0x5078_20EA_74B8_95B0),
+            (241, 0, 0xC5A6_39EC_D203_0E5E),
+            (241, prime32, 0x5927_E363_7BAC_8149),
+            (1024, 0, 0xDD85_C9B5_C110_9C5C),
+            (1024, prime32, 0xB8B9_5C07_CD4A_75FA),
+            (2367, 0, 0xCB37_AEB9_E5D3_61ED),
+            (2367, prime32, 0x6F53_60AE_69C2_F406)
+        ]
+        for vector in vectors {
+            XCTAssertEqual(digest(XXH3.self, length: vector.length, seed: vector.seed), vector.digest, "\(vector)")
+            XCTAssertEqual(streamedDigest(XXH3.self, length: vector.length, seed: vector.seed), vector.digest, "\(vector)")
+        }
+    }
+
+    func testXXH128() {
+        let prime32 = Self.prime32
+        let vectors: [(length: Int, seed: UInt64, low64: UInt64, high64: UInt64)] = [
+            (0, 0, 0x6001_C324_468D_497F, 0x99AA_06D3_0147_98D8),
+            (0, prime32, 0x5444_F786_9C67_1AB0, 0x9222_0AE5_5E14_AB50),
+            (1, 0, 0xC44B_DFF4_074E_ECDB, 0xA6CD_5E93_9200_0F6A),
+            (1, prime32, 0xB53D_5557_E7F7_6F8D, 0x89B9_9554_BA22_467C),
+            (3, 0, 0x5424_7382_A8D6_B94D, 0x20EF_C49F_F024_22EA),
+            (3, prime32, 0xF173_D14D_AD53_A5DC, 0x48F8_2C2F_E0AB_D468),
+            (4, 0, 0x2E7D_8D68_76A3_9FE9, 0x970D_585A_C632_BF8E),
+            (4, prime32, 0xEF78_D5C4_89CF_E10B, 0x7170_492A_2AA0_8992),
+            (8, 0, 0x64C6_9CAB_4BB2_1DC5, 0x47A7_F080_D82B_B456),
+            (8, prime32, 0x5F46_2F3D_E2E8_B940, 0xF959_0132_3265_5FF1),
+            (9, 0, 0xED7C_CBC5_01EB_7501, 0x564E_F607_8950_D457),
+            (9, prime32, 0x07DE_00B4_5EEE_033A, 0x75FB_6D1B_D353_B45C),
+            (16, 0, 0x5629_8025_8A99_8629, 0xC68C_368E_CF8A_9C05),
+            (16, prime32, 0xB07E_EEAB_4C56_392B, 0x3767_C90D_0CDB_B93D),
+            (17, 0, 0xABBC_12D1_1973_D7DB, 0x955F_A786_43ED_3669),
+            (17, prime32, 0x3CC9_FF6C_AE79_ACCB, 0x99E7_C628_E75D_6431),
+            (128, 0, 0xEBB1_5E34_A7FB_5AB1, 0x3999_2220_E045_260A),
+            (128, prime32, 0x1453_8199_41D9_3C1D, 0x9880_1187_DF8D_614D),
+            (129, 0, 0x86C9_E3BC_8F0A_3B5C, 0x0381_5FC9_1F1B_30B6),
+            (129, prime32, 0xB37B_716F_66B4_0F02, 0xB7F7_349A_47B3_9E56),
+            (240, 0, 0x5C9A_AE94_C8EB_E5A0, 0xAA42_02DA_A276_9DC8),
+            (240, prime32, 0xCA19_087F_1D33_5DAE, 0xDA88_8104_BEAE_5AE0),
+            (241, 0, 0xC5A6_39EC_D203_0E5E, 0x99A8_0ECF_0ECF_C647),
+            (241, prime32, 0x5927_E363_7BAC_8149, 0x4BF2_229C_3A8F_C3C3),
+            (1024, 0, 0xDD85_C9B5_C110_9C5C, 0x0D30_D240_71C6_4C57),
+            (1024, prime32, 0xB8B9_5C07_CD4A_75FA, 0x885B_0B4D_EBE3_D2FF),
+            (2367, 0, 0xCB37_AEB9_E5D3_61ED, 0xE89C_0F6F_F369_B427),
+            (2367, prime32, 0x6F53_60AE_69C2_F406, 0xD23A_AE4B_76C3_1ECB)
+        ]
+        for vector in vectors {
+            let expected = XXH128.Digest(low64: vector.low64, high64: vector.high64)
+            XCTAssertEqual(digest(XXH128.self, length: vector.length, seed: vector.seed), expected, "\(vector)")
+            XCTAssertEqual(streamedDigest(XXH128.self, length: vector.length, seed: vector.seed), expected, "\(vector)")
+        }
+        XCTAssertEqual(XXH128.hash(data: Data()).hexString, "99aa06d3014798d86001c324468d497f")
+    }
+
+    /// The test vectors of the wyhash reference implementation, which hash each message with its index as seed.
+    func testWyHash() {
+        let vectors: [(message: String, digest: UInt64)] = [
+            ("", 0x9322_8A4D_E0EE_C5A2),
+            ("a", 0xC5BA_C3DB_1787_13C4),
+            ("abc", 0xA97F_2F7B_1D9B_3314),
+            ("message digest", 0x786D_1F1D_F380_1DF4),
+            ("abcdefghijklmnopqrstuvwxyz", 0xDCA5_A813_8AD3_7C87),
+            ("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789", 0xB9E7_34F1_17CF_AF70),
+            ("12345678901234567890123456789012345678901234567890123456789012345678901234567890", 0x6CC5_EAB4_9A92_D617)
+        ]
+        for (seed, vector) in vectors.enumerated() {
+            XCTAssertEqual(WyHash.hash(utf8: vector.message, seed: UInt64(seed)), vector.digest, vector.message)
+            var function = WyHash(seed: UInt64(seed))
+            for character in vector.message {
+                function.update(utf8: String(character))
+            }
+            XCTAssertEqual(function.finalize(), vector.digest, vector.message)
+        }
+        for length in [0, 1, 3, 4, 8, 9, 16, 17, 47, 48, 49, 128, 129, 240, 241, 1024, 2367] {
+            XCTAssertEqual(streamedDigest(WyHash.self, length: length, seed: Self.prime32), digest(WyHash.self, length: length, seed: Self.prime32), "\(length)")
+        }
+    }
+}
@@ -0,0 +1,72 @@
+//
+//  FileCopierTests.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+@testable import FZSwiftUtils
+import XCTest
+#if canImport(Glibc)
+import Glibc
+#endif
+
+final class FileCopierTests: XCTestCase {
+    var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent("FileCopierTests-\(UUID().uuidString)", isDirectory: true)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    func testCopiesTreeWithPermissions() throws {
+        let source = directory.appendingPathComponent("source", isDirectory: true)
+        try FileManager.default.createDirectory(at: source.appendingPathComponent("folder"), withIntermediateDirectories: true)
+        let fileURL = source.appendingPathComponent("folder/file")
+        try Data(repeating: 7, count: 100_000).write(to: fileURL)
+        XCTAssertEqual(chmod(fileURL.path, 0o640), 0)
+        XCTAssertEqual(mkfifo(source.appendingPathComponent("fifo").path, 0o600), 0)
+
+        let destination = directory.appendingPathComponent("destination", isDirectory: true)
+        let copier = FileCopier(source: source, destination: destination)
+        copier.clonesItems = false
+        copier.chunkSize = .kilobytes(16)
+        try copier.copy()
+
+        let copiedURL = destination.appendingPathComponent("folder/file")
+        XCTAssertEqual(try Data(contentsOf: copiedURL), try Data(contentsOf: fileURL))
+        var info = stat()
+        XCTAssertEqual(lstat(copiedURL.path, &info), 0)
+        XCTAssertEqual(info.st_mode & 0o777, 0o640)
+        XCTAssertEqual(lstat(destination.appendingPathComponent("fifo").path, &info), 0)
+        XCTAssertEqual(info.st_mode & S_IFMT, S_IFIFO)
+        XCTAssertEqual(copier.progress.completedUnitCount, 100_000)
+    }
+
+    func testExistingDestinationIsKept() throws {
+        let source = directory.appendingPathComponent("source")
+        try Data("source".utf8).write(to: source)
+        let destination = directory.appendingPathComponent("destination")
+        try Data("destination".utf8).write(to: destination)
+
+        let copier = FileCopier(source: source, destination: destination)
+        copier.clonesItems = false
+        XCTAssertThrowsError(try copier.copy())
+        XCTAssertEqual(try Data(contentsOf: destination), Data("destination".utf8))
+    }
+
+    func testCancelledCopyDoesNothing() throws {
+        let source = directory.appendingPathComponent("source")
+        try Data("source".utf8).write(to: source)
+        let destination = directory.appendingPathComponent("destination")
+
+        let copier = FileCopier(source: source, destination: destination)
+        copier.cancel()
+        XCTAssertThrowsError(try copier.copy()) { XCTAssertTrue($0 is CancellationError) }
+        XCTAssertFalse(FileManager.default.fileExists(atPath: destination.path))
+    }
+}
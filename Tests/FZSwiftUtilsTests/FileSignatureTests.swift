@@ -0,0 +1,88 @@
+//
+//  FileSignatureTests.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+@testable import FZSwiftUtils
+import XCTest
+#if canImport(Glibc)
+import Glibc
+#endif
+
+final class FileSignatureTests: XCTestCase {
+    func fileType(_ bytes: [UInt8]) -> URL.FileType? {
+        URL.FileType(data: Data(bytes))
+    }
+
+    func fileType(_ string: String) -> URL.FileType? {
+        URL.FileType(data: Data(string.utf8))
+    }
+
+    func testDetectsSignatures() {
+        XCTAssertEqual(fileType([0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00]), .image)
+        XCTAssertEqual(fileType([0xFF, 0xD8, 0xFF, 0xE0]), .image)
+        XCTAssertEqual(fileType("GIF89a"), .gif)
+        XCTAssertEqual(fileType([0x00, 0x00, 0x00, 0x18] + Array("ftypheic".utf8)), .image)
+        XCTAssertEqual(fileType([0x00, 0x00, 0x00, 0x18] + Array("ftypisom".utf8)), .video)
+        XCTAssertEqual(fileType([0x00, 0x00, 0x00, 0x18] + Array("ftypM4A ".utf8)), .audio)
+        XCTAssertEqual(fileType("RIFF\u{0}\u{0}\u{0}\u{0}WAVE"), .audio)
+        XCTAssertEqual(fileType([0x50, 0x4B, 0x03, 0x04]), .archive)
+        XCTAssertEqual(fileType("%PDF-1.7"), .pdf)
+        XCTAssertEqual(fileType([0x7F, 0x45, 0x4C, 0x46]), .executable)
+    }
+
+    func testDetectsHeadersWithAdditionalFields() {
+        var bitmap = [UInt8](repeating: 0, count: 54)
+        bitmap[0] = UInt8(ascii: "B")
+        bitmap[1] = UInt8(ascii: "M")
+        bitmap[14] = 40
+        XCTAssertEqual(fileType(bitmap), .image)
+
+        var portableExecutable = [UInt8](repeating: 0, count: 0x84)
+        portableExecutable[0] = UInt8(ascii: "M")
+        portableExecutable[1] = UInt8(ascii: "Z")
+        portableExecutable[0x3C] = 0x80
+        portableExecutable.replaceSubrange(0x80..<0x84, with: [0x50, 0x45, 0x00, 0x00])
+        XCTAssertEqual(fileType(portableExecutable), .executable)
+
+        XCTAssertEqual(fileType([0x49, 0x44, 0x33, 0x04, 0x00]), .audio)
+        XCTAssertEqual(fileType([0x46, 0x4C, 0x56, 0x01, 0x05]), .video)
+        XCTAssertEqual(fileType(Array("BZh9".utf8) + [0x31, 0x41, 0x59, 0x26, 0x53, 0x59]), .archive)
+        XCTAssertEqual(fileType([0x00, 0x00, 0x00, 0x08] + Array("wide".utf8)), .video)
+        XCTAssertEqual(fileType(Array("caff".utf8) + [0x00, 0x01, 0x00, 0x00]), .audio)
+        XCTAssertEqual(fileType(Array("MThd".utf8) + [0x00, 0x00, 0x00, 0x06, 0x00, 0x01]), .audio)
+    }
+
+    func testTextStartingWithShortSignaturesIsText() {
+        XCTAssertEqual(fileType("BMW models and prices\n"), .text)
+        XCTAssertEqual(fileType("MZ is the abbreviation of Mark Zbikowski.\n"), .text)
+        XCTAssertEqual(fileType("ID3 tags store the metadata of MP3 files.\n"), .text)
+        XCTAssertEqual(fileType("FLV files are Flash videos.\n"), .text)
+        XCTAssertEqual(fileType("BZh is the bzip2 header.\n"), .text)
+        XCTAssertEqual(fileType("The wide road leads to the city.\n"), .text)
+        XCTAssertEqual(fileType("The ftyp box comes first.\n"), .text)
+        XCTAssertEqual(fileType("Set moov and mdat boxes.\n"), .text)
+        XCTAssertEqual(fileType("caffeine is a stimulant.\n"), .text)
+        XCTAssertEqual(fileType("MThd is the MIDI header chunk.\n"), .text)
+        XCTAssertEqual(fileType("Grüße\n"), .text)
+        XCTAssertNil(fileType([0x00, 0x01, 0x02, 0x03]))
+    }
+
+    func testDetectsFilesAndSkipsFIFOs() throws {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent("FileSignatureTests-\(UUID().uuidString)", isDirectory: true)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let pdfURL = directory.appendingPathComponent("document.txt")
+        try Data("%PDF-1.7".utf8).write(to: pdfURL)
+        let textURL = directory.appendingPathComponent("notes")
+        try Data("Notes\n".utf8).write(to: textURL)
+        let fifoURL = directory.appendingPathComponent("fifo")
+        XCTAssertEqual(mkfifo(fifoURL.path, 0o600), 0)
+
+        XCTAssertEqual(URL.FileType(contentsOf: pdfURL), .pdf)
+        XCTAssertNil(URL.FileType(contentsOf: fifoURL))
+        XCTAssertEqual(URL.FileType.detect([pdfURL, fifoURL, textURL], maxOpenFiles: 2), [.pdf, nil, .text])
+    }
+}
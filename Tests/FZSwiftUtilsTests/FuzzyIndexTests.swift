@@ -0,0 +1,44 @@
+//
+//  FuzzyIndexTests.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+@testable import FZSwiftUtils
+import XCTest
+
+final class FuzzyIndexTests: XCTestCase {
+    let titles = ["Harry Potter and the Chamber of Secrets", "The Lord of the Rings", "Pride and Prejudice", "Chambers of Commerce"]
+
+    func testSearch() {
+        let index = FuzzyIndex(titles)
+        let results = index.search("chambr of secrts")
+        XCTAssertEqual(results.first?.key, 0)
+        XCTAssertEqual(results.first?.match.string, "Chamber of Secrets")
+        XCTAssertTrue(index.search("xyz").isEmpty)
+    }
+
+    func testMatchesInsideWords() {
+        let index = FuzzyIndex(titles)
+        XCTAssertEqual(Set(index.search("amber", maximumEditDistance: 0).map(\.key)), [0, 3])
+        XCTAssertEqual(index.search("ord of th", maximumEditDistance: 0).map(\.key), [1])
+    }
+
+    func testShortQueriesMatchWordStarts() {
+        let index = FuzzyIndex(titles)
+        XCTAssertEqual(Set(index.search("pr").map(\.key)), [2])
+        XCTAssertEqual(Set(index.search("ch").map(\.key)), [0, 3])
+    }
+
+    func testLargeIndexMatchesInsertedIndex() {
+        let strings = (0 ..< 3000).map { "Document \($0) about \(["apples", "bananas", "cherries"][$0 % 3])" }
+        let index = FuzzyIndex(strings)
+        var insertedIndex = FuzzyIndex<Int>()
+        for (key, string) in strings.enumerated() {
+            insertedIndex.insert(string, forKey: key)
+        }
+        XCTAssertEqual(index.postings, insertedIndex.postings)
+        XCTAssertEqual(index.search("document 2997 about apples").first?.key, 2997)
+    }
+}
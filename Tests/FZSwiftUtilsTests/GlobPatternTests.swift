@@ -0,0 +1,66 @@
+//
+//  GlobPatternTests.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+@testable import FZSwiftUtils
+import XCTest
+
+final class GlobPatternTests: XCTestCase {
+    func testWildcards() {
+        XCTAssertTrue(GlobPattern("*.jpg").matches("/Users/Florian/image.jpg"))
+        XCTAssertFalse(GlobPattern("*.jpg").matches("/Users/Florian/image.jpeg"))
+        XCTAssertTrue(GlobPattern("image?.png").matches("image1.png"))
+        XCTAssertFalse(GlobPattern("image?.png").matches("image10.png"))
+        XCTAssertTrue(GlobPattern("cache/*.db").matches("/Users/Florian/cache/index.db"))
+        XCTAssertFalse(GlobPattern("cache/*.db").matches("/Users/Florian/cache/old/index.db"))
+        XCTAssertFalse(GlobPattern("/cache/*.db").matches("/Users/cache/index.db"))
+    }
+
+    func testGlobstar() {
+        let pattern = GlobPattern("**/cache/**")
+        XCTAssertTrue(pattern.matches("/Users/Florian/Library/cache/images/1.png"))
+        XCTAssertFalse(pattern.matches("/Users/Florian/Library/caches/images/1.png"))
+        XCTAssertTrue(GlobPattern("/src/**/*.swift").matches("/src/main.swift"))
+        XCTAssertTrue(GlobPattern("/src/**/*.swift").matches("/src/a/b/main.swift"))
+    }
+
+    func testCharacterClassesAndEscapes() {
+        XCTAssertTrue(GlobPattern("file[0-9].txt").matches("file5.txt"))
+        XCTAssertFalse(GlobPattern("file[!0-9].txt").matches("file5.txt"))
+        XCTAssertTrue(GlobPattern("file[^0-9].txt").matches("fileA.txt"))
+        XCTAssertTrue(GlobPattern("\\*.txt").matches("*.txt"))
+        XCTAssertFalse(GlobPattern("\\*.txt").matches("a.txt"))
+    }
+
+    func testCaseInsensitiveAndNegated() {
+        XCTAssertTrue(GlobPattern("*.JPG", caseSensitive: false).matches("photo.jpg"))
+        XCTAssertFalse(GlobPattern("*.JPG").matches("photo.jpg"))
+        XCTAssertTrue(GlobPattern("!*.tmp").matches("file.txt"))
+        XCTAssertFalse(GlobPattern("!*.tmp").matches("file.tmp"))
+
+        let patterns: [GlobPattern] = ["*.swift", "!*Tests.swift"]
+        XCTAssertTrue(patterns.matches("/src/Cache.swift"))
+        XCTAssertFalse(patterns.matches("/src/CacheTests.swift"))
+        XCTAssertFalse(patterns.matches("/src/Cache.h"))
+    }
+
+    func testMatchesDecomposedPaths() {
+        let pattern = GlobPattern("Café/*.txt")
+        XCTAssertTrue(pattern.matches("/Users/Florian/Cafe\u{301}/menu.txt"))
+        XCTAssertTrue(pattern.matches("/Users/Florian/Caf\u{E9}/menu.txt"))
+        XCTAssertTrue(pattern.matches(URL(fileURLWithPath: "/Users/Florian/Café/menu.txt")))
+        XCTAssertTrue(PathExtensionSet(["jpg", "tést"]).contains(URL(fileURLWithPath: "/tmp/file.te\u{301}st")))
+    }
+
+    func testPathExtensionSet() {
+        let extensions = PathExtensionSet(["jpg", ".PNG", "extension"])
+        XCTAssertTrue(extensions.contains(URL(fileURLWithPath: "/tmp/image.JPG")))
+        XCTAssertTrue(extensions.contains(URL(fileURLWithPath: "/tmp/image.png")))
+        XCTAssertTrue(extensions.contains(URL(fileURLWithPath: "/tmp/file.extension")))
+        XCTAssertFalse(extensions.contains(URL(fileURLWithPath: "/tmp/.jpg")))
+        XCTAssertFalse(extensions.contains(URL(fileURLWithPath: "/tmp/jpg")))
+    }
+}
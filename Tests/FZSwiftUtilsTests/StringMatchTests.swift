@@ -0,0 +1,25 @@
+//
+//  StringMatchTests.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+@testable import FZSwiftUtils
+import XCTest
+
+final class StringMatchTests: XCTestCase {
+    func testMatchesBetweenStrings() {
+        XCTAssertEqual("a<b>c<d>".matches(between: "<", and: ">").map(\.string), ["b", "d"])
+        XCTAssertEqual("a<b>c<d>".matches(between: "<", and: ">", includingFromTo: true).map(\.string), ["<b>", "<d>"])
+        XCTAssertEqual("a(.b)\n(c\nd)".matches(between: "(", and: ")").map(\.string), [".b"])
+        XCTAssertEqual("key: value\nkey: other\n".matches(between: "key: ", and: "\n").map(\.string), ["value", "other"])
+        XCTAssertEqual("a: 1\r\nb: 2".matches(between: ": ", and: "\r\n", includingFromTo: true).map(\.string), [": 1\r\n"])
+    }
+
+    func testMatchesBetweenEmptyStrings() {
+        XCTAssertEqual("ab>cd>\nx>".matches(between: "", and: ">").map(\.string), ["ab", "cd", "x"])
+        XCTAssertEqual("a<b<".matches(between: "<", and: "").map(\.string), ["", ""])
+        XCTAssertEqual("a<b<".matches(between: "<", and: "", includingFromTo: true).map(\.string), ["<", "<"])
+    }
+}
@@ -0,0 +1,33 @@
+//
+//  StringReplacerTests.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+@testable import FZSwiftUtils
+import XCTest
+
+final class StringReplacerTests: XCTestCase {
+    func testReplacesLeftmostLongestMatches() {
+        let replacer = StringReplacer(["cat": "dog", "category": "group", "dog": "cat"])
+        XCTAssertEqual(replacer.replacingOccurrences(in: "A cat in a category with a dog"), "A dog in a group with a cat")
+        XCTAssertEqual(StringReplacer(["ab": "1", "bcd": "2", "b": "3"]).replacingOccurrences(in: "abcd bcd"), "1cd 2")
+        XCTAssertEqual(StringReplacer(["é": "e"]).replacingOccurrences(in: "café crème"), "cafe crème")
+        XCTAssertEqual(replacer.replacingOccurrences(in: "No match"), "No match")
+    }
+
+    func testOverlappingPrefixes() {
+        let replacer = StringReplacer(["a": "x", String(repeating: "a", count: 100) + "b": "y"])
+        XCTAssertEqual(replacer.replacingOccurrences(in: String(repeating: "a", count: 1000)), String(repeating: "x", count: 1000))
+        XCTAssertEqual(replacer.replacingOccurrences(in: "a" + String(repeating: "a", count: 100) + "b"), "xy")
+    }
+
+    func testRangesAndContainsMatch() {
+        let replacer = StringReplacer(replacing: ["cat", "dog"], with: "pet")
+        let string = "A cat and a dog"
+        XCTAssertEqual(replacer.ranges(in: string).map { String(string[$0]) }, ["cat", "dog"])
+        XCTAssertTrue(replacer.containsMatch(in: string))
+        XCTAssertFalse(replacer.containsMatch(in: "A bird"))
+    }
+}
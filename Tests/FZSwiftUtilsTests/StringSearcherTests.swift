@@ -0,0 +1,50 @@
+//
+//  StringSearcherTests.swift
+//
+//
+//  Created by Florian Zand on 17.10.26.
+//
+
+@testable import FZSwiftUtils
+import XCTest
+
+final class StringSearcherTests: XCTestCase {
+    /// The offsets of the occurrences, found by comparing every position.
+    func offsets(of searchString: String, in string: String, overlapping: Bool) -> [Int] {
+        let bytes = Array(string.utf8)
+        let pattern = Array(searchString.utf8)
+        var offsets: [Int] = []
+        var position = 0
+        while !pattern.isEmpty, position + pattern.count <= bytes.count {
+            if Array(bytes[position ..< position + pattern.count]) == pattern {
+                offsets.append(position)
+                position += overlapping ? 1 : pattern.count
+            } else {
+                position += 1
+            }
+        }
+        return offsets
+    }
+
+    func searchedOffsets(of searchString: String, in string: String, overlapping: Bool) -> [Int] {
+        StringSearcher(searchString).ranges(in: string, overlapping: overlapping).map { string.utf8.distance(from: string.startIndex, to: $0.lowerBound) }
+    }
+
+    func testFindsOccurrences() {
+        XCTAssertEqual(StringSearcher("aa").count(in: "aaaa"), 2)
+        XCTAssertEqual(StringSearcher("aa").count(in: "aaaa", overlapping: true), 3)
+        XCTAssertEqual(StringSearcher("WORLD", caseInsensitive: true).count(in: "Hello world, hello World!"), 2)
+        XCTAssertEqual(StringSearcher("é").matches(in: "café, é").nsRanges, [NSRange(location: 3, length: 1), NSRange(location: 6, length: 1)])
+        XCTAssertFalse(StringSearcher("").isContained(in: "abc"))
+    }
+
+    func testRepetitiveStringsMatchComparingEveryPosition() {
+        let string = String(repeating: "a", count: 1000) + "b" + String(repeating: "ab", count: 500) + "aab"
+        for searchString in ["aaab", "aab", "aba", String(repeating: "a", count: 40) + "b", "abab"] {
+            for overlapping in [false, true] {
+                XCTAssertEqual(searchedOffsets(of: searchString, in: string, overlapping: overlapping), offsets(of: searchString, in: string, overlapping: overlapping), searchString)
+            }
+        }
+        XCTAssertEqual(StringSearcher("AAAB", caseInsensitive: true).count(in: string), 1)
+    }
+}